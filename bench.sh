@@ -0,0 +1,12 @@
+#!/bin/bash
+
+DIRECTORY="build"
+FLAGS="-Isrc -Ibench -O2 -pthread"
+
+if [ ! -d "$DIRECTORY" ]; then
+  mkdir $DIRECTORY
+fi
+
+g++ -std=c++20 bench/$1.cpp -o build/$1.o $FLAGS
+
+./build/$1.o "${@:2}"
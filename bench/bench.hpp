@@ -0,0 +1,75 @@
+/**
+ * @file bench.hpp
+ * @brief Helpers of the CPU benchmarks.
+ *
+ * Timing and random query points shared by the programs in the bench folder.
+ *
+ * @author Edson Martinelli
+ * @date 2026
+ */
+
+#ifndef BENCH_HPP
+#define BENCH_HPP
+
+#include <chrono>
+#include <random>
+#include <vector>
+#include "shape.hpp"
+#include "vector.hpp"
+
+/**
+ * @brief Elapsed time of a function in milliseconds.
+ *
+ * @param [in] f Function to run.
+ * @return Wall time of one call.
+ */
+template <typename F>
+double timeMs(F&& f){
+    auto begin = std::chrono::steady_clock::now();
+    f();
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::milli>(end - begin).count();
+}
+
+/**
+ * @brief Uniform random points inside a box.
+ *
+ * @param [in] aabb Box of the points.
+ * @param [in] count Number of points.
+ * @param [in] seed Random seed.
+ * @param [out] points Generated points.
+ */
+void getRandomPoints(const AABB& aabb, int count, unsigned int seed, std::vector<vec3>& points){
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<float> x(aabb.minimum.x, aabb.maximum.x);
+    std::uniform_real_distribution<float> y(aabb.minimum.y, aabb.maximum.y);
+    std::uniform_real_distribution<float> z(aabb.minimum.z, aabb.maximum.z);
+    points.resize(count);
+    for (vec3& p : points) {
+        p = {x(rng), y(rng), z(rng)};
+    }
+}
+
+/**
+ * @brief Ray direction of a pixel.
+ *
+ * Same camera as getDirection() of the shaders (pixel centers, y up).
+ *
+ * @param [in] x Pixel column.
+ * @param [in] y Pixel row from the bottom.
+ * @param [in] width Image width.
+ * @param [in] height Image height.
+ * @param [in] origin Rays origin.
+ * @param [in] lookAt Rays target position.
+ * @return Normalized ray direction.
+ */
+vec3 getDirection(int x, int y, int width, int height, vec3 origin, vec3 lookAt){
+    vec3 viewDir = normalize(lookAt - origin);
+    vec3 hViewport = cross(viewDir, vec3{0.0f, 1.0f, 0.0f});
+    vec3 vViewport = cross(hViewport, viewDir);
+    float u = ((x + 0.5f) * 2.0f - width) / height;
+    float v = ((y + 0.5f) * 2.0f - height) / height;
+    return normalize(hViewport * u + vViewport * v + viewDir);
+}
+
+#endif
@@ -0,0 +1,148 @@
+/**
+ * @file brickmap.cpp
+ * @brief Benchmark of the baked brick map.
+ *
+ * Bake the pruned grid into bricks, check the lookup error against the pruned trees, and
+ * compare the time of marching an image with the trees and with the bricks.
+ *
+ * @author Edson Martinelli
+ * @date 2026
+ */
+
+#include <cstdio>
+#include <cmath>
+#include <vector>
+#include "shape.hpp"
+#include "bounds.hpp"
+#include "pruning.hpp"
+#include "brickmap.hpp"
+#include "bench.hpp"
+
+const int WIDTH = 400; /**< Image width. */
+const int HEIGHT = 300; /**< Image height. */
+const float D = 32.0f; /**< Maximun ray distance. */
+const int MAX_STEP = 256; /**< Maximun ray steps. */
+const int QUERIES = 200000; /**< Random samples for the lookup error. */
+
+/**
+ * @brief Ray march an image with the pruned trees.
+ *
+ * Same loop as rayMarching() of full3DTreePruningFarFields.frag.
+ *
+ * @param [in] scene Scene to render.
+ * @param [in] grid Pruning grid.
+ * @param [in] origin Camera origin (inside the grid).
+ * @param [out] depth Hit distance of each pixel.
+ * @param [out] steps SDF evaluations.
+ */
+void marchTrees(const Scene& scene, const PruningGrid& grid, vec3 origin, std::vector<float>& depth, long& steps){
+    steps = 0;
+    for (int y = 0; y < HEIGHT; y++)
+    for (int x = 0; x < WIDTH; x++) {
+        vec3 direction = getDirection(x, y, WIDTH, HEIGHT, origin, {0.0f, 0.0f, 0.0f});
+        float t = 0.0f;
+        int count = 0;
+        while (t < D) {
+            vec3 p = origin + direction * t;
+            if (!insideGrid(p, grid)) {
+                t = 1e20f;
+                break;
+            }
+            float r = sdfGrid(p, scene, grid);
+            steps++;
+            if (r < RAY_EPSILON) break;
+            if (count > MAX_STEP) break;
+            t += r;
+            count++;
+        }
+        depth[y * WIDTH + x] = t;
+    }
+}
+
+/**
+ * @brief Ray march an image with the brick map.
+ *
+ * @param [in] scene Scene to render.
+ * @param [in] grid Pruning grid the map was baked from.
+ * @param [in] map Baked distance field.
+ * @param [in] origin Camera origin (inside the grid).
+ * @param [out] depth Hit distance of each pixel.
+ * @param [out] steps Lookups and tree evaluations.
+ */
+void marchBricks(const Scene& scene, const PruningGrid& grid, const BrickMap& map, vec3 origin, std::vector<float>& depth, long& steps){
+    steps = 0;
+    for (int y = 0; y < HEIGHT; y++)
+    for (int x = 0; x < WIDTH; x++) {
+        vec3 direction = getDirection(x, y, WIDTH, HEIGHT, origin, {0.0f, 0.0f, 0.0f});
+        int count;
+        depth[y * WIDTH + x] = rayMarchBrickMap(origin, direction, scene, grid, map, D, MAX_STEP, count);
+        steps += count;
+    }
+}
+
+/**
+ * @brief Bake and march one scene.
+ *
+ * @param [in] name Scene name.
+ * @param [in] scene Scene to render.
+ * @param [in] limits Scene limits.
+ * @param [in] gridLevel Number of pruning levels.
+ * @param [in] origin Camera origin.
+ */
+void runScene(const char* name, const Scene& scene, const AABB& limits, int gridLevel, vec3 origin){
+    int size = scene.nodes.size();
+    std::vector<NodeBound> nodeBounds(size);
+    computeNodeBounds(scene, scene.nodes.data(), size, nodeBounds.data());
+    AABB aabb;
+    getSceneAABB(nodeBounds[size - 1], limits, 0.01f, aabb);
+
+    PruningGrid grid;
+    double build = timeMs([&]{ buildPruningGrid(scene, aabb, gridLevel, true, grid); });
+
+    BrickMap map;
+    double bake = timeMs([&]{ bakeBrickMap(scene, grid, map); });
+    int bricks = 0;
+    for (int brick : map.bricks) bricks += brick >= 0;
+
+    // Erro da consulta trilinear nas células com tijolo
+    std::vector<vec3> points;
+    getRandomPoints(aabb, QUERIES, 42, points);
+    float maxError = 0.0f;
+    for (const vec3& p : points) {
+        float error;
+        float value = sdfBrickMap(p, map, error);
+        if (error > 0.0f) maxError = std::max(maxError, std::fabs(value - sdfGrid(p, scene, grid)));
+    }
+
+    std::vector<float> treeDepth(WIDTH * HEIGHT), brickDepth(WIDTH * HEIGHT);
+    long treeSteps, brickSteps;
+    double treeTime = timeMs([&]{ marchTrees(scene, grid, origin, treeDepth, treeSteps); });
+    double brickTime = timeMs([&]{ marchBricks(scene, grid, map, origin, brickDepth, brickSteps); });
+
+    int hitMismatches = 0;
+    float maxDepth = 0.0f;
+    for (int i = 0; i < WIDTH * HEIGHT; i++) {
+        bool treeHit = treeDepth[i] < D;
+        bool brickHit = brickDepth[i] < D;
+        if (treeHit != brickHit) hitMismatches++;
+        else if (treeHit) maxDepth = std::max(maxDepth, std::fabs(treeDepth[i] - brickDepth[i]));
+    }
+
+    std::printf("%s: %d bricks of %zu cells, atlas %d^3, %.1f MB, bound %.5f, max error %.5f\n", name, bricks,
+                map.bricks.size(), map.atlasSize, map.samples.size() * sizeof(float) / 1048576.0, map.errorBound, maxError);
+    std::printf("  build %8.1f ms | bake %8.1f ms | march trees %8.1f ms (%ld steps), bricks %8.1f ms (%ld steps) | "
+                "%d hit mismatches, max depth diff %.5f\n",
+                build, bake, treeTime, treeSteps, brickTime, brickSteps, hitMismatches, maxDepth);
+}
+
+int main(){
+    Scene scene;
+    AABB limits;
+    getScenePost(scene);
+    getAABB(limits);
+    runScene("ufabc", scene, limits, 3, {1.0f, 0.0f, 1.999f});
+
+    getSceneRings(scene, 64, 1234, limits);
+    runScene("rings64", scene, limits, 3, {0.0f, 4.0f, 1.99f});
+    return 0;
+}
@@ -0,0 +1,84 @@
+/**
+ * @file bvh.cpp
+ * @brief Benchmark of the CPU evaluators on large procedural scenes.
+ *
+ * Compare the full tree, the pruning grid and the BVH over union-level subtrees in
+ * build time and time per query, for scenes of 64, 512 and 4096 rings (see getSceneRings).
+ * Mismatches count the queries near the surface where the grid or the BVH disagree with
+ * the full tree.
+ *
+ * @author Edson Martinelli
+ * @date 2026
+ */
+
+#include <cstdio>
+#include <cmath>
+#include <vector>
+#include "shape.hpp"
+#include "bounds.hpp"
+#include "evaluator.hpp"
+#include "pruning.hpp"
+#include "bvh.hpp"
+#include "bench.hpp"
+
+const int QUERIES = 200000; /**< Random queries per scene. */
+const int GRID_LEVEL = 2; /**< Pruning levels of the grid (16 cells per axis). */
+const float SURFACE_DISTANCE = 0.05f; /**< Queries closer than this to the surface must match. */
+
+/**
+ * @brief Run the three evaluators on one scene.
+ *
+ * @param [in] count Number of rings.
+ */
+void runScene(int count){
+    Scene scene;
+    AABB limits;
+    getSceneRings(scene, count, 1234, limits);
+    int size = scene.nodes.size();
+
+    std::vector<NodeBound> nodeBounds(size);
+    computeNodeBounds(scene, scene.nodes.data(), size, nodeBounds.data());
+    AABB aabb;
+    getSceneAABB(nodeBounds[size - 1], limits, 0.01f, aabb);
+
+    PruningGrid grid;
+    BVH bvh;
+    double gridBuild = timeMs([&]{ buildPruningGrid(scene, aabb, GRID_LEVEL, true, grid); });
+    double bvhBuild = timeMs([&]{ buildBVH(scene, scene.nodes.data(), size, bvh); });
+
+    std::vector<vec3> points;
+    getRandomPoints(aabb, QUERIES, 42, points);
+    std::vector<float> full(QUERIES), gridValues(QUERIES), bvhValues(QUERIES);
+
+    // A arvore completa e O(n) por consulta, entao usa menos pontos nas cenas grandes.
+    int fullQueries = std::min(QUERIES, 20000000 / size);
+    double fullTime = timeMs([&]{
+        for (int i = 0; i < fullQueries; i++) full[i] = sdf(points[i], scene, scene.nodes.data(), size);
+    });
+    double gridTime = timeMs([&]{
+        for (int i = 0; i < QUERIES; i++) gridValues[i] = sdfGrid(points[i], scene, grid);
+    });
+    double bvhTime = timeMs([&]{
+        for (int i = 0; i < QUERIES; i++) bvhValues[i] = sdfBVH(points[i], scene, bvh);
+    });
+
+    int gridMismatches = 0, bvhMismatches = 0;
+    for (int i = 0; i < fullQueries; i++) {
+        if (std::fabs(full[i]) > SURFACE_DISTANCE) continue;
+        if (std::fabs(gridValues[i] - full[i]) > 1e-4f) gridMismatches++;
+        if (std::fabs(bvhValues[i] - full[i]) > 1e-4f) bvhMismatches++;
+    }
+
+    std::printf("rings %5d | nodes %6d | full %9.1f ns | grid %8.1f ns (build %8.1f ms, %d nodes, %d err) | "
+                "bvh %8.1f ns (build %6.2f ms, %zu leaves, %d err)\n",
+                count, size, fullTime * 1e6 / fullQueries,
+                gridTime * 1e6 / QUERIES, gridBuild, (int)grid.nodes.size(), gridMismatches,
+                bvhTime * 1e6 / QUERIES, bvhBuild, bvh.leaves.size(), bvhMismatches);
+}
+
+int main(){
+    for (int count : {64, 512, 4096}) {
+        runScene(count);
+    }
+    return 0;
+}
@@ -0,0 +1,133 @@
+/**
+ * @file corners.cpp
+ * @brief Benchmark of the corner far-fields.
+ *
+ * Check that the interpolated corner bounds stay below the SDF, and compare the steps per
+ * pixel of marching an image with the center far-fields and with the corner far-fields. The
+ * build and march times are printed too: the corners save steps but cost more per step and
+ * per cell than the center value.
+ *
+ * @author Edson Martinelli
+ * @date 2026
+ */
+
+#include <cstdio>
+#include <cmath>
+#include <vector>
+#include "shape.hpp"
+#include "bounds.hpp"
+#include "pruning.hpp"
+#include "bench.hpp"
+
+const int WIDTH = 400; /**< Image width. */
+const int HEIGHT = 300; /**< Image height. */
+const float D = 32.0f; /**< Maximun ray distance. */
+const int MAX_STEP = 256; /**< Maximun ray steps. */
+const int QUERIES = 500000; /**< Random samples for the bound check. */
+
+/**
+ * @brief Ray marching statistics of one image.
+ */
+struct MarchStats{
+    long steps = 0; /**< SDF evaluations. */
+    long farSteps = 0; /**< SDF evaluations in far-field cells. */
+    int hits = 0; /**< Rays that hit a surface. */
+};
+
+/**
+ * @brief Ray march an image with a pruning grid.
+ *
+ * Same loop as rayMarching() of full3DTreePruningFarFields.frag.
+ *
+ * @param [in] scene Scene to render.
+ * @param [in] grid Pruning grid.
+ * @param [in] corners Use the corner far-fields.
+ * @param [in] origin Camera origin (inside the grid).
+ * @param [out] stats Marching statistics.
+ */
+void marchImage(const Scene& scene, const PruningGrid& grid, bool corners, vec3 origin, MarchStats& stats){
+    for (int y = 0; y < HEIGHT; y++)
+    for (int x = 0; x < WIDTH; x++) {
+        vec3 direction = getDirection(x, y, WIDTH, HEIGHT, origin, {0.0f, 0.0f, 0.0f});
+        float t = 0.0f;
+        int count = 0;
+        while (t < D) {
+            vec3 p = origin + direction * t;
+            if (!insideGrid(p, grid)) {
+                t = 1e20f;
+                break;
+            }
+            stats.farSteps += grid.cells[getGridCellIndex(p, grid)].size == 0;
+            float r = corners ? sdfGridCorners(p, scene, grid) : sdfGrid(p, scene, grid);
+            stats.steps++;
+            if (r < RAY_EPSILON) break;
+            if (count > MAX_STEP) break;
+            t += r;
+            count++;
+        }
+        if (t < D) stats.hits++;
+    }
+}
+
+/**
+ * @brief Compare center and corner far-fields on one scene.
+ *
+ * @param [in] name Scene name.
+ * @param [in] scene Scene to render.
+ * @param [in] limits Scene limits.
+ * @param [in] gridLevel Number of pruning levels.
+ * @param [in] origin Camera origin.
+ */
+void runScene(const char* name, const Scene& scene, const AABB& limits, int gridLevel, vec3 origin){
+    int size = scene.nodes.size();
+    std::vector<NodeBound> nodeBounds(size);
+    computeNodeBounds(scene, scene.nodes.data(), size, nodeBounds.data());
+    AABB aabb;
+    getSceneAABB(nodeBounds[size - 1], limits, 0.01f, aabb);
+
+    std::vector<vec3> points;
+    getRandomPoints(aabb, QUERIES, 42, points);
+
+    for (bool corners : {false, true}) {
+        PruningGrid grid;
+        double build = timeMs([&]{ buildPruningGrid(scene, aabb, gridLevel, true, grid, false, corners); });
+
+        // O limite dos cantos nunca pode passar da distância exata
+        int violations = 0;
+        float gain = 0.0f;
+        int farSamples = 0;
+        for (const vec3& p : points) {
+            int cellIndex = getGridCellIndex(p, grid);
+            if (!corners || grid.cells[cellIndex].size > 0) continue;
+            float exact = sdf(p, scene, scene.nodes.data(), size);
+            if (exact <= 0.0f) continue;
+            float value = getCornerFarField(p, grid, cellIndex);
+            if (value > exact) violations++;
+            gain += value - grid.farFieldValues[cellIndex];
+            farSamples++;
+        }
+
+        MarchStats stats;
+        double march = timeMs([&]{ marchImage(scene, grid, corners, origin, stats); });
+
+        std::printf("%-8s %-7s | build %8.1f ms | march %8.1f ms, %.2f steps/pixel (%.2f in far-fields), %d hits",
+                    name, corners ? "corners" : "center", build, march, (double)stats.steps / (WIDTH * HEIGHT),
+                    (double)stats.farSteps / (WIDTH * HEIGHT), stats.hits);
+        if (corners) {
+            std::printf(" | mean gain %.4f, %d of %d far samples above the SDF", gain / farSamples, violations, farSamples);
+        }
+        std::printf("\n");
+    }
+}
+
+int main(){
+    Scene scene;
+    AABB limits;
+    getScenePost(scene);
+    getAABB(limits);
+    runScene("ufabc", scene, limits, 3, {1.0f, 0.0f, 1.999f});
+
+    getSceneRings(scene, 64, 1234, limits);
+    runScene("rings64", scene, limits, 3, {0.0f, 4.0f, 1.99f});
+    return 0;
+}
@@ -0,0 +1,116 @@
+/**
+ * @file cse.cpp
+ * @brief Benchmark of the shared primitive terms.
+ *
+ * Count the primitive evaluations saved per sample by the shared terms on the full tree and on
+ * the pruned cell trees, and compare the evaluation time with the plain tree.
+ *
+ * @author Edson Martinelli
+ * @date 2026
+ */
+
+#include <cstdio>
+#include <cmath>
+#include <vector>
+#include "shape.hpp"
+#include "bounds.hpp"
+#include "pruning.hpp"
+#include "cse.hpp"
+#include "bench.hpp"
+
+const int QUERIES = 500000; /**< Random samples per scene. */
+
+/**
+ * @brief Plain and shared evaluation of the trees of a grid.
+ *
+ * @param [in] label Tree name.
+ * @param [in] scene Scene with primitives and binary operations.
+ * @param [in] grid Grid with the trees (one cell for the full tree).
+ * @param [in] shared Shared terms of the scene.
+ * @param [in] points Random samples.
+ */
+void runTrees(const char* label, const Scene& scene, const PruningGrid& grid, const SharedTerms& shared,
+              const std::vector<vec3>& points){
+    std::vector<float> plainValues(points.size()), sharedValues(points.size());
+    std::vector<int> cells(points.size());
+    for (int i = 0; i < (int)points.size(); i++) cells[i] = getGridCellIndex(points[i], grid);
+
+    long primitiveNodes = 0;
+    int samples = 0;
+    for (int i = 0; i < (int)points.size(); i++) {
+        const CellInfo& cell = grid.cells[cells[i]];
+        if (cell.size == 0) continue;
+        samples++;
+        for (int j = 0; j < cell.size; j++) primitiveNodes += grid.nodes[cell.offset + j].type == NODE_PRIMITIVE;
+    }
+
+    double plainTime = timeMs([&]{
+        for (int i = 0; i < (int)points.size(); i++) {
+            const CellInfo& cell = grid.cells[cells[i]];
+            if (cell.size == 0) continue;
+            plainValues[i] = sdf(points[i], scene, grid.nodes.data() + cell.offset, cell.size);
+        }
+    });
+
+    SharedCache cache;
+    int saved = 0;
+    double sharedTime = timeMs([&]{
+        for (int i = 0; i < (int)points.size(); i++) {
+            const CellInfo& cell = grid.cells[cells[i]];
+            if (cell.size == 0) continue;
+            sharedValues[i] = sdfShared(points[i], scene, grid.nodes.data() + cell.offset, cell.size, shared, cache, &saved);
+        }
+    });
+
+    int mismatches = 0;
+    for (int i = 0; i < (int)points.size(); i++) {
+        if (plainValues[i] != sharedValues[i]) mismatches++;
+    }
+
+    std::printf("  %-8s | primitives %6.2f, saved %5.2f per sample | plain %8.1f ns, shared %8.1f ns | %d samples, %d err\n",
+                label, (double)primitiveNodes / samples, (double)saved / samples,
+                plainTime * 1e6 / samples, sharedTime * 1e6 / samples, samples, mismatches);
+}
+
+/**
+ * @brief Compare plain and shared evaluation on one scene.
+ *
+ * @param [in] name Scene name.
+ * @param [in] scene Scene to evaluate.
+ * @param [in] limits Scene limits.
+ */
+void runScene(const char* name, Scene scene, const AABB& limits){
+    SharedTerms shared;
+    compileSharedTerms(scene, scene.nodes, shared);
+
+    int size = scene.nodes.size();
+    std::vector<NodeBound> nodeBounds(size);
+    computeNodeBounds(scene, scene.nodes.data(), size, nodeBounds.data());
+    AABB aabb;
+    getSceneAABB(nodeBounds[size - 1], limits, 0.01f, aabb);
+
+    std::vector<vec3> points;
+    getRandomPoints(aabb, QUERIES, 42, points);
+
+    std::printf("%s: %zu primitives, %d terms, %d merged\n", name, scene.primitives.size(), shared.terms, shared.merged);
+
+    PruningGrid full;
+    buildPruningGrid(scene, aabb, 0, true, full);
+    runTrees("full", scene, full, shared, points);
+
+    PruningGrid grid;
+    buildPruningGrid(scene, aabb, 2, true, grid);
+    runTrees("level 2", scene, grid, shared, points);
+}
+
+int main(){
+    Scene scene;
+    AABB limits;
+    getScenePost(scene);
+    getAABB(limits);
+    runScene("ufabc", scene, limits);
+
+    getSceneRings(scene, 64, 1234, limits);
+    runScene("rings64", scene, limits);
+    return 0;
+}
@@ -0,0 +1,134 @@
+/**
+ * @file farfield.cpp
+ * @brief Benchmark of the quantized far-field storage.
+ *
+ * Check that the filtered quantized far-fields stay below the exact distance, and compare the
+ * memory and the steps of marching an image with the float values and with 16 and 8 bits.
+ *
+ * @author Edson Martinelli
+ * @date 2026
+ */
+
+#include <cstdio>
+#include <cmath>
+#include <vector>
+#include "shape.hpp"
+#include "bounds.hpp"
+#include "pruning.hpp"
+#include "farfield.hpp"
+#include "bench.hpp"
+
+const int WIDTH = 400; /**< Image width. */
+const int HEIGHT = 300; /**< Image height. */
+const float D = 32.0f; /**< Maximun ray distance. */
+const int MAX_STEP = 256; /**< Maximun ray steps. */
+const int QUERIES = 500000; /**< Random samples for the bound check. */
+
+/**
+ * @brief Ray march an image with a pruning grid.
+ *
+ * Same loop as rayMarching() of full3DTreePruningFarFields.frag.
+ *
+ * @param [in] sdfAt SDF of the grid.
+ * @param [in] grid Pruning grid.
+ * @param [in] origin Camera origin (inside the grid).
+ * @param [out] depth Hit distance of each pixel.
+ * @param [out] steps SDF evaluations.
+ */
+template <typename F>
+void marchImage(F&& sdfAt, const PruningGrid& grid, vec3 origin, std::vector<float>& depth, long& steps){
+    steps = 0;
+    for (int y = 0; y < HEIGHT; y++)
+    for (int x = 0; x < WIDTH; x++) {
+        vec3 direction = getDirection(x, y, WIDTH, HEIGHT, origin, {0.0f, 0.0f, 0.0f});
+        float t = 0.0f;
+        int count = 0;
+        while (t < D) {
+            vec3 p = origin + direction * t;
+            if (!insideGrid(p, grid)) {
+                t = 1e20f;
+                break;
+            }
+            float r = sdfAt(p);
+            steps++;
+            if (r < RAY_EPSILON) break;
+            if (count > MAX_STEP) break;
+            t += r;
+            count++;
+        }
+        depth[y * WIDTH + x] = t;
+    }
+}
+
+/**
+ * @brief Compare the far-field storages on one scene.
+ *
+ * @param [in] name Scene name.
+ * @param [in] scene Scene to render.
+ * @param [in] limits Scene limits.
+ * @param [in] gridLevel Number of pruning levels.
+ * @param [in] origin Camera origin.
+ */
+void runScene(const char* name, const Scene& scene, const AABB& limits, int gridLevel, vec3 origin){
+    int size = scene.nodes.size();
+    std::vector<NodeBound> nodeBounds(size);
+    computeNodeBounds(scene, scene.nodes.data(), size, nodeBounds.data());
+    AABB aabb;
+    getSceneAABB(nodeBounds[size - 1], limits, 0.01f, aabb);
+
+    PruningGrid grid;
+    buildPruningGrid(scene, aabb, gridLevel, true, grid);
+
+    std::vector<float> floatDepth(WIDTH * HEIGHT), depth(WIDTH * HEIGHT);
+    long floatSteps;
+    double floatTime = timeMs([&]{
+        marchImage([&](vec3 p){ return sdfGrid(p, scene, grid); }, grid, origin, floatDepth, floatSteps);
+    });
+    std::printf("%s: %zu cells\n", name, grid.cells.size());
+    std::printf("  float  | %6.2f MB | march %8.1f ms, %ld steps\n",
+                grid.farFieldValues.size() * sizeof(float) / 1048576.0, floatTime, floatSteps);
+
+    std::vector<vec3> points;
+    getRandomPoints(aabb, QUERIES, 42, points);
+
+    for (int bits : {16, 8}) {
+        QuantizedFarField field;
+        quantizeFarFields(grid, bits, field);
+
+        // O valor filtrado nunca pode passar da distância exata
+        int violations = 0;
+        int farSamples = 0;
+        for (const vec3& p : points) {
+            if (grid.cells[getGridCellIndex(p, grid)].size > 0) continue;
+            farSamples++;
+            float exact = std::max(sdf(p, scene, scene.nodes.data(), size), 0.0f);
+            if (sdfQuantizedFarField(p, field) > exact) violations++;
+        }
+
+        long steps;
+        double time = timeMs([&]{
+            marchImage([&](vec3 p){ return sdfGridQuantized(p, scene, grid, field); }, grid, origin, depth, steps);
+        });
+
+        int hitMismatches = 0;
+        for (int i = 0; i < WIDTH * HEIGHT; i++) {
+            if ((floatDepth[i] < D) != (depth[i] < D)) hitMismatches++;
+        }
+
+        std::printf("  %2d bit | %6.2f MB | march %8.1f ms, %ld steps | %d of %d far samples above the SDF | "
+                    "%d hit mismatches\n", bits, field.values.size() * bits / 8 / 1048576.0, time, steps,
+                    violations, farSamples, hitMismatches);
+    }
+}
+
+int main(){
+    Scene scene;
+    AABB limits;
+    getScenePost(scene);
+    getAABB(limits);
+    runScene("ufabc", scene, limits, 3, {1.0f, 0.0f, 1.999f});
+
+    getSceneRings(scene, 64, 1234, limits);
+    runScene("rings64", scene, limits, 3, {0.0f, 4.0f, 1.99f});
+    return 0;
+}
@@ -0,0 +1,117 @@
+/**
+ * @file intervals.cpp
+ * @brief Benchmark of the interval pruning mode against the Lipschitz pruning.
+ *
+ * Build the far-field pruning grid with center values (Lipschitz) and with interval
+ * arithmetic, then report build time, active nodes, empty cells and the cost of ray
+ * marching an image with each grid (time, steps and nodes evaluated).
+ *
+ * @author Edson Martinelli
+ * @date 2026
+ */
+
+#include <cstdio>
+#include <vector>
+#include "shape.hpp"
+#include "bounds.hpp"
+#include "pruning.hpp"
+#include "bench.hpp"
+
+const int WIDTH = 400; /**< Image width. */
+const int HEIGHT = 300; /**< Image height. */
+const float D = 32.0f; /**< Maximun ray distance. */
+const int MAX_STEP = 256; /**< Maximun ray steps. */
+
+/**
+ * @brief Ray marching statistics of one image.
+ */
+struct MarchStats{
+    long steps = 0; /**< SDF evaluations. */
+    long nodes = 0; /**< Nodes evaluated. */
+    int hits = 0; /**< Rays that hit a surface. */
+};
+
+/**
+ * @brief Ray march an image with a pruning grid.
+ *
+ * Same loop as rayMarching() of full3DTreePruningFarFields.frag.
+ *
+ * @param [in] scene Scene to render.
+ * @param [in] grid Pruning grid.
+ * @param [in] origin Camera origin (inside the grid).
+ * @param [out] stats Marching statistics.
+ */
+void marchImage(const Scene& scene, const PruningGrid& grid, vec3 origin, MarchStats& stats){
+    for (int y = 0; y < HEIGHT; y++)
+    for (int x = 0; x < WIDTH; x++) {
+        vec3 direction = getDirection(x, y, WIDTH, HEIGHT, origin, {0.0f, 0.0f, 0.0f});
+        float t = 0.0f;
+        int count = 0;
+        while (t < D) {
+            vec3 p = origin + direction * t;
+            if (!insideGrid(p, grid)) {
+                t = 1e20f;
+                break;
+            }
+            int cellIndex = getGridCellIndex(p, grid);
+            stats.nodes += grid.cells[cellIndex].size;
+            float r = sdfGrid(p, scene, grid);
+            stats.steps++;
+            if (r < RAY_EPSILON) break;
+            if (count > MAX_STEP) break;
+            t += r;
+            count++;
+        }
+        if (t < D) stats.hits++;
+    }
+}
+
+/**
+ * @brief Compare both pruning modes on one scene.
+ *
+ * @param [in] name Scene name.
+ * @param [in] scene Scene to prune.
+ * @param [in] limits Scene limits.
+ * @param [in] gridLevel Number of pruning levels.
+ * @param [in] origin Camera origin.
+ */
+void runScene(const char* name, const Scene& scene, const AABB& limits, int gridLevel, vec3 origin){
+    int size = scene.nodes.size();
+    std::vector<NodeBound> nodeBounds(size);
+    computeNodeBounds(scene, scene.nodes.data(), size, nodeBounds.data());
+    AABB aabb;
+    getSceneAABB(nodeBounds[size - 1], limits, 0.01f, aabb);
+
+    for (bool intervals : {false, true}) {
+        PruningGrid grid;
+        double build = timeMs([&]{ buildPruningGrid(scene, aabb, gridLevel, true, grid, intervals); });
+
+        int empty = 0;
+        for (const CellInfo& cell : grid.cells) {
+            if (cell.size == 0) empty++;
+        }
+        int activeCells = grid.cells.size() - empty;
+
+        MarchStats stats;
+        double march = timeMs([&]{ marchImage(scene, grid, origin, stats); });
+
+        std::printf("%-8s %-9s | build %8.1f ms | nodes %8zu (%.2f per cell) | empty %5.1f%% | "
+                    "march %8.1f ms, %ld steps, %.2f nodes/step, %d hits\n",
+                    name, intervals ? "interval" : "lipschitz", build, grid.nodes.size(),
+                    activeCells > 0 ? (double)grid.nodes.size() / activeCells : 0.0,
+                    100.0 * empty / grid.cells.size(), march, stats.steps,
+                    (double)stats.nodes / stats.steps, stats.hits);
+    }
+}
+
+int main(){
+    Scene scene;
+    AABB limits;
+    getScenePost(scene);
+    getAABB(limits);
+    runScene("ufabc", scene, limits, 3, {1.0f, 0.0f, 1.999f});
+
+    getSceneRings(scene, 64, 1234, limits);
+    runScene("rings64", scene, limits, 3, {0.0f, 4.0f, 1.99f});
+    return 0;
+}
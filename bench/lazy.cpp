@@ -0,0 +1,84 @@
+/**
+ * @file lazy.cpp
+ * @brief Nodes evaluated per sample by the CPU evaluators.
+ *
+ * Compare the full tree evaluation, the bounding box early-out of sdf() and the lazy
+ * min/max evaluation of sdfLazy() in nodes evaluated per sample, time per sample and
+ * differences near the surface. Runs on the UFABC scene and on a procedural scene.
+ *
+ * @author Edson Martinelli
+ * @date 2026
+ */
+
+#include <cstdio>
+#include <cmath>
+#include <vector>
+#include "shape.hpp"
+#include "bounds.hpp"
+#include "evaluator.hpp"
+#include "bench.hpp"
+
+const int QUERIES = 200000; /**< Random samples per scene. */
+const float SURFACE_DISTANCE = 0.05f; /**< Samples closer than this to the surface must match. */
+
+/**
+ * @brief Run the evaluators on one scene.
+ *
+ * @param [in] name Scene name.
+ * @param [in] scene Scene to evaluate.
+ * @param [in] limits Scene limits.
+ */
+void runScene(const char* name, const Scene& scene, const AABB& limits){
+    int size = scene.nodes.size();
+    const Node* nodes = scene.nodes.data();
+    std::vector<NodeBound> nodeBounds(size);
+    computeNodeBounds(scene, nodes, size, nodeBounds.data());
+    AABB aabb;
+    getSceneAABB(nodeBounds[size - 1], limits, 0.01f, aabb);
+
+    std::vector<vec3> points;
+    getRandomPoints(aabb, QUERIES, 42, points);
+    std::vector<float> full(QUERIES), boxed(QUERIES), lazy(QUERIES);
+    int fullNodes = 0, boxedNodes = 0, lazyNodes = 0;
+
+    double fullTime = timeMs([&]{
+        for (int i = 0; i < QUERIES; i++) full[i] = sdf(points[i], scene, nodes, size, nullptr, &fullNodes);
+    });
+    double boxedTime = timeMs([&]{
+        for (int i = 0; i < QUERIES; i++) boxed[i] = sdf(points[i], scene, nodes, size, nodeBounds.data(), &boxedNodes);
+    });
+    double lazyTime = timeMs([&]{
+        for (int i = 0; i < QUERIES; i++) lazy[i] = sdfLazy(points[i], scene, nodes, size, nodeBounds.data(), &lazyNodes);
+    });
+
+    int boxedMismatches = 0, lazyMismatches = 0, lazyAbove = 0;
+    for (int i = 0; i < QUERIES; i++) {
+        if (lazy[i] > full[i] + 1e-4f) lazyAbove++;
+        if (std::fabs(full[i]) > SURFACE_DISTANCE) continue;
+        if (std::fabs(boxed[i] - full[i]) > 1e-4f) boxedMismatches++;
+        if (std::fabs(lazy[i] - full[i]) > 1e-4f) lazyMismatches++;
+    }
+
+    std::printf("%-10s | nodes %6d | full %8.1f nodes %9.1f ns | box %8.1f nodes %9.1f ns (%d err) | "
+                "lazy %8.1f nodes %9.1f ns (%d err, %d above)\n",
+                name, size,
+                (double)fullNodes / QUERIES, fullTime * 1e6 / QUERIES,
+                (double)boxedNodes / QUERIES, boxedTime * 1e6 / QUERIES, boxedMismatches,
+                (double)lazyNodes / QUERIES, lazyTime * 1e6 / QUERIES, lazyMismatches, lazyAbove);
+}
+
+int main(){
+    Scene scene;
+    AABB limits;
+    getScenePost(scene);
+    getAABB(limits);
+    runScene("ufabc", scene, limits);
+
+    for (int count : {64, 512}) {
+        char name[32];
+        std::snprintf(name, sizeof(name), "rings%d", count);
+        getSceneRings(scene, count, 1234, limits);
+        runScene(name, scene, limits);
+    }
+    return 0;
+}
@@ -0,0 +1,99 @@
+/**
+ * @file mesh.cpp
+ * @brief Benchmark of the mesh extraction.
+ *
+ * Compare the extraction over the pruned cells with the dense one (every cell with the full
+ * tree) at the same voxel resolution, count the open edges of the welded mesh and write it as
+ * binary PLY and OBJ in the build directory.
+ *
+ * @author Edson Martinelli
+ * @date 2026
+ */
+
+#include <cstdio>
+#include <cmath>
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include "shape.hpp"
+#include "bounds.hpp"
+#include "pruning.hpp"
+#include "mesh.hpp"
+#include "bench.hpp"
+
+const int GRID_LEVEL = 2; /**< Number of pruning levels. */
+const int RESOLUTION = 16; /**< Voxels per cell axis. */
+
+/**
+ * @brief Number of edges used by only one triangle.
+ *
+ * @param [in] mesh Mesh to check.
+ * @return Open edges (0 for a closed welded mesh).
+ */
+long getOpenEdges(const Mesh& mesh){
+    std::unordered_map<uint64_t, int> edges;
+    for (size_t i = 0; i < mesh.triangles.size(); i += 3)
+    for (int e = 0; e < 3; e++) {
+        uint64_t a = mesh.triangles[i + e], b = mesh.triangles[i + (e + 1) % 3];
+        edges[a < b ? a << 32 | b : b << 32 | a]++;
+    }
+    long open = 0;
+    for (const auto& edge : edges) open += edge.second == 1;
+    return open;
+}
+
+/**
+ * @brief Compare the pruned and dense extraction on one scene.
+ *
+ * @param [in] name Scene name.
+ * @param [in] scene Scene to polygonize.
+ * @param [in] limits Scene limits.
+ */
+void runScene(const char* name, const Scene& scene, const AABB& limits){
+    int size = scene.nodes.size();
+    std::vector<NodeBound> nodeBounds(size);
+    computeNodeBounds(scene, scene.nodes.data(), size, nodeBounds.data());
+    AABB aabb;
+    getSceneAABB(nodeBounds[size - 1], limits, 0.01f, aabb);
+
+    PruningGrid grid;
+    double build = timeMs([&]{ buildPruningGrid(scene, aabb, GRID_LEVEL, true, grid); });
+    int active = 0;
+    for (const CellInfo& cell : grid.cells) active += cell.size > 0;
+
+    // Grade densa: todas as células com a árvore completa
+    PruningGrid dense = grid;
+    dense.nodes = scene.nodes;
+    for (CellInfo& cell : dense.cells) cell = {0, size};
+
+    std::printf("%s: %d of %zu cells with tree, %d^3 voxels\n", name, active, grid.cells.size(),
+                grid.subdivisions * RESOLUTION);
+
+    Mesh mesh;
+    for (int threads : {1, 0}) {
+        Mesh denseMesh;
+        double denseTime = timeMs([&]{ extractMesh(scene, dense, RESOLUTION, denseMesh, threads); });
+        double time = timeMs([&]{ extractMesh(scene, grid, RESOLUTION, mesh, threads); });
+        std::printf("  %-8s | dense %9.1f ms, %zu triangles | pruned %8.1f ms (+ %.1f ms build), %zu triangles\n",
+                    threads == 1 ? "1 thread" : "threads", denseTime, denseMesh.triangles.size() / 3, time, build,
+                    mesh.triangles.size() / 3);
+    }
+
+    std::printf("  %zu vertices, %ld open edges\n", mesh.vertices.size(), getOpenEdges(mesh));
+    std::string path = std::string("build/") + name;
+    if (!writePLY((path + ".ply").c_str(), mesh) || !writeOBJ((path + ".obj").c_str(), mesh)) {
+        std::printf("  failed to write %s\n", path.c_str());
+    }
+}
+
+int main(){
+    Scene scene;
+    AABB limits;
+    getScenePost(scene);
+    getAABB(limits);
+    runScene("ufabc", scene, limits);
+
+    getSceneRings(scene, 64, 1234, limits);
+    runScene("rings64", scene, limits);
+    return 0;
+}
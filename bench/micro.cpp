@@ -0,0 +1,335 @@
+/**
+ * @file micro.cpp
+ * @brief Microbenchmarks of the primitives, operations and normal estimators.
+ *
+ * Measures ns per call of each primitive type, each operation (hard and smooth union and
+ * intersection, 8 operand n-ary union), each normal estimator (4, 6, 18 and 26 points, on the
+ * full UFABC tree) and the full tree, on the scalar path (one point per call) and on the
+ * packet path (QUERY_PACKET points per call through the per-type loops of query.hpp, which
+ * the compiler vectorizes). The points come from a fixed seed. Each repetition of a case runs
+ * at least MIN_TIME_MS, and a pass runs REPEATS repetitions of the cases interleaved (round r
+ * of every case before round r + 1 of any), so a slow period of the machine spreads over all
+ * the cases instead of landing on a few; each case keeps the fastest repetition of the pass.
+ *
+ * The results are compared with a baseline file (name,ns per call). The whole machine drifts
+ * between runs (the same binary measured 0.6x to 1.2x of its own baseline), so when a pass is
+ * slower than the baseline the threshold scales with its drift, the median ratio of all the
+ * cases: a case is above the tolerance when its ratio exceeds drift * (1 + tolerance), and a
+ * slowdown of every case shows as drift, not as regressions. While a case is above, every case
+ * is measured again in a new pass, up to RECHECKS times, and a case is a regression (exit code
+ * 1) only when it is above in every pass. A new baseline keeps the median of RECHECKS + 1
+ * passes, so a lucky pass does not become the reference. Over 90 pairs of runs of the same
+ * binary this flagged none at the 15% tolerance (the median of the pooled repetitions flagged
+ * 26), and it caught a 30% slowdown of one case in 59% of the pairs and a 50% one in 95%.
+ *
+ * Usage: ./bench.sh micro [--update] [--baseline PATH] [--tolerance X]
+ *
+ * @author Edson Martinelli
+ * @date 2026
+ */
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <functional>
+#include "shape.hpp"
+#include "bounds.hpp"
+#include "evaluator.hpp"
+#include "query.hpp"
+#include "normal.hpp"
+#include "bench.hpp"
+
+const int POINTS = 4096; /**< Points per run. */
+const unsigned int SEED = 42; /**< Seed of the points and operand values. */
+const double MIN_TIME_MS = 20.0; /**< Minimum time of a repetition. */
+const int REPEATS = 15; /**< Interleaved repetitions per case in a pass (the fastest is kept). */
+const int RECHECKS = 2; /**< Passes again while a case is above the tolerance. */
+
+volatile float sink; /**< Keeps the results alive. */
+
+/**
+ * @brief Result of a case.
+ */
+struct MicroResult{
+    std::string name; /**< Case name (group/case/path). */
+    double ns; /**< Time per call in ns. */
+};
+
+/**
+ * @brief Case to measure.
+ */
+struct MicroCase{
+    std::string name; /**< Case name (group/case/path). */
+    int calls; /**< Calls per run. */
+    std::function<float()> run; /**< Runs the calls and returns a value to keep. */
+    int iterations = 0; /**< Runs per repetition, 0 before the calibration. */
+    double ns = 0.0; /**< Fastest time per call of the last pass in ns. */
+    std::vector<double> passes; /**< Fastest time per call of each pass in ns. */
+};
+
+/**
+ * @brief Measure one pass of the cases with interleaved repetitions.
+ *
+ * Each case is first calibrated to run at least MIN_TIME_MS per repetition; then every round
+ * runs one repetition of each case.
+ *
+ * @param [in,out] cases Cases, with the time of the pass.
+ */
+void measurePass(std::vector<MicroCase>& cases){
+    for (MicroCase& c : cases) {
+        c.ns = 1e300;
+        if (c.iterations > 0) continue;
+        c.iterations = 1;
+        while (timeMs([&]{ for (int i = 0; i < c.iterations; i++) sink = c.run(); }) < MIN_TIME_MS) c.iterations *= 2;
+    }
+    for (int r = 0; r < REPEATS; r++) {
+        for (MicroCase& c : cases) {
+            double ms = timeMs([&]{ for (int i = 0; i < c.iterations; i++) sink = c.run(); });
+            c.ns = std::min(c.ns, ms * 1e6 / ((double)c.iterations * c.calls));
+        }
+    }
+    for (MicroCase& c : cases) c.passes.push_back(c.ns);
+}
+
+/**
+ * @brief Read a baseline file.
+ *
+ * @param [in] path File path.
+ * @param [out] baseline Cases of the file.
+ * @return False if the file does not exist.
+ */
+bool readBaseline(const char* path, std::vector<MicroResult>& baseline){
+    FILE* file = std::fopen(path, "r");
+    if (file == nullptr) return false;
+    char line[256];
+    while (std::fgets(line, sizeof(line), file)) {
+        char* comma = std::strchr(line, ',');
+        if (comma == nullptr || std::strncmp(line, "name,", 5) == 0) continue;
+        *comma = '\0';
+        baseline.push_back({line, std::atof(comma + 1)});
+    }
+    std::fclose(file);
+    return true;
+}
+
+/**
+ * @brief Write a baseline file.
+ *
+ * @param [in] path File path.
+ * @param [in] results Cases to store.
+ * @return False if the file could not be written.
+ */
+bool writeBaseline(const char* path, const std::vector<MicroResult>& results){
+    FILE* file = std::fopen(path, "w");
+    if (file == nullptr) return false;
+    std::fprintf(file, "name,ns_per_call\n");
+    for (const MicroResult& result : results) std::fprintf(file, "%s,%.4f\n", result.name.c_str(), result.ns);
+    return std::fclose(file) == 0;
+}
+
+int main(int argc, char** argv){
+    bool update = false;
+    std::string baselinePath = "build/micro_baseline.csv";
+    double tolerance = 0.15;
+    for (int i = 1; i < argc; i++) {
+        std::string option = argv[i];
+        if (option == "--update") update = true;
+        else if (option == "--baseline" && i + 1 < argc) baselinePath = argv[++i];
+        else if (option == "--tolerance" && i + 1 < argc) tolerance = std::atof(argv[++i]);
+        else {
+            std::fprintf(stderr, "Usage: %s [--update] [--baseline PATH] [--tolerance X]\n", argv[0]);
+            return 2;
+        }
+    }
+
+    Scene scene;
+    AABB limits;
+    getScenePost(scene);
+    getAABB(limits);
+    int size = scene.nodes.size();
+    std::vector<NodeBound> nodeBounds(size);
+    computeNodeBounds(scene, scene.nodes.data(), size, nodeBounds.data());
+    AABB aabb;
+    getSceneAABB(nodeBounds[size - 1], limits, 0.01f, aabb);
+
+    std::vector<vec3> points;
+    getRandomPoints(aabb, POINTS, SEED, points);
+    std::vector<float> a(POINTS), b(POINTS);
+    for (int i = 0; i < POINTS; i++) {
+        a[i] = points[i].x;
+        b[i] = points[i].y;
+    }
+
+    std::vector<MicroCase> cases;
+    float packet[QUERY_PACKET];
+    float operands[8][QUERY_PACKET];
+
+    // Primitivas: a primeira de cada tipo na cena
+    const char* primitiveNames[] = {"cylinder", "box", "plane_cutter", "floor"};
+    for (int type = PRIMITIVE_CYLINDER; type <= PRIMITIVE_FLOOR; type++) {
+        const Primitive* pr = nullptr;
+        for (const Primitive& candidate : scene.primitives) {
+            if (candidate.type == type) {
+                pr = &candidate;
+                break;
+            }
+        }
+        if (pr == nullptr) continue;
+        std::string name = std::string("primitive/") + primitiveNames[type];
+        cases.push_back({name + "/scalar", POINTS, [&, pr]{
+            float sum = 0.0f;
+            for (int i = 0; i < POINTS; i++) sum += evalPrimitive(points[i], *pr);
+            return sum;
+        }});
+        cases.push_back({name + "/packet", POINTS, [&, pr]{
+            float sum = 0.0f;
+            for (int i = 0; i < POINTS; i += QUERY_PACKET) {
+                evalPrimitivePacket(&points[i], QUERY_PACKET, *pr, packet);
+                for (int j = 0; j < QUERY_PACKET; j++) sum += packet[j];
+            }
+            return sum;
+        }});
+    }
+
+    // Operações com dois operandos e união n-ária de 8 operandos
+    struct OperationCase{ const char* name; BinaryOperation operation; int operands; };
+    OperationCase operations[] = {{"union", {0.0f, 1, 1, 1}, 2},
+                                  {"smooth_union", {0.05f, 1, 1, 1}, 2},
+                                  {"intersection", {0.0f, -1, 1, 1}, 2},
+                                  {"smooth_intersection", {0.05f, -1, 1, 1}, 2},
+                                  {"nary8_union", {0.0f, 1, 1, 1}, 8}};
+    for (const OperationCase& c : operations) {
+        std::string name = std::string("operation/") + c.name;
+        int calls = POINTS / c.operands;
+        cases.push_back({name + "/scalar", calls, [&, c]{
+            float sum = 0.0f;
+            for (int i = 0; i + c.operands <= POINTS; i += c.operands) sum += foldOperation(c.operation, &a[i], c.operands);
+            return sum;
+        }});
+        cases.push_back({name + "/packet", calls / QUERY_PACKET * QUERY_PACKET, [&, c]{
+            float sum = 0.0f;
+            for (int i = 0; i + QUERY_PACKET * c.operands <= POINTS; i += QUERY_PACKET * c.operands) {
+                std::copy(&b[i], &b[i] + QUERY_PACKET, packet);
+                for (int o = 1; o < c.operands; o++) std::copy(&a[i + o * QUERY_PACKET], &a[i + (o + 1) * QUERY_PACKET], operands[o - 1]);
+                foldOperationPacket(c.operation, packet, operands, c.operands - 1, QUERY_PACKET);
+                for (int j = 0; j < QUERY_PACKET; j++) sum += packet[j];
+            }
+            return sum;
+        }});
+    }
+
+    // Árvore inteira e estimadores de normal sobre ela
+    auto f = [&](vec3 p){ return sdf(p, scene, scene.nodes.data(), size); };
+    auto fPacket = [&](const vec3* p, int count, float* values){ sdfPacket(p, count, scene, scene.nodes.data(), size, values); };
+    std::vector<float> values(POINTS);
+    for (int i = 0; i < POINTS; i++) values[i] = f(points[i]);
+
+    cases.push_back({"tree/ufabc/scalar", POINTS, [&]{
+        float sum = 0.0f;
+        for (int i = 0; i < POINTS; i++) sum += f(points[i]);
+        return sum;
+    }});
+    cases.push_back({"tree/ufabc/packet", POINTS, [&]{
+        float sum = 0.0f;
+        for (int i = 0; i < POINTS; i += QUERY_PACKET) {
+            fPacket(&points[i], QUERY_PACKET, packet);
+            for (int j = 0; j < QUERY_PACKET; j++) sum += packet[j];
+        }
+        return sum;
+    }});
+
+    int normalPoints = POINTS / 8;
+    for (int stencilPoints : {4, 6, 18, 26}) {
+        NormalStencil stencil;
+        getNormalStencil(stencilPoints, stencil);
+        std::string name = "normal/" + std::to_string(stencilPoints) + "points";
+        cases.push_back({name + "/scalar", normalPoints, [&, stencil]{
+            float sum = 0.0f;
+            for (int i = 0; i < normalPoints; i++) sum += getNormal(points[i], values[i], stencil, f).x;
+            return sum;
+        }});
+        cases.push_back({name + "/packet", normalPoints, [&, stencil]{
+            float sum = 0.0f;
+            for (int i = 0; i < normalPoints; i++) sum += getNormalPacket(points[i], values[i], stencil, fPacket).x;
+            return sum;
+        }});
+    }
+
+    measurePass(cases);
+
+    std::vector<MicroResult> baseline;
+    bool hasBaseline = readBaseline(baselinePath.c_str(), baseline);
+    // Base de cada caso, 0 sem base
+    std::vector<double> stored(cases.size(), 0.0);
+    for (int i = 0; i < (int)cases.size(); i++) {
+        auto found = std::find_if(baseline.begin(), baseline.end(), [&](const MicroResult& r){ return r.name == cases[i].name; });
+        if (found != baseline.end()) stored[i] = found->ns;
+    }
+    // Deriva da máquina: mediana das razões, só quando a passada está mais lenta que a base
+    auto getDrift = [&]{
+        std::vector<double> ratios;
+        for (int i = 0; i < (int)cases.size(); i++) {
+            if (stored[i] > 0.0) ratios.push_back(cases[i].ns / stored[i]);
+        }
+        if (ratios.empty()) return 1.0;
+        std::sort(ratios.begin(), ratios.end());
+        return std::max(1.0, ratios[ratios.size() / 2]);
+    };
+    // Acima da tolerância em todas as passadas até agora
+    std::vector<bool> above(cases.size(), true);
+    double drift = 1.0;
+    auto updateAbove = [&]{
+        drift = getDrift();
+        int count = 0;
+        for (int i = 0; i < (int)cases.size(); i++) {
+            above[i] = above[i] && stored[i] > 0.0 && cases[i].ns > stored[i] * drift * (1.0 + tolerance);
+            count += above[i];
+        }
+        return count;
+    };
+
+    // Caso acima da tolerância: nova passada antes de chamar de regressão
+    int count = updateAbove();
+    for (int recheck = 0; recheck < RECHECKS && count > 0 && hasBaseline && !update; recheck++) {
+        std::printf("%d cases above %.0f%%, measuring again\n", count, tolerance * 100.0);
+        measurePass(cases);
+        count = updateAbove();
+    }
+
+    // Base nova: mediana de RECHECKS + 1 passadas, para não guardar uma passada com sorte
+    bool writing = update || !hasBaseline;
+    if (writing) {
+        for (int pass = 0; pass < RECHECKS; pass++) measurePass(cases);
+        for (MicroCase& c : cases) {
+            std::sort(c.passes.begin(), c.passes.end());
+            c.ns = c.passes[c.passes.size() / 2];
+        }
+    }
+
+    std::vector<MicroResult> results;
+    int regressions = 0;
+    if (hasBaseline) std::printf("drift %.3f (median ratio of the last pass, at least 1)\n", drift);
+    std::printf("%-36s %12s %12s %8s\n", "case", "ns/call", "baseline", "ratio");
+    for (int i = 0; i < (int)cases.size(); i++) {
+        double ns = cases[i].ns;
+        results.push_back({cases[i].name, ns});
+        if (stored[i] <= 0.0) {
+            std::printf("%-36s %12.2f %12s %8s\n", cases[i].name.c_str(), ns, "-", "-");
+            continue;
+        }
+        double ratio = ns / stored[i];
+        const char* flag = above[i] ? "  REGRESSION" : ratio < 1.0 - tolerance ? "  faster" : "";
+        regressions += above[i];
+        std::printf("%-36s %12.2f %12.2f %8.3f%s\n", cases[i].name.c_str(), ns, stored[i], ratio, flag);
+    }
+
+    if (writing) {
+        if (writeBaseline(baselinePath.c_str(), results)) std::printf("baseline written to %s\n", baselinePath.c_str());
+        return 0;
+    }
+    std::printf("%d regressions above %.0f%% (baseline %s)\n", regressions, tolerance * 100.0, baselinePath.c_str());
+    return regressions > 0 ? 1 : 0;
+}
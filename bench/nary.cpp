@@ -0,0 +1,131 @@
+/**
+ * @file nary.cpp
+ * @brief Benchmark of the n-ary flattening.
+ *
+ * Compare the binary tree with the flattened tree in nodes, evaluation stack depth, full tree
+ * evaluation time and nodes left by the pruning.
+ *
+ * @author Edson Martinelli
+ * @date 2026
+ */
+
+#include <cstdio>
+#include <cmath>
+#include <vector>
+#include <algorithm>
+#include "shape.hpp"
+#include "bounds.hpp"
+#include "pruning.hpp"
+#include "flatten.hpp"
+#include "bench.hpp"
+
+const int QUERIES = 200000; /**< Random samples per scene. */
+
+/**
+ * @brief Largest evaluation stack of a tree.
+ *
+ * Same stack as sdf(): an operand of an n-ary node is folded into the value of the operand
+ * before it (see pushValue).
+ *
+ * @param [in] nodes Post-order node array.
+ * @return Maximum number of values on the stack.
+ */
+int getStackDepth(const std::vector<Node>& nodes){
+    std::vector<int> start;
+    getSubtreeStarts(nodes.data(), nodes.size(), start);
+    std::vector<int> stack;
+    int depth = 0;
+    for (int i = 0; i < (int)nodes.size(); i++) {
+        while (!stack.empty() && stack.back() >= start[i]) stack.pop_back();
+        int parent = nodes[i].parent;
+        bool folded = !stack.empty() && parent >= 0 && nodes[stack.back()].parent == parent &&
+                      nodes[parent].type == NODE_NARY;
+        if (!folded) stack.push_back(i);
+        depth = std::max(depth, (int)stack.size());
+    }
+    return depth;
+}
+
+/**
+ * @brief Statistics of one tree.
+ *
+ * @param [in] label Tree name.
+ * @param [in] scene Scene with the tree in scene.nodes.
+ * @param [in] aabb Pruning grid extent.
+ * @param [in] points Random samples.
+ * @param [in] reference Values of the binary tree at the samples.
+ */
+void runTree(const char* label, const Scene& scene, const AABB& aabb, const std::vector<vec3>& points,
+             const std::vector<float>& reference){
+    const std::vector<Node>& nodes = scene.nodes;
+    int size = nodes.size();
+
+    std::vector<float> values(points.size());
+    double fullTime = timeMs([&]{
+        for (int i = 0; i < (int)points.size(); i++) values[i] = sdf(points[i], scene, nodes.data(), size);
+    });
+    int mismatches = 0;
+    for (int i = 0; i < (int)points.size(); i++) {
+        if (std::fabs(values[i] - reference[i]) > 1e-5f) mismatches++;
+    }
+
+    std::printf("  %-7s | nodes %5d, stack %3d | full %8.1f ns, %d err |", label, size, getStackDepth(nodes),
+                fullTime * 1e6 / points.size(), mismatches);
+
+    for (int level = 2; level <= 3; level++) {
+        PruningGrid grid;
+        buildPruningGrid(scene, aabb, level, true, grid);
+        long cellNodes = 0;
+        int samples = 0;
+        for (const vec3& p : points) {
+            const CellInfo& cell = grid.cells[getGridCellIndex(p, grid)];
+            if (cell.size == 0) continue;
+            cellNodes += cell.size;
+            samples++;
+        }
+        std::printf(" level %d: %8zu nodes, %5.2f per sample |", level, grid.nodes.size(), (double)cellNodes / samples);
+    }
+    std::printf("\n");
+}
+
+/**
+ * @brief Compare the binary and the flattened tree on one scene.
+ *
+ * @param [in] name Scene name.
+ * @param [in] scene Scene with the binary tree.
+ * @param [in] limits Scene limits.
+ */
+void runScene(const char* name, const Scene& scene, const AABB& limits){
+    int size = scene.nodes.size();
+    std::vector<NodeBound> nodeBounds(size);
+    computeNodeBounds(scene, scene.nodes.data(), size, nodeBounds.data());
+    AABB aabb;
+    getSceneAABB(nodeBounds[size - 1], limits, 0.01f, aabb);
+
+    std::vector<vec3> points;
+    getRandomPoints(aabb, QUERIES, 42, points);
+    std::vector<float> reference(points.size());
+    for (int i = 0; i < (int)points.size(); i++) reference[i] = sdf(points[i], scene, scene.nodes.data(), size);
+
+    Scene flat = scene;
+    flattenTree(scene, scene.nodes, flat.nodes);
+
+    std::printf("%s\n", name);
+    runTree("binary", scene, aabb, points, reference);
+    runTree("n-ary", flat, aabb, points, reference);
+}
+
+int main(){
+    Scene scene;
+    AABB limits;
+    getScenePost(scene);
+    getAABB(limits);
+    runScene("ufabc", scene, limits);
+
+    getSceneRings(scene, 64, 1234, limits);
+    runScene("rings64", scene, limits);
+
+    getSceneRings(scene, 512, 1234, limits);
+    runScene("rings512", scene, limits);
+    return 0;
+}
@@ -0,0 +1,123 @@
+/**
+ * @file profile.cpp
+ * @brief Benchmark of the 2D profile factorization.
+ *
+ * Compare the column queries (many z for the same x and y) and an XZ slice image evaluated
+ * point by point with the tree and by columns with the factored profiles.
+ *
+ * @author Edson Martinelli
+ * @date 2026
+ */
+
+#include <cstdio>
+#include <cmath>
+#include <vector>
+#include "shape.hpp"
+#include "bounds.hpp"
+#include "flatten.hpp"
+#include "profile.hpp"
+#include "bench.hpp"
+
+const int COLUMNS = 8192; /**< Random columns per scene. */
+const int COLUMN_SAMPLES = 64; /**< Samples per column. */
+const int SLICE_SIZE = 512; /**< Width and height of the slice image. */
+
+/**
+ * @brief Point and column evaluation of a set of columns.
+ *
+ * @param [in] label Query name.
+ * @param [in] scene Scene with primitives and binary operations.
+ * @param [in] nodes Post-order node array.
+ * @param [in] plan Factored subtrees.
+ * @param [in] xy Position of each column.
+ * @param [in] z Z coordinate of the samples.
+ */
+void runColumns(const char* label, const Scene& scene, const std::vector<Node>& nodes, const ProfilePlan& plan,
+                const std::vector<vec2>& xy, const std::vector<float>& z){
+    int size = nodes.size();
+    int columns = xy.size();
+    int count = z.size();
+    std::vector<float> pointValues((size_t)columns * count), columnValues((size_t)columns * count);
+    std::vector<float> profiles;
+
+    double pointTime = timeMs([&]{
+        for (int c = 0; c < columns; c++) {
+            for (int k = 0; k < count; k++) {
+                pointValues[(size_t)c * count + k] = sdf({xy[c].x, xy[c].y, z[k]}, scene, nodes.data(), size);
+            }
+        }
+    });
+
+    double columnTime = timeMs([&]{
+        sdfColumns(xy.data(), columns, z.data(), count, scene, nodes.data(), size, plan, profiles, columnValues.data());
+    });
+
+    int mismatches = 0;
+    for (size_t i = 0; i < pointValues.size(); i++) {
+        if (pointValues[i] != columnValues[i]) mismatches++;
+    }
+
+    double samples = (double)columns * count;
+    std::printf("  %-8s | point %8.1f ns, column %8.1f ns per sample (%.2fx) | %d err\n", label,
+                pointTime * 1e6 / samples, columnTime * 1e6 / samples, pointTime / columnTime, mismatches);
+}
+
+/**
+ * @brief Compare point and column queries on one scene.
+ *
+ * @param [in] name Scene name.
+ * @param [in] scene Scene to evaluate.
+ * @param [in] limits Scene limits.
+ * @param [in] flat Flatten the operation chains.
+ */
+void runScene(const char* name, const Scene& scene, const AABB& limits, bool flat){
+    std::vector<Node> nodes = scene.nodes;
+    if (flat) flattenTree(scene, scene.nodes, nodes);
+    int size = nodes.size();
+
+    ProfilePlan plan;
+    compileProfilePlan(scene, nodes.data(), size, plan);
+
+    std::vector<NodeBound> nodeBounds(scene.nodes.size());
+    computeNodeBounds(scene, scene.nodes.data(), scene.nodes.size(), nodeBounds.data());
+    AABB aabb;
+    getSceneAABB(nodeBounds[scene.nodes.size() - 1], limits, 0.01f, aabb);
+
+    std::printf("%s%s: %d nodes, %d factored subtrees, %d primitives merged\n", name, flat ? " (n-ary)" : "",
+                size, plan.factored, plan.merged);
+
+    std::vector<vec3> points;
+    getRandomPoints(aabb, COLUMNS, 42, points);
+    std::vector<vec2> xy(COLUMNS);
+    for (int i = 0; i < COLUMNS; i++) xy[i] = {points[i].x, points[i].y};
+    std::vector<float> z(COLUMN_SAMPLES);
+    for (int k = 0; k < COLUMN_SAMPLES; k++) {
+        z[k] = aabb.minimum.z + (aabb.maximum.z - aabb.minimum.z) * (k + 0.5f) / COLUMN_SAMPLES;
+    }
+    runColumns("columns", scene, nodes, plan, xy, z);
+
+    // Fatia XZ: cada coluna da imagem é uma coluna da consulta
+    float y = 0.5f * (aabb.minimum.y + aabb.maximum.y);
+    std::vector<vec2> sliceXY(SLICE_SIZE);
+    std::vector<float> sliceZ(SLICE_SIZE);
+    for (int i = 0; i < SLICE_SIZE; i++) {
+        float t = (i + 0.5f) / SLICE_SIZE;
+        sliceXY[i] = {aabb.minimum.x + (aabb.maximum.x - aabb.minimum.x) * t, y};
+        sliceZ[i] = aabb.minimum.z + (aabb.maximum.z - aabb.minimum.z) * t;
+    }
+    runColumns("slice", scene, nodes, plan, sliceXY, sliceZ);
+}
+
+int main(){
+    Scene scene;
+    AABB limits;
+    getScenePost(scene);
+    getAABB(limits);
+    runScene("ufabc", scene, limits, false);
+    runScene("ufabc", scene, limits, true);
+
+    getSceneRings(scene, 64, 1234, limits);
+    runScene("rings64", scene, limits, false);
+    runScene("rings64", scene, limits, true);
+    return 0;
+}
@@ -0,0 +1,75 @@
+/**
+ * @file pruning.cpp
+ * @brief Per-level statistics of the CPU pruning.
+ *
+ * Build the pruning grid with the center and the interval bounds, print the time, active
+ * cells, nodes and far-field fraction of each level (the same values the benchmark mode of
+ * main.cpp reads back from the compute shader) and write them to build/pruning_<scene>.json.
+ *
+ * @author Edson Martinelli
+ * @date 2026
+ */
+
+#include <cstdio>
+#include <string>
+#include <vector>
+#include "shape.hpp"
+#include "bounds.hpp"
+#include "pruning.hpp"
+#include "stats.hpp"
+#include "bench.hpp"
+
+const int GRID_LEVEL = 3; /**< Number of pruning levels. */
+
+/**
+ * @brief Print and write the level statistics of one scene.
+ *
+ * @param [in] name Scene name.
+ * @param [in] scene Scene to prune.
+ * @param [in] limits Scene limits.
+ */
+void runScene(const char* name, const Scene& scene, const AABB& limits){
+    int size = scene.nodes.size();
+    std::vector<NodeBound> nodeBounds(size);
+    computeNodeBounds(scene, scene.nodes.data(), size, nodeBounds.data());
+    AABB aabb;
+    getSceneAABB(nodeBounds[size - 1], limits, 0.01f, aabb);
+
+    std::string path = std::string("build/pruning_") + name + ".json";
+    FILE* file = std::fopen(path.c_str(), "w");
+    if (file != nullptr) std::fprintf(file, "{\n  \"scene\": \"%s\",\n  \"nodes\": %d,\n", name, size);
+
+    for (bool intervals : {false, true}) {
+        PruningGrid grid;
+        std::vector<PruningLevelStats> levels;
+        buildPruningGrid(scene, aabb, GRID_LEVEL, true, grid, intervals, false, &levels);
+
+        for (const PruningLevelStats& level : levels) {
+            std::printf("%-8s %-9s level %d (%3d^3) | %9.2f ms | %7d active cells | %8ld nodes | %6.2f mean, %3d max nodes"
+                        " | %5.1f%% far-field\n", name, intervals ? "intervals" : "center", level.level,
+                        level.subdivisions, level.time, level.activeCells, level.nodes, level.meanNodes,
+                        level.maxNodes, level.farFieldFraction * 100.0);
+        }
+
+        if (file == nullptr) continue;
+        writePruningLevelsJSON(file, intervals ? "intervals" : "center", levels);
+        std::fprintf(file, intervals ? "\n" : ",\n");
+    }
+
+    if (file != nullptr) {
+        std::fprintf(file, "}\n");
+        std::fclose(file);
+    }
+}
+
+int main(){
+    Scene scene;
+    AABB limits;
+    getScenePost(scene);
+    getAABB(limits);
+    runScene("ufabc", scene, limits);
+
+    getSceneRings(scene, 64, 1234, limits);
+    runScene("rings64", scene, limits);
+    return 0;
+}
@@ -0,0 +1,146 @@
+/**
+ * @file query.cpp
+ * @brief Benchmark of the batched distance and gradient queries.
+ *
+ * Compare the throughput of distances() and gradients() (query.hpp) with a loop of sdfGrid()
+ * and a loop of the full tree, for uniform random points and for clustered points like a
+ * particle system, and check that the batched values match the loop. The sdfGrid() loop and
+ * the batched queries run TICKS batches per repetition, and keep the fastest of REPEATS
+ * interleaved repetitions.
+ *
+ * @author Edson Martinelli
+ * @date 2026
+ */
+
+#include <cstdio>
+#include <cmath>
+#include <random>
+#include <vector>
+#include <algorithm>
+#include "shape.hpp"
+#include "bounds.hpp"
+#include "pruning.hpp"
+#include "query.hpp"
+#include "bench.hpp"
+
+const int QUERIES = 200000; /**< Points per batch. */
+const int TICKS = 10; /**< Batches timed per query set. */
+const int REPEATS = 5; /**< Interleaved repetitions of the timings (the fastest is kept). */
+const int CLUSTERS = 64; /**< Clusters of the coherent set. */
+const float CLUSTER_RADIUS = 0.05f; /**< Cluster half size. */
+
+/**
+ * @brief Points in small clusters around random centers.
+ *
+ * @param [in] aabb Box of the centers.
+ * @param [in] count Number of points.
+ * @param [in] seed Random seed.
+ * @param [out] points Generated points, cluster by cluster.
+ */
+void getClusteredPoints(const AABB& aabb, int count, unsigned int seed, std::vector<vec3>& points){
+    std::vector<vec3> centers;
+    getRandomPoints(aabb, CLUSTERS, seed, centers);
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<float> offset(-CLUSTER_RADIUS, CLUSTER_RADIUS);
+    points.resize(count);
+    for (int i = 0; i < count; i++) {
+        points[i] = centers[i * CLUSTERS / count] + vec3{offset(rng), offset(rng), offset(rng)};
+    }
+}
+
+/**
+ * @brief Time the queries of one point set.
+ *
+ * @param [in] name Set name.
+ * @param [in] scene Scene to query.
+ * @param [in] grid Pruning grid.
+ * @param [in,out] query Batched query state of the grid.
+ * @param [in] points Query positions.
+ */
+void runSet(const char* name, const Scene& scene, const PruningGrid& grid, SdfQuery& query,
+            const std::vector<vec3>& points){
+    int size = scene.nodes.size();
+    std::vector<float> reference(points.size()), values(points.size());
+    std::vector<vec3> grads(points.size());
+
+    double full = timeMs([&]{
+        for (size_t i = 0; i < points.size(); i++) reference[i] = sdf(points[i], scene, scene.nodes.data(), size);
+    });
+    // Rodadas intercaladas: uma fase lenta da máquina atinge os três igualmente
+    double loop = 1e300, batch = 1e300, gradient = 1e300;
+    for (int r = 0; r < REPEATS; r++) {
+        loop = std::min(loop, timeMs([&]{
+            for (int t = 0; t < TICKS; t++) {
+                for (size_t i = 0; i < points.size(); i++) {
+                    reference[i] = insideGrid(points[i], grid) ? sdfGrid(points[i], scene, grid) : sdfQueryFull(query, points[i]);
+                }
+            }
+        }) / TICKS);
+        batch = std::min(batch, timeMs([&]{
+            for (int t = 0; t < TICKS; t++) distances(query, points, values);
+        }) / TICKS);
+        gradient = std::min(gradient, timeMs([&]{
+            for (int t = 0; t < TICKS; t++) gradients(query, points, grads);
+        }) / TICKS);
+    }
+
+    float error = 0.0f;
+    for (size_t i = 0; i < points.size(); i++) error = std::max(error, std::fabs(values[i] - reference[i]));
+
+    // Gradientes perto da superfície devem ter norma perto de 1 (menos nas arestas e nos smooth)
+    float normError = 0.0f;
+    int nearSurface = 0;
+    for (size_t i = 0; i < points.size(); i++) {
+        if (std::fabs(values[i]) >= 0.05f) continue;
+        normError += std::fabs(length(grads[i]) - 1.0f);
+        nearSurface++;
+    }
+
+    double millions = points.size() / 1000.0;
+    std::printf("  %-9s | full tree %6.2f Mq/s | sdfGrid loop %6.2f Mq/s | distances %6.2f Mq/s | "
+                "gradients %6.2f Mq/s | max diff %g | mean gradient norm error %.4f\n", name,
+                millions / full, millions / loop, millions / batch, millions / gradient, error, normError / nearSurface);
+}
+
+/**
+ * @brief Compare the query sets on one scene.
+ *
+ * @param [in] name Scene name.
+ * @param [in] scene Scene to query.
+ * @param [in] limits Scene limits.
+ * @param [in] gridLevel Number of pruning levels.
+ */
+void runScene(const char* name, const Scene& scene, const AABB& limits, int gridLevel){
+    int size = scene.nodes.size();
+    std::vector<NodeBound> nodeBounds(size);
+    computeNodeBounds(scene, scene.nodes.data(), size, nodeBounds.data());
+    AABB aabb;
+    getSceneAABB(nodeBounds[size - 1], limits, 0.01f, aabb);
+
+    PruningGrid grid;
+    buildPruningGrid(scene, aabb, gridLevel, true, grid);
+
+    SdfQuery query;
+    initSdfQuery(query, scene, grid, 0, QUERIES);
+    std::printf("%s: %d threads, %d queries per batch\n", name, (int)query.pool.threads.size() + 1, QUERIES);
+
+    std::vector<vec3> points;
+    getRandomPoints(aabb, QUERIES, 42, points);
+    runSet("random", scene, grid, query, points);
+    getClusteredPoints(aabb, QUERIES, 42, points);
+    runSet("clustered", scene, grid, query, points);
+
+    freeSdfQuery(query);
+}
+
+int main(){
+    Scene scene;
+    AABB limits;
+    getScenePost(scene);
+    getAABB(limits);
+    runScene("ufabc", scene, limits, 3);
+
+    getSceneRings(scene, 64, 1234, limits);
+    runScene("rings64", scene, limits, 3);
+    return 0;
+}
@@ -0,0 +1,140 @@
+/**
+ * @file raycast.cpp
+ * @brief Benchmark of the batched ray casts.
+ *
+ * Compare raycast() (raycast.hpp) with a loop of raycastRay() for the coherent rays of a
+ * camera image and for incoherent rays with random origins and directions. The loop is also
+ * timed ray by ray for the latency percentiles, and the hits of both must match. The batch
+ * marches its rays together, so it has no latency of its own: the percentiles are the ones
+ * of the loop.
+ *
+ * @author Edson Martinelli
+ * @date 2026
+ */
+
+#include <cstdio>
+#include <cmath>
+#include <chrono>
+#include <random>
+#include <vector>
+#include <algorithm>
+#include "shape.hpp"
+#include "bounds.hpp"
+#include "pruning.hpp"
+#include "query.hpp"
+#include "raycast.hpp"
+#include "bench.hpp"
+
+const int WIDTH = 400; /**< Image width. */
+const int HEIGHT = 300; /**< Image height. */
+const float D = 32.0f; /**< Maximun ray distance. */
+const int MAX_STEP = 256; /**< Maximun ray steps. */
+
+/**
+ * @brief Value at a percentile of sorted values.
+ *
+ * @param [in] values Sorted values.
+ * @param [in] percentile Percentile in [0, 100].
+ * @return The value.
+ */
+template <typename T>
+T getPercentile(const std::vector<T>& values, double percentile){
+    return values[std::min(values.size() - 1, (size_t)(percentile / 100.0 * values.size()))];
+}
+
+/**
+ * @brief Time the casts of one ray set.
+ *
+ * @param [in] name Set name.
+ * @param [in] scene Scene to cast.
+ * @param [in] grid Pruning grid.
+ * @param [in,out] query Query state of the grid.
+ * @param [in] rays Rays to cast.
+ */
+void runSet(const char* name, const Scene& scene, const PruningGrid& grid, SdfQuery& query,
+            const std::vector<Ray>& rays){
+    std::vector<Hit> reference(rays.size()), hits(rays.size());
+    std::vector<double> latency(rays.size());
+    std::vector<int> steps(rays.size());
+
+    double loop = timeMs([&]{
+        for (size_t i = 0; i < rays.size(); i++) reference[i] = raycastRay(rays[i], scene, grid, D, MAX_STEP);
+    });
+    for (size_t i = 0; i < rays.size(); i++) {
+        auto begin = std::chrono::steady_clock::now();
+        reference[i] = raycastRay(rays[i], scene, grid, D, MAX_STEP);
+        latency[i] = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - begin).count();
+        steps[i] = reference[i].steps;
+    }
+    double batch = timeMs([&]{ raycast(query, rays, hits, D, MAX_STEP); });
+
+    int mismatches = 0;
+    int hitCount = 0;
+    for (size_t i = 0; i < rays.size(); i++) {
+        hitCount += hits[i].hit;
+        if (hits[i].hit != reference[i].hit || std::fabs(hits[i].distance - reference[i].distance) > 1e-5f) mismatches++;
+    }
+
+    std::sort(latency.begin(), latency.end());
+    std::sort(steps.begin(), steps.end());
+    double millions = rays.size() / 1000.0;
+    std::printf("  %-10s | loop %6.2f Mrays/s | batch %6.2f Mrays/s | loop latency p50 %6.2f p90 %6.2f p99 %7.2f us | "
+                "steps p50 %3d p90 %3d p99 %3d | %d hits, %d mismatches\n", name, millions / loop, millions / batch,
+                getPercentile(latency, 50), getPercentile(latency, 90), getPercentile(latency, 99),
+                getPercentile(steps, 50), getPercentile(steps, 90), getPercentile(steps, 99), hitCount, mismatches);
+}
+
+/**
+ * @brief Compare the ray sets on one scene.
+ *
+ * @param [in] name Scene name.
+ * @param [in] scene Scene to cast.
+ * @param [in] limits Scene limits.
+ * @param [in] gridLevel Number of pruning levels.
+ * @param [in] origin Camera origin.
+ */
+void runScene(const char* name, const Scene& scene, const AABB& limits, int gridLevel, vec3 origin){
+    int size = scene.nodes.size();
+    std::vector<NodeBound> nodeBounds(size);
+    computeNodeBounds(scene, scene.nodes.data(), size, nodeBounds.data());
+    AABB aabb;
+    getSceneAABB(nodeBounds[size - 1], limits, 0.01f, aabb);
+
+    PruningGrid grid;
+    buildPruningGrid(scene, aabb, gridLevel, true, grid);
+
+    SdfQuery query;
+    initSdfQuery(query, scene, grid, 0, WIDTH * HEIGHT);
+    std::printf("%s: %d threads, %d rays per batch\n", name, (int)query.pool.threads.size() + 1, WIDTH * HEIGHT);
+
+    std::vector<Ray> rays(WIDTH * HEIGHT);
+    for (int y = 0; y < HEIGHT; y++)
+    for (int x = 0; x < WIDTH; x++) {
+        rays[y * WIDTH + x] = {origin, getDirection(x, y, WIDTH, HEIGHT, origin, {0.0f, 0.0f, 0.0f})};
+    }
+    runSet("coherent", scene, grid, query, rays);
+
+    // Origens e direções aleatórias
+    std::vector<vec3> origins;
+    getRandomPoints(aabb, rays.size(), 42, origins);
+    std::mt19937 rng(7);
+    std::normal_distribution<float> normal;
+    for (size_t i = 0; i < rays.size(); i++) {
+        rays[i] = {origins[i], normalize(vec3{normal(rng), normal(rng), normal(rng)})};
+    }
+    runSet("incoherent", scene, grid, query, rays);
+
+    freeSdfQuery(query);
+}
+
+int main(){
+    Scene scene;
+    AABB limits;
+    getScenePost(scene);
+    getAABB(limits);
+    runScene("ufabc", scene, limits, 3, {1.0f, 0.0f, 1.999f});
+
+    getSceneRings(scene, 64, 1234, limits);
+    runScene("rings64", scene, limits, 3, {0.0f, 4.0f, 1.99f});
+    return 0;
+}
@@ -0,0 +1,96 @@
+/**
+ * @file render.cpp
+ * @brief Benchmark of the CPU renderer and its work counters.
+ *
+ * Render each scene with pruning grids of 2 and 3 levels, bounded by the cell center and by
+ * intervals, and compare the settings by time and by the work counters (steps, sdf calls,
+ * nodes and primitives per pixel). Writes the image and the counters of each setting to the
+ * build folder; the counters have the format of main.cpp --counters, so the GPU and the CPU
+ * can be compared on the same image size. The renders with counters are traced to
+ * build/render_trace.json (one zone per image and per tile, on the thread that ran it).
+ *
+ * Usage: ./bench.sh render [width height]
+ *
+ * @author Edson Martinelli
+ * @date 2026
+ */
+
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+#include "shape.hpp"
+#include "bounds.hpp"
+#include "pruning.hpp"
+#include "render.hpp"
+#include "counters.hpp"
+#include "trace.hpp"
+#include "bench.hpp"
+
+/**
+ * @brief Render one scene with each pruning setting.
+ *
+ * @param [in] name Scene name.
+ * @param [in] scene Scene to render.
+ * @param [in] limits Scene limits.
+ * @param [in] camera Camera.
+ * @param [in] width Image width.
+ * @param [in] height Image height.
+ * @param [in,out] trace Timeline of the renders with counters.
+ */
+void runScene(const char* name, const Scene& scene, const AABB& limits, const Camera& camera, int width, int height,
+              Trace& trace){
+    int size = scene.nodes.size();
+    std::vector<NodeBound> nodeBounds(size);
+    computeNodeBounds(scene, scene.nodes.data(), size, nodeBounds.data());
+    AABB aabb;
+    getSceneAABB(nodeBounds[size - 1], limits, 0.01f, aabb);
+
+    for (int gridLevel : {2, 3})
+    for (bool intervals : {false, true}) {
+        PruningGrid grid;
+        buildPruningGrid(scene, aabb, gridLevel, true, grid, intervals);
+
+        Renderer renderer;
+        initRenderer(renderer, scene, grid);
+        std::vector<vec3> colors;
+        std::vector<PixelCounters> pixels;
+        double plain = timeMs([&]{ renderImage(renderer, camera, width, height, colors); });
+        renderer.trace = &trace;
+        double counted = timeMs([&]{ renderImage(renderer, camera, width, height, colors, &pixels); });
+        freeRenderer(renderer);
+
+        CounterReport report;
+        report.source = "cpu";
+        report.variant = std::string(intervals ? "intervals" : "farfields") + "_level" + std::to_string(gridLevel);
+        reducePixelCounters(pixels, width, height, report);
+
+        std::printf("%-8s %-16s | %8.1f ms (%8.1f ms with counters) | ", name, report.variant.c_str(), plain, counted);
+        for (int c = 0; c < COUNTER_COUNT; c++) {
+            std::printf("%s %.2f%s", COUNTER_NAMES[c], report.counters[c].mean, c + 1 < COUNTER_COUNT ? ", " : "");
+        }
+        std::printf(" per pixel\n");
+
+        std::string path = std::string("build/render_") + name + "_" + report.variant;
+        writePPM((path + ".ppm").c_str(), width, height, colors);
+        writeCounterReport((path + ".json").c_str(), report);
+    }
+}
+
+int main(int argc, char** argv){
+    int width = argc > 2 ? std::atoi(argv[1]) : 400;
+    int height = argc > 2 ? std::atoi(argv[2]) : 300;
+    Trace trace;
+    startTrace(trace);
+
+    Scene scene;
+    AABB limits;
+    getScenePost(scene);
+    getAABB(limits);
+    runScene("ufabc", scene, limits, {{1.0f, 0.0f, 1.999f}, {0.0f, 0.0f, 0.0f}}, width, height, trace);
+
+    getSceneRings(scene, 64, 1234, limits);
+    runScene("rings64", scene, limits, {{0.0f, 4.0f, 1.99f}, {0.0f, 0.0f, 0.0f}}, width, height, trace);
+    writeTrace("build/render_trace.json", trace);
+    return 0;
+}
@@ -0,0 +1,116 @@
+/**
+ * @file sampler.cpp
+ * @brief Benchmark of the surface sampler.
+ *
+ * Compare sampleSurface() (sampler.hpp) with rejection sampling of the whole grid box (full
+ * tree, keep the points closer than BAND to the surface, then the same projection): rejection
+ * rate, SDF evaluations per sample and throughput. The samples are written as a binary PLY
+ * point cloud in the build directory.
+ *
+ * @author Edson Martinelli
+ * @date 2026
+ */
+
+#include <cstdio>
+#include <cmath>
+#include <random>
+#include <string>
+#include <vector>
+#include "shape.hpp"
+#include "bounds.hpp"
+#include "pruning.hpp"
+#include "sampler.hpp"
+#include "bench.hpp"
+
+const int SAMPLES = 1000000; /**< Samples of the sampler. */
+const int REJECTION_SAMPLES = 20000; /**< Samples of the rejection baseline. */
+const float BAND = 0.01f; /**< Distance to the surface accepted by the rejection baseline. */
+const float SIGMA = 0.005f; /**< Near-surface offset of the written samples. */
+
+/**
+ * @brief Rejection sampling of the grid box.
+ *
+ * @param [in] scene Scene to sample.
+ * @param [in] grid Pruning grid.
+ * @param [in] count Number of samples.
+ * @param [out] samples Samples and counters.
+ */
+void sampleRejection(const Scene& scene, const PruningGrid& grid, int count, SurfaceSamples& samples){
+    std::mt19937 rng(42);
+    std::uniform_real_distribution<float> x(grid.aabb.minimum.x, grid.aabb.maximum.x);
+    std::uniform_real_distribution<float> y(grid.aabb.minimum.y, grid.aabb.maximum.y);
+    std::uniform_real_distribution<float> z(grid.aabb.minimum.z, grid.aabb.maximum.z);
+    samples.points.clear();
+    samples.normals.clear();
+    samples.evaluations = 0;
+    samples.rejected = 0;
+    while ((int)samples.points.size() < count) {
+        vec3 p = {x(rng), y(rng), z(rng)};
+        samples.evaluations++;
+        vec3 normal;
+        if (std::fabs(sdf(p, scene, scene.nodes.data(), scene.nodes.size())) >= BAND ||
+            !projectToSurface(p, scene, grid, 1e-4f, normal, samples.evaluations)) {
+            samples.rejected++;
+            continue;
+        }
+        samples.points.push_back(p);
+        samples.normals.push_back(normal);
+    }
+}
+
+/**
+ * @brief Compare the samplers on one scene.
+ *
+ * @param [in] name Scene name.
+ * @param [in] scene Scene to sample.
+ * @param [in] limits Scene limits.
+ * @param [in] gridLevel Number of pruning levels.
+ */
+void runScene(const char* name, const Scene& scene, const AABB& limits, int gridLevel){
+    int size = scene.nodes.size();
+    std::vector<NodeBound> nodeBounds(size);
+    computeNodeBounds(scene, scene.nodes.data(), size, nodeBounds.data());
+    AABB aabb;
+    getSceneAABB(nodeBounds[size - 1], limits, 0.01f, aabb);
+
+    PruningGrid grid;
+    buildPruningGrid(scene, aabb, gridLevel, true, grid);
+    std::printf("%s:\n", name);
+
+    SurfaceSamples samples;
+    double rejection = timeMs([&]{ sampleRejection(scene, grid, REJECTION_SAMPLES, samples); });
+    std::printf("  rejection | %5.1f%% rejected | %8.1f evaluations/sample | %7.3f Msamples/s\n",
+                100.0 * samples.rejected / (samples.rejected + samples.points.size()),
+                (double)samples.evaluations / samples.points.size(), REJECTION_SAMPLES / 1000.0 / rejection);
+
+    double time = timeMs([&]{ sampleSurface(scene, grid, SAMPLES, SIGMA, 42, samples); });
+    std::printf("  cells     | %5.1f%% rejected | %8.1f evaluations/sample | %7.3f Msamples/s\n",
+                100.0 * samples.rejected / (samples.rejected + samples.points.size()),
+                (double)samples.evaluations / samples.points.size(), samples.points.size() / 1000.0 / time);
+    if ((int)samples.points.size() < SAMPLES) std::printf("  %d samples out of attempts\n", SAMPLES - (int)samples.points.size());
+
+    // Distância real das amostras deslocadas
+    float error = 0.0f, maxError = 0.0f;
+    int kept = samples.points.size();
+    for (int i = 0; i < kept; i += 100) {
+        float e = std::fabs(sdf(samples.points[i], scene, scene.nodes.data(), size) - samples.distances[i]);
+        error += e;
+        maxError = std::max(maxError, e);
+    }
+    std::printf("  distance error mean %.6f, max %.5f (offset sigma %.3f)\n", error / ((kept + 99) / 100), maxError, SIGMA);
+
+    std::string path = std::string("build/") + name + "_samples.ply";
+    if (!writeSamplesPLY(path.c_str(), samples)) std::printf("  failed to write %s\n", path.c_str());
+}
+
+int main(){
+    Scene scene;
+    AABB limits;
+    getScenePost(scene);
+    getAABB(limits);
+    runScene("ufabc", scene, limits, 3);
+
+    getSceneRings(scene, 64, 1234, limits);
+    runScene("rings64", scene, limits, 3);
+    return 0;
+}
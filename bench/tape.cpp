@@ -0,0 +1,99 @@
+/**
+ * @file tape.cpp
+ * @brief Benchmark of the per-cell instruction tapes.
+ *
+ * Compile the pruned cell trees to tapes and compare instructions against nodes and the
+ * evaluation time of random samples inside non-empty cells.
+ *
+ * @author Edson Martinelli
+ * @date 2026
+ */
+
+#include <cstdio>
+#include <cmath>
+#include <vector>
+#include "shape.hpp"
+#include "bounds.hpp"
+#include "pruning.hpp"
+#include "tape.hpp"
+#include "bench.hpp"
+
+const int QUERIES = 1000000; /**< Random samples per scene. */
+
+/**
+ * @brief Compare node trees and tapes on one scene.
+ *
+ * @param [in] name Scene name.
+ * @param [in] scene Scene to prune.
+ * @param [in] limits Scene limits.
+ * @param [in] gridLevel Number of pruning levels.
+ */
+void runScene(const char* name, const Scene& scene, const AABB& limits, int gridLevel){
+    int size = scene.nodes.size();
+    std::vector<NodeBound> nodeBounds(size);
+    computeNodeBounds(scene, scene.nodes.data(), size, nodeBounds.data());
+    AABB aabb;
+    getSceneAABB(nodeBounds[size - 1], limits, 0.01f, aabb);
+
+    PruningGrid grid;
+    buildPruningGrid(scene, aabb, gridLevel, true, grid);
+
+    std::vector<CellInfo> tapeCells;
+    std::vector<Instruction> tape;
+    double compile = timeMs([&]{ compileGridTapes(scene, grid.cells, grid.nodes, tapeCells, tape); });
+
+    std::vector<vec3> points;
+    std::vector<int> cells;
+    getRandomPoints(aabb, QUERIES, 42, points);
+    for (const vec3& p : points) {
+        int cellIndex = getGridCellIndex(p, grid);
+        if (grid.cells[cellIndex].size > 0) cells.push_back(cellIndex);
+    }
+    int samples = cells.size();
+
+    std::vector<float> treeValues(samples), tapeValues(samples);
+    long treeNodes = 0, tapeInstructions = 0;
+    double treeTime = timeMs([&]{
+        for (int i = 0, j = 0; i < QUERIES; i++) {
+            int cellIndex = getGridCellIndex(points[i], grid);
+            const CellInfo& cell = grid.cells[cellIndex];
+            if (cell.size == 0) continue;
+            treeValues[j++] = sdf(points[i], scene, grid.nodes.data() + cell.offset, cell.size);
+            treeNodes += cell.size;
+        }
+    });
+    double tapeTime = timeMs([&]{
+        for (int i = 0, j = 0; i < QUERIES; i++) {
+            int cellIndex = getGridCellIndex(points[i], grid);
+            const CellInfo& cell = tapeCells[cellIndex];
+            if (cell.size == 0) continue;
+            tapeValues[j++] = evalTape(points[i], scene, tape.data() + cell.offset, cell.size);
+            tapeInstructions += cell.size;
+        }
+    });
+
+    int mismatches = 0;
+    for (int i = 0; i < samples; i++) {
+        if (std::fabs(treeValues[i] - tapeValues[i]) > 1e-6f) mismatches++;
+    }
+
+    std::printf("%-8s | nodes %8zu, instructions %8zu (compile %6.1f ms) | per sample: tree %5.2f nodes %6.1f ns, "
+                "tape %5.2f instructions %6.1f ns | %d samples, %d err\n",
+                name, grid.nodes.size(), tape.size(), compile,
+                (double)treeNodes / samples, treeTime * 1e6 / samples,
+                (double)tapeInstructions / samples, tapeTime * 1e6 / samples, samples, mismatches);
+}
+
+int main(){
+    Scene scene;
+    AABB limits;
+    getScenePost(scene);
+    getAABB(limits);
+    runScene("ufabc", scene, limits, 2);
+    runScene("ufabc", scene, limits, 3);
+
+    getSceneRings(scene, 64, 1234, limits);
+    runScene("rings64", scene, limits, 2);
+    runScene("rings64", scene, limits, 3);
+    return 0;
+}
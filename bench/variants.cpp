@@ -0,0 +1,318 @@
+/**
+ * @file variants.cpp
+ * @brief Matrix of the fragment shader variants rendered offscreen and compared.
+ *
+ * Each variant is a build of main.cpp (a gpubench.sh variant, which sets up the buffers its
+ * shader reads) and optionally a fragment shader rendered over those buffers (--shader of
+ * main.cpp), so the shaders outside main.cpp run without editing createShader(). Every variant
+ * runs in benchmark mode on a headless EGL context (HEADLESS=1 of gpubench.sh, no display needed;
+ * --window uses a hidden GLFW window instead), with LIBGL_ALWAYS_SOFTWARE=1 by default so Mesa
+ * renders on the CPU (llvmpipe) and no GPU is needed, and writes its timing report, one more
+ * frame as image and, for the marcher with counters, its pixel counters to build/variants.
+ *
+ * The camera of each shader is fixed in its source (the orbit of iTimer is commented out), so
+ * each variant is compared at its own camera: the UFABC shaders colored by the normal against
+ * the CPU renderer of render.hpp at that camera, the Phong shaders against the shader that is
+ * their reference (the 26 points normal, the render without bounding volumes or over-relaxation),
+ * and the step count shaders are only timed. A variant fails when its run fails or when more
+ * pixels than allowed differ from the reference by more than the channel tolerance.
+ *
+ * Usage: ./bench.sh variants [--width N] [--height N] [--grid-level N] [--duration S] [--filter TEXT]
+ *        [--hardware] [--window] [--gpubench CMD]
+ *
+ * @author Edson Martinelli
+ * @date 2026
+ */
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include "shape.hpp"
+#include "bounds.hpp"
+#include "pruning.hpp"
+#include "render.hpp"
+#include "image.hpp"
+#include "bench.hpp"
+
+const int CHANNEL_TOLERANCE = 8; /**< Channel difference that still counts as equal. */
+const double MAX_DIFFERENT = 0.01; /**< Default fraction of different pixels that still passes. */
+const char* const OUTPUT = "build/variants"; /**< Folder of the reports and images. */
+
+/**
+ * @brief Reference of a variant image.
+ */
+enum ReferenceType{
+    REFERENCE_NONE, /**< Only timed. */
+    REFERENCE_GRID, /**< CPU renderer bounded by the grid, at the camera of the pruning shaders. */
+    REFERENCE_TREE, /**< CPU renderer with the whole tree outside the grid, at the camera of the full tree shaders. */
+    REFERENCE_VARIANT /**< Image of another variant. */
+};
+
+/**
+ * @brief Entry of the matrix.
+ */
+struct Variant{
+    const char* name; /**< Variant name. */
+    const char* build; /**< gpubench.sh variant that sets up the buffers. */
+    const char* shader; /**< Fragment shader, null for the one of the build. */
+    ReferenceType reference; /**< Reference of the image. */
+    const char* referenceVariant; /**< Variant of a REFERENCE_VARIANT, run before this one. */
+    bool counters; /**< The shader writes the pixel counters. */
+    double maxDifferent = MAX_DIFFERENT; /**< Fraction of different pixels that still passes. */
+};
+
+/**
+ * @brief Result of a variant.
+ */
+struct VariantResult{
+    bool selected = false; /**< The variant passed the filter. */
+    bool ran = false; /**< The run wrote its report and image. */
+    int frames = 0; /**< Measured frames. */
+    double frameMs = 0.0; /**< Mean frame time. */
+    double shaderMs = 0.0; /**< Mean time of the march pass. */
+    double steps = -1.0; /**< Mean steps per pixel from the counters, -1 without them. */
+    double referenceSteps = -1.0; /**< Mean steps per pixel of the CPU reference, -1 without it. */
+    bool compared = false; /**< The image was compared with its reference. */
+    ImageDiff diff; /**< Difference to the reference. */
+};
+
+/**
+ * @brief The shader variants.
+ *
+ * @param [out] variants Matrix, references before the variants that use them.
+ */
+void getVariants(std::vector<Variant>& variants){
+    variants = {
+        // Variantes do main.cpp, cada uma com o seu shader
+        {"full", "full", nullptr, REFERENCE_TREE, nullptr, false},
+        {"pruning", "pruning", nullptr, REFERENCE_GRID, nullptr, true},
+        {"farfields", "farfields", nullptr, REFERENCE_GRID, nullptr, true},
+        {"intervals", "intervals", nullptr, REFERENCE_GRID, nullptr, true},
+        {"nary", "nary", nullptr, REFERENCE_GRID, nullptr, true},
+        {"tape", "tape", nullptr, REFERENCE_GRID, nullptr, false},
+        {"bricks", "bricks", nullptr, REFERENCE_GRID, nullptr, false},
+        {"quantized8", "quantized8", nullptr, REFERENCE_GRID, nullptr, false},
+        {"quantized16", "quantized16", nullptr, REFERENCE_GRID, nullptr, false},
+        {"corners", "corners", nullptr, REFERENCE_GRID, nullptr, false},
+        // Pruning sem far-fields e árvore inteira, com e sem SSBO
+        {"tree_pruning", "pruning", "src/shaders/lipschitzPruning/full3DTreePruning.frag", REFERENCE_GRID, nullptr, false},
+        {"tree_lazy", "full", "src/shaders/lipschitzPruning/full3DTreeLazy.frag", REFERENCE_TREE, nullptr, false},
+        {"tree_without_ssbo", "full", "src/shaders/lipschitzPruning/full3DTreeWithoutSSBO.frag", REFERENCE_TREE, nullptr, false},
+        {"full3d", "full", "src/shaders/lipschitzPruning/full3D.frag", REFERENCE_TREE, nullptr, false},
+        {"prototype_normal", "full", "src/shaders/prototypes/normal.frag", REFERENCE_TREE, nullptr, false},
+        // Phong: volumes envolventes e over-relaxation contra o render sem eles
+        {"phong_hard_shadow", "full", "src/shaders/prototypes/phongHardShadow.frag", REFERENCE_NONE, nullptr, false},
+        {"bounding_fixed", "full", "src/shaders/boundingVolumes/fixedStep.frag", REFERENCE_VARIANT, "phong_hard_shadow", false},
+        {"bounding_dynamic", "full", "src/shaders/boundingVolumes/dynamicStep.frag", REFERENCE_VARIANT, "phong_hard_shadow", false},
+        {"relax_original", "full", "src/shaders/overRelaxation/originalFallback.frag", REFERENCE_VARIANT, "phong_hard_shadow", false},
+        {"relax_optimized", "full", "src/shaders/overRelaxation/optimizedFallback.frag", REFERENCE_VARIANT, "phong_hard_shadow", false},
+        {"relax_bounding", "full", "src/shaders/overRelaxBoundingVolumes/relaxBoundingVolumes.frag", REFERENCE_VARIANT, "phong_hard_shadow", false},
+        // Normais: 4, 6 e 18 pontos contra 26 pontos
+        {"phong26", "full", "src/shaders/normal/phong26Points.frag", REFERENCE_NONE, nullptr, false},
+        {"phong18", "full", "src/shaders/normal/phong18Points.frag", REFERENCE_VARIANT, "phong26", false},
+        {"phong6", "full", "src/shaders/normal/phong6Points.frag", REFERENCE_VARIANT, "phong26", false},
+        {"phong4", "full", "src/shaders/normal/phong4Points.frag", REFERENCE_VARIANT, "phong26", false},
+        {"phong", "full", "src/shaders/prototypes/phong.frag", REFERENCE_NONE, nullptr, false},
+        {"color", "full", "src/shaders/prototypes/color.frag", REFERENCE_NONE, nullptr, false},
+        // Contagem de passos em cor, só tempo
+        {"steps_bounding", "full", "src/shaders/overRelaxBoundingVolumes/stepCountBounding.frag", REFERENCE_NONE, nullptr, false},
+        {"steps_relax_bounding", "full", "src/shaders/overRelaxBoundingVolumes/stepCountRelaxBounding.frag", REFERENCE_NONE, nullptr, false},
+    };
+}
+
+/**
+ * @brief Read the frame and shader times of a CSV report of main.cpp.
+ *
+ * @param [in] path Report with one row.
+ * @param [out] result Frames, frame time and shader time.
+ * @return False if the report does not exist or has no row.
+ */
+bool readReport(const char* path, VariantResult& result){
+    FILE* file = std::fopen(path, "r");
+    if (file == nullptr) return false;
+    char header[1024], row[1024];
+    bool valid = std::fgets(header, sizeof(header), file) != nullptr && std::fgets(row, sizeof(row), file) != nullptr;
+    std::fclose(file);
+    if (!valid) return false;
+
+    // Colunas: variant, ..., frames (9), frame_mean_ms (10), ..., shader_mean_ms (15)
+    std::vector<std::string> columns;
+    for (char* token = std::strtok(row, ",\n"); token != nullptr; token = std::strtok(nullptr, ",\n")) columns.push_back(token);
+    if (columns.size() < 15) return false;
+    result.frames = std::atoi(columns[8].c_str());
+    result.frameMs = std::atof(columns[9].c_str());
+    result.shaderMs = std::atof(columns[14].c_str());
+    return true;
+}
+
+/**
+ * @brief Read the mean steps per pixel of a counters report of main.cpp.
+ *
+ * @param [in] path Counters report (.json).
+ * @return Mean steps, -1 if the report does not exist.
+ */
+double readStepsMean(const char* path){
+    FILE* file = std::fopen(path, "r");
+    if (file == nullptr) return -1.0;
+    std::string text;
+    char buffer[4096];
+    size_t count;
+    while ((count = std::fread(buffer, 1, sizeof(buffer), file)) > 0) text.append(buffer, count);
+    std::fclose(file);
+
+    size_t steps = text.find("\"steps\"");
+    size_t mean = steps == std::string::npos ? steps : text.find("\"mean\":", steps);
+    return mean == std::string::npos ? -1.0 : std::atof(text.c_str() + mean + 7);
+}
+
+/**
+ * @brief Format a value of the table.
+ *
+ * @param [in] value Value, negative when missing.
+ * @return The value with two decimals, or "-" when missing.
+ */
+std::string formatValue(double value){
+    if (value < 0.0) return "-";
+    char text[32];
+    std::snprintf(text, sizeof(text), "%.2f", value);
+    return text;
+}
+
+int main(int argc, char** argv){
+    int width = 160;
+    int height = 120;
+    int gridLevel = 3;
+    double duration = 5.0;
+    bool software = true;
+    bool headless = true;
+    std::string filter;
+    std::string gpubench = "./gpubench.sh";
+    for (int i = 1; i < argc; i++) {
+        std::string option = argv[i];
+        if (option == "--hardware") software = false;
+        else if (option == "--window") headless = false;
+        else if (option == "--width" && i + 1 < argc) width = std::atoi(argv[++i]);
+        else if (option == "--height" && i + 1 < argc) height = std::atoi(argv[++i]);
+        else if (option == "--grid-level" && i + 1 < argc) gridLevel = std::atoi(argv[++i]);
+        else if (option == "--duration" && i + 1 < argc) duration = std::atof(argv[++i]);
+        else if (option == "--filter" && i + 1 < argc) filter = argv[++i];
+        else if (option == "--gpubench" && i + 1 < argc) gpubench = argv[++i];
+        else {
+            std::fprintf(stderr, "Usage: %s [--width N] [--height N] [--grid-level N] [--duration S] [--filter TEXT]"
+                         " [--hardware] [--window] [--gpubench CMD]\n", argv[0]);
+            return 2;
+        }
+    }
+    std::system((std::string("mkdir -p ") + OUTPUT).c_str());
+
+    // Referências da CPU, uma por câmera
+    Scene scene;
+    AABB limits;
+    getScenePost(scene);
+    getAABB(limits);
+    int size = scene.nodes.size();
+    std::vector<NodeBound> nodeBounds(size);
+    computeNodeBounds(scene, scene.nodes.data(), size, nodeBounds.data());
+    AABB aabb;
+    getSceneAABB(nodeBounds[size - 1], limits, 0.01f, aabb);
+    PruningGrid grid;
+    buildPruningGrid(scene, aabb, gridLevel, true, grid);
+    Renderer renderer;
+    initRenderer(renderer, scene, grid);
+
+    std::vector<Variant> variants;
+    getVariants(variants);
+    std::vector<VariantResult> results(variants.size());
+    Image referenceImages[REFERENCE_VARIANT];
+    double referenceSteps[REFERENCE_VARIANT] = {};
+
+    int failures = 0;
+    std::printf("%-22s %-12s %7s %10s %10s %8s %9s %8s %6s %8s  %s\n", "variant", "build", "frames", "frame ms",
+                "shader ms", "steps", "ref steps", "mean err", "max", "differ", "status");
+    for (size_t v = 0; v < variants.size(); v++) {
+        const Variant& variant = variants[v];
+        VariantResult& result = results[v];
+        if (!filter.empty() && std::string(variant.name).find(filter) == std::string::npos) continue;
+        result.selected = true;
+
+        std::string base = std::string(OUTPUT) + "/" + variant.name;
+        std::remove((base + ".csv").c_str());
+        std::remove((base + ".ppm").c_str());
+        std::remove((base + ".json").c_str());
+        std::string command = std::string(software ? "LIBGL_ALWAYS_SOFTWARE=1 " : "") + (headless ? "HEADLESS=1 " : "") +
+                              gpubench + " " + variant.build +
+                              " --hidden --width " + std::to_string(width) + " --height " + std::to_string(height) +
+                              " --grid-level " + std::to_string(gridLevel) + " --warmup 0.5 --duration " +
+                              std::to_string(duration) + " --min-frames 10 --tolerance 0.05 --output " + base +
+                              ".csv --image " + base + ".ppm";
+        if (variant.shader != nullptr) command += std::string(" --shader ") + variant.shader;
+        if (variant.counters) command += " --counters " + base + ".json";
+        command += " > " + base + ".log 2>&1";
+        std::system(command.c_str());
+
+        Image image;
+        result.ran = readReport((base + ".csv").c_str(), result) && readImage((base + ".ppm").c_str(), image);
+        if (variant.counters) result.steps = readStepsMean((base + ".json").c_str());
+
+        bool cpuReference = variant.reference == REFERENCE_GRID || variant.reference == REFERENCE_TREE;
+        if (result.ran && cpuReference) {
+            Image& reference = referenceImages[variant.reference];
+            if (reference.pixels.empty()) {
+                bool tree = variant.reference == REFERENCE_TREE;
+                Camera camera = {{1.0f, 0.0f, tree ? 2.0f : 1.999f}, {0.0f, 0.0f, 0.0f}};
+                std::vector<vec3> colors;
+                std::vector<PixelCounters> pixels;
+                renderer.bounded = !tree;
+                renderImage(renderer, camera, width, height, colors, &pixels);
+                double steps = 0.0;
+                for (const PixelCounters& pixel : pixels) steps += pixel.steps;
+                referenceSteps[variant.reference] = steps / pixels.size();
+                getImage(width, height, colors, reference);
+                writeImage((std::string(OUTPUT) + (tree ? "/reference_tree.ppm" : "/reference_grid.ppm")).c_str(), reference);
+            }
+            result.referenceSteps = referenceSteps[variant.reference];
+            result.compared = compareImages(image, reference, CHANNEL_TOLERANCE, result.diff);
+        }
+        if (result.ran && variant.reference == REFERENCE_VARIANT) {
+            Image reference;
+            std::string path = std::string(OUTPUT) + "/" + variant.referenceVariant + ".ppm";
+            result.compared = readImage(path.c_str(), reference) && compareImages(image, reference, CHANNEL_TOLERANCE, result.diff);
+        }
+
+        const char* status = !result.ran ? "FAILED (see .log)"
+                           : variant.reference == REFERENCE_NONE ? "timed"
+                           : !result.compared ? "no reference"
+                           : result.diff.differentFraction > variant.maxDifferent ? "DIFFERS" : "ok";
+        failures += !result.ran || (result.compared && result.diff.differentFraction > variant.maxDifferent);
+        std::string reference = variant.reference == REFERENCE_VARIANT ? std::string(" vs ") + variant.referenceVariant
+                              : cpuReference ? " vs cpu" : "";
+        std::printf("%-22s %-12s %7d %10.3f %10.3f %8s %9s %8.3f %6d %7.2f%%  %s%s\n", variant.name, variant.build,
+                    result.frames, result.frameMs, result.shaderMs, formatValue(result.steps).c_str(),
+                    formatValue(result.referenceSteps).c_str(),
+                    result.diff.meanError, result.diff.maxError, result.diff.differentFraction * 100.0, status,
+                    reference.c_str());
+    }
+    freeRenderer(renderer);
+
+    // Tabela completa para comparar execuções
+    std::string tablePath = std::string(OUTPUT) + "/variants.csv";
+    FILE* table = std::fopen(tablePath.c_str(), "w");
+    if (table != nullptr) {
+        std::fprintf(table, "variant,build,shader,ran,frames,frame_mean_ms,shader_mean_ms,steps_mean,reference_steps_mean,"
+                     "mean_error,max_error,different_fraction\n");
+        for (size_t v = 0; v < variants.size(); v++) {
+            const VariantResult& result = results[v];
+            if (!result.selected) continue;
+            std::fprintf(table, "%s,%s,%s,%d,%d,%.6f,%.6f,%.4f,%.4f,%.4f,%d,%.6f\n", variants[v].name, variants[v].build,
+                         variants[v].shader != nullptr ? variants[v].shader : "", result.ran, result.frames,
+                         result.frameMs, result.shaderMs, result.steps, result.referenceSteps, result.diff.meanError,
+                         result.diff.maxError, result.diff.differentFraction);
+        }
+        std::fclose(table);
+    }
+    std::printf("%d variants failed or differ (table %s)\n", failures, tablePath.c_str());
+    return failures > 0 ? 1 : 0;
+}
@@ -0,0 +1,39 @@
+#!/bin/bash
+# ./gpubench.sh <variante> [opções do app, ex.: --width 800 --height 600 --grid-level 3 --output build/bench.csv]
+# Recompila só quando o executável da variante é mais antigo que os fontes
+# Com HEADLESS=1 usa o contexto EGL sem janela (USE_HEADLESS_CONTEXT), sem display e sem GLFW
+# Variantes: full, pruning, farfields, intervals, tape, nary, bricks, quantized8, quantized16, corners
+
+DIRECTORY="build"
+FLAGS="-Iinclude -lglfw -lGL -lXrandr -lXxf86vm -lXi -lXinerama -lX11 -lrt -ldl -pthread"
+
+case $1 in
+  full) DEFINES="-DUSE_PRUNING_ALG=0" ;;
+  pruning) DEFINES="-DUSE_FAR_FIELDS_ALG=0" ;;
+  farfields) DEFINES="" ;;
+  intervals) DEFINES="-DUSE_INTERVAL_ALG=1" ;;
+  tape) DEFINES="-DUSE_TAPE_ALG=1" ;;
+  nary) DEFINES="-DUSE_NARY_ALG=1" ;;
+  bricks) DEFINES="-DUSE_BRICK_MAP_ALG=1" ;;
+  quantized8) DEFINES="-DUSE_QUANTIZED_FAR_FIELDS_ALG=8" ;;
+  quantized16) DEFINES="-DUSE_QUANTIZED_FAR_FIELDS_ALG=16" ;;
+  corners) DEFINES="-DUSE_FAR_FIELD_CORNERS_ALG=1" ;;
+  *) echo "Variante desconhecida: $1"; exit 1 ;;
+esac
+
+APP="build/app_$1.o"
+if [ "$HEADLESS" = "1" ]; then
+  DEFINES="$DEFINES -DUSE_HEADLESS_CONTEXT=1"
+  FLAGS="-Iinclude -lEGL -ldl -pthread"
+  APP="build/app_$1_headless.o"
+fi
+
+if [ ! -d "$DIRECTORY" ]; then
+  mkdir $DIRECTORY
+fi
+
+if [ ! -f $APP ] || [ -n "$(find src dep include -newer $APP -print -quit)" ]; then
+  g++ -std=c++20 dep/glad.c dep/shader.cpp src/main.cpp -o $APP $DEFINES $FLAGS || exit 1
+fi
+
+./$APP --benchmark "${@:2}"
@@ -0,0 +1,277 @@
+/**
+ * @file bounds.hpp
+ * @brief Bounds pass over the post-order node tree.
+ *
+ * Compute an axis aligned bounding box for every primitive and every subtree of a
+ * post-order tree, following union, intersection and subtraction semantics. The root box
+ * gives the pruning grid extent and the subtree boxes give bounding volume early-outs
+ * for the evaluators.
+ *
+ * @author Edson Martinelli
+ * @date 2026
+ */
+
+#ifndef BOUNDS_HPP
+#define BOUNDS_HPP
+
+#include <cmath>
+#include <vector>
+#include <algorithm>
+#include "shape.hpp"
+#include "vector.hpp"
+
+const float BOUND_MARGIN = 0.1f; /**< Minimum distance to a subtree box to use the box distance instead of the subtree. */
+
+/**
+ * @brief Bounds of one node of the tree.
+ *
+ * Box of the node value as seen by its parent (sign applied) and the subtrees that can be
+ * replaced by their box distance. Layout matches the std430 NodeBound struct of the shaders.
+ */
+struct NodeBound{
+    vec4 maximum; /**< Box maximum point. */
+    vec4 minimum; /**< Box minimum point. */
+    int skipRoot; /**< Root of the outermost replaceable subtree starting at this node (-1 if none). */
+    int nextSkipRoot; /**< Root of the next inner replaceable subtree with the same start (-1 if none). */
+    int rightRoot; /**< Root of the right operand subtree starting at this node (-1 if none). */
+    int pad0; /**< Padding for alignment. */
+};
+
+/**
+ * @brief Check if a box is finite in every axis.
+ *
+ * @param [in] b Node bound.
+ * @return True if all box coordinates are finite.
+ */
+bool isFiniteBound(const NodeBound& b){
+    return std::isfinite(b.minimum.x) && std::isfinite(b.minimum.y) && std::isfinite(b.minimum.z) &&
+           std::isfinite(b.maximum.x) && std::isfinite(b.maximum.y) && std::isfinite(b.maximum.z);
+}
+
+/**
+ * @brief Distance from a point to a node box.
+ *
+ * Zero inside the box. Lower bound of the distance to anything inside the box.
+ *
+ * @param [in] p 3D space position.
+ * @param [in] b Node bound.
+ * @return Euclidean distance to the box.
+ */
+float distanceAABB(vec3 p, const NodeBound& b){
+    vec3 minimum = {b.minimum.x, b.minimum.y, b.minimum.z};
+    vec3 maximum = {b.maximum.x, b.maximum.y, b.maximum.z};
+    vec3 q = max(max(minimum - p, p - maximum), vec3{0.0f, 0.0f, 0.0f});
+    return length(q);
+}
+
+/**
+ * @brief Box of a primitive solid.
+ *
+ * Box containing the region where the primitive SDF is negative. Half-spaces like the floor
+ * and the plane cutter are unbounded in some axes.
+ *
+ * @param [in] pr Primitive.
+ * @param [out] b Node bound to fill with the box.
+ */
+void getPrimitiveBound(const Primitive& pr, NodeBound& b){
+    const float inf = INFINITY;
+    switch (pr.type) {
+        case PRIMITIVE_CYLINDER:
+            b.minimum = {pr.offsetX - pr.r, pr.offsetY - pr.r, -pr.depth, 0.0f};
+            b.maximum = {pr.offsetX + pr.r, pr.offsetY + pr.r, pr.depth, 0.0f};
+            break;
+        case PRIMITIVE_BOX: {
+            vec2 origin = {pr.sideCenterX, pr.sideCenterY};
+            vec2 end = {pr.xEnd, pr.m * (pr.xEnd - origin.x) + origin.y};
+            vec2 d = (end - origin) / length(end - origin);
+            float ex = pr.th * std::fabs(d.y);
+            float ey = pr.th * std::fabs(d.x);
+            b.minimum = {std::min(origin.x, end.x) - ex, std::min(origin.y, end.y) - ey, -pr.depth, 0.0f};
+            b.maximum = {std::max(origin.x, end.x) + ex, std::max(origin.y, end.y) + ey, pr.depth, 0.0f};
+            break;
+        }
+        case PRIMITIVE_PLANE_CUTTER:
+            // x + 0.82 + 0.09 * sin(...) < 0, extruded by 0.51
+            b.minimum = {-inf, -inf, -0.51f, 0.0f};
+            b.maximum = {-0.82f + 0.09f, inf, 0.51f, 0.0f};
+            break;
+        case PRIMITIVE_FLOOR:
+            b.minimum = {-inf, -inf, -inf, 0.0f};
+            b.maximum = {inf, -1.0f, inf, 0.0f};
+            break;
+        default:
+            b.minimum = {inf, inf, inf, 0.0f};
+            b.maximum = {-inf, -inf, -inf, 0.0f};
+            break;
+    }
+}
+
+/**
+ * @brief First node of each subtree.
+ *
+ * In post-order the subtree of node i is the contiguous range [start[i], i]. The children of
+ * an n-ary node are the values on top of the stack whose parent is the node.
+ *
+ * @param [in] nodes Post-order node array.
+ * @param [in] size Number of nodes.
+ * @param [out] start First node of the subtree of each node.
+ */
+void getSubtreeStarts(const Node* nodes, int size, std::vector<int>& start){
+    std::vector<int> stack;
+    stack.reserve(size);
+    start.resize(size);
+
+    for (int i = 0; i < size; i++) {
+        if (nodes[i].type == NODE_BINARY) {
+            stack.pop_back();
+            start[i] = start[stack.back()];
+            stack.pop_back();
+        } else if (nodes[i].type == NODE_NARY) {
+            start[i] = i;
+            while (!stack.empty() && nodes[stack.back()].parent == i) {
+                start[i] = start[stack.back()];
+                stack.pop_back();
+            }
+        } else {
+            start[i] = i;
+        }
+        stack.push_back(i);
+    }
+}
+
+/**
+ * @brief Children of a node in order.
+ *
+ * @param [in] start First node of each subtree (see getSubtreeStarts).
+ * @param [in] root Node.
+ * @param [out] children Roots of the child subtrees, left to right.
+ */
+void getChildren(const std::vector<int>& start, int root, std::vector<int>& children){
+    children.clear();
+    for (int c = root - 1; c >= start[root]; c = start[c] - 1) {
+        children.push_back(c);
+    }
+    std::reverse(children.begin(), children.end());
+}
+
+/**
+ * @brief Bounds pass over a post-order tree.
+ *
+ * Union (s = 1) takes the box union widened by k/4, the largest offset of the smooth
+ * minimum (once per fold step of an n-ary node). Intersection (s = -1) takes the box intersection, the smooth maximum only
+ * shrinks the solid. A node with sign -1 is a complement and gets an infinite box, so a
+ * subtraction keeps the box of its left operand.
+ *
+ * Subtrees with a finite box whose path to the root only has sign 1 are registered as
+ * replaceable: their value can be swapped by the box distance without breaking the lower
+ * bound of the root value. The operands after the first of every union, and of intersections
+ * on such a path, are also registered at their first node for the lazy evaluation of sdfLazy().
+ *
+ * @param [in] scene Scene with primitives and binary operations.
+ * @param [in] nodes Post-order node array (parents relative to the array start).
+ * @param [in] size Number of nodes.
+ * @param [out] bounds Bound for each node.
+ */
+void computeNodeBounds(const Scene& scene, const Node* nodes, int size, NodeBound* bounds){
+    const float inf = INFINITY;
+    std::vector<int> start;
+    std::vector<int> stack;
+    stack.reserve(size);
+    getSubtreeStarts(nodes, size, start);
+
+    for (int i = 0; i < size; i++) {
+        const Node& node = nodes[i];
+        NodeBound& b = bounds[i];
+        b.skipRoot = -1;
+        b.nextSkipRoot = -1;
+        b.rightRoot = -1;
+        b.pad0 = 0;
+
+        if (node.type == NODE_BINARY || node.type == NODE_NARY) {
+            // Filhos no topo da pilha; n-ário consome todos com parent == i
+            const NodeBound& r = bounds[stack.back()]; stack.pop_back();
+            b = r;
+            int count = 1;
+            while (!stack.empty() && (node.type == NODE_BINARY ? count < 2 : nodes[stack.back()].parent == i)) {
+                const NodeBound& l = bounds[stack.back()]; stack.pop_back();
+                count++;
+                if (scene.binaryOperations[node.index].s == 1) {
+                    b.minimum = {std::min(b.minimum.x, l.minimum.x), std::min(b.minimum.y, l.minimum.y), std::min(b.minimum.z, l.minimum.z), 0.0f};
+                    b.maximum = {std::max(b.maximum.x, l.maximum.x), std::max(b.maximum.y, l.maximum.y), std::max(b.maximum.z, l.maximum.z), 0.0f};
+                } else {
+                    b.minimum = {std::max(b.minimum.x, l.minimum.x), std::max(b.minimum.y, l.minimum.y), std::max(b.minimum.z, l.minimum.z), 0.0f};
+                    b.maximum = {std::min(b.maximum.x, l.maximum.x), std::min(b.maximum.y, l.maximum.y), std::min(b.maximum.z, l.maximum.z), 0.0f};
+                }
+            }
+            b.skipRoot = -1;
+            b.nextSkipRoot = -1;
+            b.rightRoot = -1;
+
+            const BinaryOperation& op = scene.binaryOperations[node.index];
+            if (op.s == 1) {
+                // Cada operação smooth da dobra pode avançar k/4
+                float w = op.k * 0.25f * (count - 1);
+                b.minimum = {b.minimum.x - w, b.minimum.y - w, b.minimum.z - w, 0.0f};
+                b.maximum = {b.maximum.x + w, b.maximum.y + w, b.maximum.z + w, 0.0f};
+            } else if (b.minimum.x > b.maximum.x || b.minimum.y > b.maximum.y || b.minimum.z > b.maximum.z) {
+                b.minimum = {inf, inf, inf, 0.0f};
+                b.maximum = {-inf, -inf, -inf, 0.0f};
+            }
+        } else {
+            getPrimitiveBound(scene.primitives[node.index], b);
+        }
+
+        if (node.sign < 0) {
+            b.minimum = {-inf, -inf, -inf, 0.0f};
+            b.maximum = {inf, inf, inf, 0.0f};
+        }
+        stack.push_back(i);
+    }
+
+    std::vector<bool> positivePath(size);
+    for (int i = size - 1; i >= 0; i--) {
+        int parent = nodes[i].parent;
+        positivePath[i] = nodes[i].sign > 0 && (parent < 0 || positivePath[parent]);
+    }
+
+    std::vector<int> children;
+    for (int i = 0; i < size; i++) {
+        if (nodes[i].type == NODE_PRIMITIVE) continue;
+        if (positivePath[i] && isFiniteBound(bounds[i])) {
+            bounds[i].nextSkipRoot = bounds[start[i]].skipRoot;
+            bounds[start[i]].skipRoot = i;
+        }
+        if (scene.binaryOperations[nodes[i].index].s == 1 || positivePath[i]) {
+            getChildren(start, i, children);
+            for (int c = 1; c < (int)children.size(); c++) {
+                bounds[start[children[c]]].rightRoot = children[c];
+            }
+        }
+    }
+}
+
+/**
+ * @brief Pruning grid extent from the root bound.
+ *
+ * Root box widened by a margin and clipped to the scene limits. Axes where the root is
+ * unbounded (floor) keep the limits.
+ *
+ * @param [in] root Bound of the root node.
+ * @param [in] limits Scene limits (see getAABB).
+ * @param [in] margin Extra space around the root box.
+ * @param [out] aabb Grid extent.
+ */
+void getSceneAABB(const NodeBound& root, const AABB& limits, float margin, AABB& aabb){
+    aabb.minimum = {std::max(limits.minimum.x, root.minimum.x - margin),
+                    std::max(limits.minimum.y, root.minimum.y - margin),
+                    std::max(limits.minimum.z, root.minimum.z - margin), 0.0f};
+    aabb.maximum = {std::min(limits.maximum.x, root.maximum.x + margin),
+                    std::min(limits.maximum.y, root.maximum.y + margin),
+                    std::min(limits.maximum.z, root.maximum.z + margin), 0.0f};
+
+    if (aabb.minimum.x >= aabb.maximum.x || aabb.minimum.y >= aabb.maximum.y || aabb.minimum.z >= aabb.maximum.z) {
+        aabb = limits;
+    }
+}
+
+#endif
@@ -0,0 +1,233 @@
+/**
+ * @file brickmap.hpp
+ * @brief Baked sparse brick map of the pruned distance field.
+ *
+ * For static scenes the pruned trees are sampled once: each cell with a tree (CellInfo.size > 0)
+ * gets a brick of BRICK_SIZE^3 samples, from corner to corner of the cell, stored in a 3D atlas,
+ * and the far-field cells keep their single value. An indirection grid gives the brick of each
+ * cell (-1 for far-field cells). A march step away from the surface then costs one trilinear
+ * lookup instead of a tree walk; inside the error band of the lookup the cell tree is evaluated,
+ * so the hits are the ones of the pruned trees.
+ *
+ * The bricks include the cell faces, so the trilinear lookup never mixes two bricks and the
+ * GPU filtering of the atlas gives the same value (lipschitzPruning/full3DTreePruningBricks.frag).
+ * On the CPU each brick is contiguous, so the 8 samples of a lookup share a few cache lines;
+ * getBrickAtlas() builds the texture layout for the upload.
+ *
+ * @author Edson Martinelli
+ * @date 2026
+ */
+
+#ifndef BRICKMAP_HPP
+#define BRICKMAP_HPP
+
+#include <cmath>
+#include <vector>
+#include <algorithm>
+#include "shape.hpp"
+#include "vector.hpp"
+#include "evaluator.hpp"
+#include "pruning.hpp"
+
+const int BRICK_SIZE = 8; /**< Samples per axis of one brick. */
+
+/**
+ * @brief Baked distance field.
+ */
+struct BrickMap{
+    AABB aabb; /**< Grid extent. */
+    int subdivisions; /**< Cells per axis. */
+    std::vector<int> bricks; /**< Brick of each cell, -1 for far-field cells. */
+    std::vector<float> farFieldValues; /**< Distance bound of the far-field cells. */
+    int atlasBricks; /**< Bricks per axis of the atlas. */
+    int atlasSize; /**< Samples per axis of the atlas (atlasBricks * BRICK_SIZE). */
+    std::vector<float> samples; /**< BRICK_SIZE^3 samples per brick, x fastest. */
+    float errorBound; /**< Maximum difference between the trilinear lookup and the SDF. */
+};
+
+/**
+ * @brief Interpolation error bound of a brick.
+ *
+ * The trilinear value is a convex combination of the 8 corner samples, and a 1-Lipschitz SDF
+ * differs from each sample by at most the distance to its corner. The weighted distance is at
+ * most sqrt(sum of t(1 - t)h^2 over the axes), that is half of the sample spacing diagonal.
+ *
+ * @param [in] aabb Grid extent.
+ * @param [in] subdivisions Cells per axis.
+ * @return The error bound of the lookup.
+ */
+float getBrickErrorBound(const AABB& aabb, int subdivisions){
+    vec3 minimum = {aabb.minimum.x, aabb.minimum.y, aabb.minimum.z};
+    vec3 maximum = {aabb.maximum.x, aabb.maximum.y, aabb.maximum.z};
+    vec3 spacing = (maximum - minimum) / (float)(subdivisions * (BRICK_SIZE - 1));
+    return 0.5f * length(spacing);
+}
+
+/**
+ * @brief Sample the pruned trees into bricks.
+ *
+ * @param [in] scene Scene with primitives and binary operations.
+ * @param [in] grid Pruning grid with far-fields.
+ * @param [out] map Baked distance field.
+ */
+void bakeBrickMap(const Scene& scene, const PruningGrid& grid, BrickMap& map){
+    int cellCount = grid.cells.size();
+    int brickCount = 0;
+    map.bricks.assign(cellCount, -1);
+    for (int i = 0; i < cellCount; i++) {
+        if (grid.cells[i].size > 0) map.bricks[i] = brickCount++;
+    }
+
+    map.aabb = grid.aabb;
+    map.subdivisions = grid.subdivisions;
+    map.farFieldValues = grid.farFieldValues;
+    map.atlasBricks = std::max((int)std::ceil(std::cbrt((double)brickCount)), 1);
+    while (map.atlasBricks * map.atlasBricks * map.atlasBricks < brickCount) map.atlasBricks++;
+    map.atlasSize = map.atlasBricks * BRICK_SIZE;
+    map.samples.resize((size_t)brickCount * BRICK_SIZE * BRICK_SIZE * BRICK_SIZE);
+    map.errorBound = getBrickErrorBound(grid.aabb, grid.subdivisions);
+
+    vec3 minimum = {grid.aabb.minimum.x, grid.aabb.minimum.y, grid.aabb.minimum.z};
+    vec3 maximum = {grid.aabb.maximum.x, grid.aabb.maximum.y, grid.aabb.maximum.z};
+    vec3 cellSize = (maximum - minimum) / (float)grid.subdivisions;
+    int n = grid.subdivisions;
+
+    for (int z = 0; z < n; z++)
+    for (int y = 0; y < n; y++)
+    for (int x = 0; x < n; x++) {
+        int cellIndex = getCellIndex(x, y, z, n);
+        int brick = map.bricks[cellIndex];
+        if (brick < 0) continue;
+
+        const CellInfo& cell = grid.cells[cellIndex];
+        vec3 cellMinimum = minimum + cellSize * vec3{(float)x, (float)y, (float)z};
+        float* s = map.samples.data() + (size_t)brick * BRICK_SIZE * BRICK_SIZE * BRICK_SIZE;
+
+        for (int k = 0; k < BRICK_SIZE; k++)
+        for (int j = 0; j < BRICK_SIZE; j++)
+        for (int i = 0; i < BRICK_SIZE; i++) {
+            vec3 f = vec3{(float)i, (float)j, (float)k} / (float)(BRICK_SIZE - 1);
+            vec3 p = cellMinimum + cellSize * f;
+            s[(k * BRICK_SIZE + j) * BRICK_SIZE + i] = sdf(p, scene, grid.nodes.data() + cell.offset, cell.size);
+        }
+    }
+}
+
+/**
+ * @brief 3D texture layout of the bricks.
+ *
+ * Brick b is placed at (b % atlasBricks, b / atlasBricks % atlasBricks, b / atlasBricks^2)
+ * bricks from the atlas origin.
+ *
+ * @param [in] map Baked distance field.
+ * @param [out] atlas atlasSize^3 samples, x fastest.
+ */
+void getBrickAtlas(const BrickMap& map, std::vector<float>& atlas){
+    size_t size = map.atlasSize;
+    atlas.assign(size * size * size, 0.0f);
+    int brickCount = map.samples.size() / (BRICK_SIZE * BRICK_SIZE * BRICK_SIZE);
+    for (int brick = 0; brick < brickCount; brick++) {
+        int bx = brick % map.atlasBricks * BRICK_SIZE;
+        int by = brick / map.atlasBricks % map.atlasBricks * BRICK_SIZE;
+        int bz = brick / (map.atlasBricks * map.atlasBricks) * BRICK_SIZE;
+        const float* s = map.samples.data() + (size_t)brick * BRICK_SIZE * BRICK_SIZE * BRICK_SIZE;
+        for (int k = 0; k < BRICK_SIZE; k++)
+        for (int j = 0; j < BRICK_SIZE; j++) {
+            std::copy(s, s + BRICK_SIZE, atlas.begin() + ((bz + k) * size + (by + j)) * size + bx);
+            s += BRICK_SIZE;
+        }
+    }
+}
+
+/**
+ * @brief Trilinear lookup of the baked distance field.
+ *
+ * Same as sdf() of full3DTreePruningBricks.frag.
+ *
+ * @param [in] p 3D space position inside the grid.
+ * @param [in] map Baked distance field.
+ * @param [out] error Error bound of the value (0 for far-field cells).
+ * @return The baked SDF value at the position.
+ */
+float sdfBrickMap(vec3 p, const BrickMap& map, float& error){
+    vec3 minimum = {map.aabb.minimum.x, map.aabb.minimum.y, map.aabb.minimum.z};
+    vec3 maximum = {map.aabb.maximum.x, map.aabb.maximum.y, map.aabb.maximum.z};
+    vec3 cellSize = (maximum - minimum) / (float)map.subdivisions;
+    vec3 c = (p - minimum) / cellSize;
+    int last = map.subdivisions - 1;
+    int x = std::clamp((int)c.x, 0, last);
+    int y = std::clamp((int)c.y, 0, last);
+    int z = std::clamp((int)c.z, 0, last);
+    int cellIndex = getCellIndex(x, y, z, map.subdivisions);
+
+    int brick = map.bricks[cellIndex];
+    if (brick < 0) {
+        error = 0.0f;
+        return map.farFieldValues[cellIndex];
+    }
+    error = map.errorBound;
+
+    // Posição na célula em amostras, [0, BRICK_SIZE - 1]
+    float scale = BRICK_SIZE - 1;
+    vec3 g = {std::clamp(c.x - x, 0.0f, 1.0f) * scale, std::clamp(c.y - y, 0.0f, 1.0f) * scale,
+              std::clamp(c.z - z, 0.0f, 1.0f) * scale};
+    int i = std::min((int)g.x, BRICK_SIZE - 2);
+    int j = std::min((int)g.y, BRICK_SIZE - 2);
+    int k = std::min((int)g.z, BRICK_SIZE - 2);
+    vec3 t = g - vec3{(float)i, (float)j, (float)k};
+
+    const float* s = map.samples.data() + (size_t)brick * BRICK_SIZE * BRICK_SIZE * BRICK_SIZE +
+                     (k * BRICK_SIZE + j) * BRICK_SIZE + i;
+    const int dy = BRICK_SIZE;
+    const int dz = BRICK_SIZE * BRICK_SIZE;
+
+    float x00 = s[0] + (s[1] - s[0]) * t.x;
+    float x10 = s[dy] + (s[dy + 1] - s[dy]) * t.x;
+    float x01 = s[dz] + (s[dz + 1] - s[dz]) * t.x;
+    float x11 = s[dz + dy] + (s[dz + dy + 1] - s[dz + dy]) * t.x;
+    float y0 = x00 + (x10 - x00) * t.y;
+    float y1 = x01 + (x11 - x01) * t.y;
+    return y0 + (y1 - y0) * t.z;
+}
+
+/**
+ * @brief Ray marching over the baked distance field.
+ *
+ * Same loop as rayMarching() of full3DTreePruningBricks.frag. Away from the surface the step is
+ * the lookup minus its error bound, which never crosses the real surface; inside the error band
+ * the step is the value of the cell tree, so the ray stops on the real surface.
+ *
+ * @param [in] origin Ray origin (inside the grid).
+ * @param [in] direction Normalized ray direction.
+ * @param [in] scene Scene with primitives and binary operations.
+ * @param [in] grid Pruning grid the map was baked from.
+ * @param [in] map Baked distance field.
+ * @param [in] maxDistance Maximum ray distance.
+ * @param [in] maxSteps Maximum ray steps.
+ * @param [out] steps Steps done by the ray (lookups, and tree evaluations inside the band).
+ * @return Hit distance, or 1e20 when the ray leaves the grid.
+ */
+float rayMarchBrickMap(vec3 origin, vec3 direction, const Scene& scene, const PruningGrid& grid, const BrickMap& map,
+                       float maxDistance, int maxSteps, int& steps){
+    float t = 0.0f;
+    steps = 0;
+    while (t < maxDistance) {
+        vec3 p = origin + direction * t;
+        if (p.x < map.aabb.minimum.x || p.y < map.aabb.minimum.y || p.z < map.aabb.minimum.z ||
+            p.x >= map.aabb.maximum.x || p.y >= map.aabb.maximum.y || p.z >= map.aabb.maximum.z) {
+            return 1e20f;
+        }
+        float error;
+        float r = sdfBrickMap(p, map, error);
+        // Na faixa de erro a consulta pode passar da superfície: vale a árvore da célula
+        if (error > 0.0f && r <= 2.0f * error) r = sdfGrid(p, scene, grid);
+        else r -= error;
+        steps++;
+        if (r < RAY_EPSILON) break;
+        if (steps > maxSteps) break;
+        t += r;
+    }
+    return t;
+}
+
+#endif
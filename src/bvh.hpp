@@ -0,0 +1,221 @@
+/**
+ * @file bvh.hpp
+ * @brief Bounding volume hierarchy over the union-level subtrees.
+ *
+ * The chain of hard unions (min with k = 0) from the root splits the tree in independent
+ * subtrees whose minimum is the root value. A BVH over their boxes lets the CPU evaluator
+ * visit them in near-to-far order and skip the ones whose box is farther than the best
+ * distance found. This is an alternative to the pruning grid for scenes with many disjoint
+ * parts.
+ *
+ * @author Edson Martinelli
+ * @date 2026
+ */
+
+#ifndef BVH_HPP
+#define BVH_HPP
+
+#include <vector>
+#include <algorithm>
+#include "shape.hpp"
+#include "vector.hpp"
+#include "bounds.hpp"
+#include "evaluator.hpp"
+
+/**
+ * @brief Union-level subtree: contiguous post-order range [start, root].
+ */
+struct UnionLeaf{
+    int start; /**< First node of the subtree. */
+    int root; /**< Root node of the subtree. */
+    int offset; /**< First node of the subtree copy in BVH::trees. */
+};
+
+/**
+ * @brief BVH node. Leaves point to one UnionLeaf.
+ */
+struct BVHNode{
+    NodeBound bound; /**< Box of all subtrees below the node. */
+    int left; /**< Left child or -1 for a leaf. */
+    int right; /**< Right child or -1 for a leaf. */
+    int leaf; /**< Index in BVH::leaves for a leaf, -1 otherwise. */
+};
+
+/**
+ * @brief BVH of one post-order tree.
+ */
+struct BVH{
+    std::vector<BVHNode> nodes; /**< BVH nodes, root at 0 (empty when every subtree is unbounded). */
+    std::vector<UnionLeaf> leaves; /**< Bounded union-level subtrees. */
+    std::vector<UnionLeaf> unbounded; /**< Union-level subtrees without finite box (floor), always evaluated. */
+    std::vector<Node> trees; /**< Copy of the subtrees with parents relative to each copy (n-ary nodes need them). */
+};
+
+/**
+ * @brief Collect the union-level subtrees.
+ *
+ * Walk down from the root through hard unions (binary or n-ary) with sign 1, a smooth union or any other
+ * node ends the walk and becomes a subtree.
+ *
+ * @param [in] scene Scene with binary operations.
+ * @param [in] nodes Post-order node array.
+ * @param [in] start First node of each subtree (see getSubtreeStarts).
+ * @param [in] root Current node.
+ * @param [out] leaves Collected subtrees.
+ */
+void collectUnionLeaves(const Scene& scene, const Node* nodes, const std::vector<int>& start, int root,
+                        std::vector<UnionLeaf>& leaves){
+    const Node& node = nodes[root];
+    if (node.type != NODE_PRIMITIVE && node.sign == 1) {
+        const BinaryOperation& op = scene.binaryOperations[node.index];
+        if (op.s == 1 && op.k == 0) {
+            std::vector<int> children;
+            getChildren(start, root, children);
+            for (int child : children) collectUnionLeaves(scene, nodes, start, child, leaves);
+            return;
+        }
+    }
+    leaves.push_back({start[root], root, 0});
+}
+
+/**
+ * @brief Build the BVH recursively.
+ *
+ * Median split of the box centers along the largest axis.
+ *
+ * @param [in,out] bvh BVH being built.
+ * @param [in] bounds Box of each leaf (same order as bvh.leaves).
+ * @param [in,out] order Leaf indices of the current range.
+ * @param [in] lo First position of the range.
+ * @param [in] hi One past the last position of the range.
+ * @return Index of the created BVH node.
+ */
+int buildBVHNode(BVH& bvh, const std::vector<NodeBound>& bounds, std::vector<int>& order, int lo, int hi){
+    int index = bvh.nodes.size();
+    bvh.nodes.push_back({});
+
+    NodeBound b = bounds[order[lo]];
+    vec3 centerMin = {INFINITY, INFINITY, INFINITY};
+    vec3 centerMax = {-INFINITY, -INFINITY, -INFINITY};
+    for (int i = lo; i < hi; i++) {
+        const NodeBound& c = bounds[order[i]];
+        b.minimum = {std::min(b.minimum.x, c.minimum.x), std::min(b.minimum.y, c.minimum.y), std::min(b.minimum.z, c.minimum.z), 0.0f};
+        b.maximum = {std::max(b.maximum.x, c.maximum.x), std::max(b.maximum.y, c.maximum.y), std::max(b.maximum.z, c.maximum.z), 0.0f};
+        vec3 center = vec3{c.minimum.x + c.maximum.x, c.minimum.y + c.maximum.y, c.minimum.z + c.maximum.z} * 0.5f;
+        centerMin = min(centerMin, center);
+        centerMax = max(centerMax, center);
+    }
+
+    if (hi - lo == 1) {
+        bvh.nodes[index] = {b, -1, -1, order[lo]};
+        return index;
+    }
+
+    vec3 extent = centerMax - centerMin;
+    int axis = extent.x > extent.y ? (extent.x > extent.z ? 0 : 2) : (extent.y > extent.z ? 1 : 2);
+    auto center = [&](int leaf){
+        const NodeBound& c = bounds[leaf];
+        return axis == 0 ? c.minimum.x + c.maximum.x : (axis == 1 ? c.minimum.y + c.maximum.y : c.minimum.z + c.maximum.z);
+    };
+    int mid = (lo + hi) / 2;
+    std::nth_element(order.begin() + lo, order.begin() + mid, order.begin() + hi,
+                     [&](int a, int c){ return center(a) < center(c); });
+
+    int left = buildBVHNode(bvh, bounds, order, lo, mid);
+    int right = buildBVHNode(bvh, bounds, order, mid, hi);
+    bvh.nodes[index] = {b, left, right, -1};
+    return index;
+}
+
+/**
+ * @brief Build the BVH of a post-order tree.
+ *
+ * @param [in] scene Scene with primitives and binary operations.
+ * @param [in] nodes Post-order node array.
+ * @param [in] size Number of nodes.
+ * @param [out] bvh BVH of the union-level subtrees.
+ */
+void buildBVH(const Scene& scene, const Node* nodes, int size, BVH& bvh){
+    std::vector<NodeBound> nodeBounds(size);
+    std::vector<int> start;
+    std::vector<UnionLeaf> all;
+    computeNodeBounds(scene, nodes, size, nodeBounds.data());
+    getSubtreeStarts(nodes, size, start);
+    collectUnionLeaves(scene, nodes, start, size - 1, all);
+
+    bvh.nodes.clear();
+    bvh.leaves.clear();
+    bvh.unbounded.clear();
+    bvh.trees.clear();
+
+    std::vector<NodeBound> bounds;
+    for (UnionLeaf leaf : all) {
+        leaf.offset = bvh.trees.size();
+        for (int i = leaf.start; i <= leaf.root; i++) {
+            Node node = nodes[i];
+            node.parent = i == leaf.root ? -1 : node.parent - leaf.start;
+            bvh.trees.push_back(node);
+        }
+
+        if (isFiniteBound(nodeBounds[leaf.root])) {
+            bvh.leaves.push_back(leaf);
+            bounds.push_back(nodeBounds[leaf.root]);
+        } else {
+            bvh.unbounded.push_back(leaf);
+        }
+    }
+
+    if (!bvh.leaves.empty()) {
+        std::vector<int> order(bvh.leaves.size());
+        for (int i = 0; i < (int)order.size(); i++) order[i] = i;
+        bvh.nodes.reserve(2 * bvh.leaves.size());
+        buildBVHNode(bvh, bounds, order, 0, order.size());
+    }
+}
+
+/**
+ * @brief SDF evaluation with the BVH.
+ *
+ * Minimum of the union-level subtrees, visiting the BVH near-to-far and skipping boxes
+ * farther than the current best value. A skipped subtree is at least its box distance
+ * away, so the result stays a lower bound of the distance to the surface.
+ *
+ * @param [in] p 3D space position.
+ * @param [in] scene Scene with primitives and binary operations.
+ * @param [in] bvh BVH of the tree.
+ * @return The SDF value at the position.
+ */
+float sdfBVH(vec3 p, const Scene& scene, const BVH& bvh){
+    float best = INFINITY;
+    for (const UnionLeaf& leaf : bvh.unbounded) {
+        best = std::min(best, sdf(p, scene, bvh.trees.data() + leaf.offset, leaf.root - leaf.start + 1));
+    }
+    if (bvh.nodes.empty()) return best;
+
+    struct Entry{ int node; float dist; };
+    Entry stack[STACK_MAX];
+    int stackIndex = 0;
+    stack[stackIndex++] = {0, distanceAABB(p, bvh.nodes[0].bound)};
+
+    while (stackIndex > 0) {
+        Entry entry = stack[--stackIndex];
+        if (entry.dist >= best) continue;
+
+        const BVHNode& node = bvh.nodes[entry.node];
+        if (node.leaf >= 0) {
+            const UnionLeaf& leaf = bvh.leaves[node.leaf];
+            best = std::min(best, sdf(p, scene, bvh.trees.data() + leaf.offset, leaf.root - leaf.start + 1));
+            continue;
+        }
+
+        Entry near = {node.left, distanceAABB(p, bvh.nodes[node.left].bound)};
+        Entry far = {node.right, distanceAABB(p, bvh.nodes[node.right].bound)};
+        if (far.dist < near.dist) std::swap(near, far);
+        if (far.dist < best) stack[stackIndex++] = far;
+        if (near.dist < best) stack[stackIndex++] = near;
+    }
+
+    return best;
+}
+
+#endif
@@ -0,0 +1,266 @@
+/**
+ * @file context.hpp
+ * @brief OpenGL context of the program: a GLFW window or a headless EGL context.
+ *
+ * By default the context belongs to a GLFW window and each frame is presented by swapping its
+ * buffers. Built with USE_HEADLESS_CONTEXT=1 the program does not need a display: the context
+ * comes from EGL on the surfaceless platform of Mesa (llvmpipe without a GPU, or the driver of
+ * a GPU without a display server), the frames are drawn into a framebuffer object of the
+ * requested size, and presenting a frame waits for it to finish instead of swapping. The
+ * headless build links only EGL, not GLFW.
+ *
+ * The context also tracks if its surface needs a new frame (dirty): set at creation, when the
+ * window asks to be redrawn (exposed, restored) and by markWindowDirty() from the resize and
+ * input callbacks, so the render-on-demand loop of main.cpp blocks in waitRenderContext()
+ * while the image would not change.
+ *
+ * @author Edson Martinelli
+ * @date 2026
+ */
+
+#ifndef CONTEXT_HPP
+#define CONTEXT_HPP
+
+#ifndef USE_HEADLESS_CONTEXT
+#define USE_HEADLESS_CONTEXT 0 /**< Define if the program gonna render into a framebuffer of a headless EGL context (1) or into a GLFW window (0)*/
+#endif
+
+#include <glad/glad.h>
+#include <GLFW/glfw3.h>
+#include <chrono>
+#include <iostream>
+#if USE_HEADLESS_CONTEXT
+#define EGL_NO_X11
+#include <EGL/egl.h>
+#include <EGL/eglext.h>
+#endif
+
+/**
+ * @brief Context and the surface the frames are drawn to.
+ */
+struct RenderContext{
+    int width = 0; /**< Surface width. */
+    int height = 0; /**< Surface height. */
+    bool open = true; /**< The frames go on (until the window closes). */
+    bool dirty = true; /**< The surface needs a new frame. */
+#if USE_HEADLESS_CONTEXT
+    EGLDisplay display = EGL_NO_DISPLAY; /**< EGL display of the surfaceless platform. */
+    EGLContext context = EGL_NO_CONTEXT; /**< OpenGL 4.3 core context. */
+    GLuint framebuffer = 0; /**< Framebuffer the frames are drawn to. */
+    GLuint colorBuffer = 0; /**< RGBA8 color attachment of the framebuffer. */
+    std::chrono::steady_clock::time_point start; /**< Creation time. */
+#else
+    GLFWwindow* window = nullptr; /**< Window with the context. */
+#endif
+};
+
+/**
+ * @brief Ask a new frame of the context of a window.
+ *
+ * Called by the window callbacks (resize, input) that change the image.
+ *
+ * @param [in] window Window created by createRenderContext().
+ */
+void markWindowDirty([[maybe_unused]] GLFWwindow* window){
+#if !USE_HEADLESS_CONTEXT
+    RenderContext* context = (RenderContext*)glfwGetWindowUserPointer(window);
+    if (context != nullptr) context->dirty = true;
+#endif
+}
+
+/**
+ * @brief Create the context, make it current and load the OpenGL functions.
+ *
+ * The window keeps a pointer to the context, which must not move while the window exists.
+ *
+ * @param [out] context Context.
+ * @param [in] width Surface width.
+ * @param [in] height Surface height.
+ * @param [in] title Window title.
+ * @param [in] hidden Create the window without showing it (ignored when headless).
+ * @return False if the context could not be created (the error is printed).
+ */
+bool createRenderContext(RenderContext& context, int width, int height, [[maybe_unused]] const char* title, [[maybe_unused]] bool hidden){
+    context.width = width;
+    context.height = height;
+#if USE_HEADLESS_CONTEXT
+    context.start = std::chrono::steady_clock::now();
+    auto getPlatformDisplay = (PFNEGLGETPLATFORMDISPLAYEXTPROC)eglGetProcAddress("eglGetPlatformDisplayEXT");
+    if (getPlatformDisplay != nullptr) context.display = getPlatformDisplay(EGL_PLATFORM_SURFACELESS_MESA, EGL_DEFAULT_DISPLAY, nullptr);
+    if (context.display == EGL_NO_DISPLAY) context.display = eglGetDisplay(EGL_DEFAULT_DISPLAY);
+    EGLint major, minor;
+    if (context.display == EGL_NO_DISPLAY || !eglInitialize(context.display, &major, &minor)) {
+        std::cerr << "Failed to initialize EGL\n";
+        return false;
+    }
+
+    // Sem superfície: a configuração só precisa aceitar OpenGL
+    EGLint configAttributes[] = {EGL_SURFACE_TYPE, EGL_PBUFFER_BIT, EGL_RENDERABLE_TYPE, EGL_OPENGL_BIT, EGL_NONE};
+    EGLConfig config;
+    EGLint configCount = 0;
+    eglChooseConfig(context.display, configAttributes, &config, 1, &configCount);
+    EGLint contextAttributes[] = {EGL_CONTEXT_MAJOR_VERSION, 4, EGL_CONTEXT_MINOR_VERSION, 3,
+                                  EGL_CONTEXT_OPENGL_PROFILE_MASK, EGL_CONTEXT_OPENGL_CORE_PROFILE_BIT, EGL_NONE};
+    if (configCount == 0 || !eglBindAPI(EGL_OPENGL_API) ||
+        (context.context = eglCreateContext(context.display, config, EGL_NO_CONTEXT, contextAttributes)) == EGL_NO_CONTEXT ||
+        !eglMakeCurrent(context.display, EGL_NO_SURFACE, EGL_NO_SURFACE, context.context)) {
+        std::cerr << "Failed to create a headless OpenGL 4.3 context\n";
+        eglTerminate(context.display);
+        return false;
+    }
+
+    if (!gladLoadGLLoader((GLADloadproc)eglGetProcAddress)) {
+        std::cout << "Failed to initialize GLAD" << std::endl;
+        return false;
+    }
+
+    glGenRenderbuffers(1, &context.colorBuffer);
+    glBindRenderbuffer(GL_RENDERBUFFER, context.colorBuffer);
+    glRenderbufferStorage(GL_RENDERBUFFER, GL_RGBA8, width, height);
+    glGenFramebuffers(1, &context.framebuffer);
+    glBindFramebuffer(GL_FRAMEBUFFER, context.framebuffer);
+    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, context.colorBuffer);
+    if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE) {
+        std::cerr << "Failed to create the framebuffer\n";
+        return false;
+    }
+#else
+    if (!glfwInit()) {
+        std::cerr << "Failed to initialize GLFW\n";
+        return false;
+    }
+    glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 4);
+    glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 3);
+    glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
+    if (hidden) glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+
+    context.window = glfwCreateWindow(width, height, title, nullptr, nullptr);
+    if (!context.window) {
+        std::cerr << "Failed to create window\n";
+        glfwTerminate();
+        return false;
+    }
+
+    glfwMakeContextCurrent(context.window);
+    glfwSwapInterval(0);
+    glfwSetWindowUserPointer(context.window, &context);
+    glfwSetWindowRefreshCallback(context.window, markWindowDirty);
+
+    if (!gladLoadGLLoader((GLADloadproc)glfwGetProcAddress)) {
+        std::cout << "Failed to initialize GLAD" << std::endl;
+        return false;
+    }
+#endif
+    glViewport(0, 0, width, height);
+    return true;
+}
+
+/**
+ * @brief Time since the context was created.
+ *
+ * @param [in] context Context.
+ * @return Seconds.
+ */
+double getContextTime([[maybe_unused]] const RenderContext& context){
+#if USE_HEADLESS_CONTEXT
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - context.start).count();
+#else
+    return glfwGetTime();
+#endif
+}
+
+/**
+ * @brief Check if the frames go on.
+ *
+ * @param [in] context Context.
+ * @return False once the window was closed or closeRenderContext() was called.
+ */
+bool isContextOpen(const RenderContext& context){
+#if USE_HEADLESS_CONTEXT
+    return context.open;
+#else
+    return context.open && !glfwWindowShouldClose(context.window);
+#endif
+}
+
+/**
+ * @brief Stop the frames.
+ *
+ * @param [in,out] context Context.
+ */
+void closeRenderContext(RenderContext& context){
+    context.open = false;
+}
+
+/**
+ * @brief Framebuffer the frames are presented from.
+ *
+ * @param [in] context Context.
+ * @return The framebuffer object when headless, the default framebuffer (0) of the window otherwise.
+ */
+GLuint getContextFramebuffer([[maybe_unused]] const RenderContext& context){
+#if USE_HEADLESS_CONTEXT
+    return context.framebuffer;
+#else
+    return 0;
+#endif
+}
+
+/**
+ * @brief Present a frame.
+ *
+ * Headless, nothing is shown: the frame is finished, so the frame time still covers its work.
+ *
+ * @param [in,out] context Context.
+ */
+void presentRenderContext([[maybe_unused]] RenderContext& context){
+#if USE_HEADLESS_CONTEXT
+    glFinish();
+#else
+    glfwSwapBuffers(context.window);
+#endif
+}
+
+/**
+ * @brief Process the window events (nothing when headless).
+ *
+ * @param [in,out] context Context.
+ */
+void pollRenderContext([[maybe_unused]] RenderContext& context){
+#if !USE_HEADLESS_CONTEXT
+    glfwPollEvents();
+#endif
+}
+
+/**
+ * @brief Block until a window event arrives (nothing when headless).
+ *
+ * @param [in,out] context Context.
+ * @param [in] timeout Longest wait in seconds, negative to wait without limit.
+ */
+void waitRenderContext([[maybe_unused]] RenderContext& context, [[maybe_unused]] double timeout){
+#if !USE_HEADLESS_CONTEXT
+    if (timeout < 0.0) glfwWaitEvents();
+    else glfwWaitEventsTimeout(timeout);
+#endif
+}
+
+/**
+ * @brief Destroy the context and its surface.
+ *
+ * @param [in,out] context Context.
+ */
+void destroyRenderContext(RenderContext& context){
+#if USE_HEADLESS_CONTEXT
+    glDeleteFramebuffers(1, &context.framebuffer);
+    glDeleteRenderbuffers(1, &context.colorBuffer);
+    eglMakeCurrent(context.display, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+    eglDestroyContext(context.display, context.context);
+    eglTerminate(context.display);
+#else
+    glfwDestroyWindow(context.window);
+    glfwTerminate();
+#endif
+}
+
+#endif
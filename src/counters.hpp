@@ -0,0 +1,144 @@
+/**
+ * @file counters.hpp
+ * @brief Per-pixel work counters and their histograms.
+ *
+ * The production marcher (full3DTreePruningFarFields.frag, when the counters uniform is set)
+ * and the CPU renderer of render.hpp write the same four counters per pixel: march steps,
+ * sdf() calls (march and normal), tree nodes evaluated and primitives evaluated. A far-field
+ * cell counts one sdf() call and no node. The counters of an image are reduced to totals and
+ * linear histograms, so marchers and pruning settings can be compared by the work done.
+ *
+ * @author Edson Martinelli
+ * @date 2026
+ */
+
+#ifndef COUNTERS_HPP
+#define COUNTERS_HPP
+
+#include <cstdio>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <algorithm>
+
+const int COUNTER_BINS = 32; /**< Histogram bins per counter. */
+const int COUNTER_COUNT = 4; /**< Counters per pixel. */
+const char* const COUNTER_NAMES[COUNTER_COUNT] = {"steps", "sdf_calls", "nodes", "primitives"}; /**< Counter names in the reports. */
+
+/**
+ * @brief Work counters of one pixel (the uvec4 of the shader counters buffer).
+ */
+struct PixelCounters{
+    uint32_t steps = 0; /**< March steps. */
+    uint32_t sdfCalls = 0; /**< sdf() calls, far-field lookups included. */
+    uint32_t nodes = 0; /**< Tree nodes evaluated. */
+    uint32_t primitives = 0; /**< Primitives evaluated. */
+};
+
+/**
+ * @brief Totals and histogram of one counter over an image.
+ */
+struct CounterHistogram{
+    uint64_t total = 0; /**< Sum over the pixels. */
+    double mean = 0.0; /**< Mean per pixel. */
+    uint32_t maximum = 0; /**< Largest pixel value. */
+    uint32_t binWidth = 1; /**< Values per bin (bin i holds [i * binWidth, (i + 1) * binWidth)). */
+    std::vector<uint64_t> bins; /**< Pixels per bin. */
+};
+
+/**
+ * @brief Reduced counters of an image.
+ */
+struct CounterReport{
+    std::string source; /**< Renderer that produced the counters (gpu or cpu). */
+    std::string variant; /**< Marcher or pruning setting. */
+    int width = 0; /**< Image width. */
+    int height = 0; /**< Image height. */
+    CounterHistogram counters[COUNTER_COUNT]; /**< One entry per COUNTER_NAMES. */
+};
+
+/**
+ * @brief Value of a counter by index.
+ *
+ * @param [in] pixel Counters of a pixel.
+ * @param [in] counter Index in COUNTER_NAMES.
+ * @return The counter value.
+ */
+uint32_t getPixelCounter(const PixelCounters& pixel, int counter){
+    switch (counter) {
+        case 0: return pixel.steps;
+        case 1: return pixel.sdfCalls;
+        case 2: return pixel.nodes;
+        default: return pixel.primitives;
+    }
+}
+
+/**
+ * @brief Reduce the counters of an image to totals and histograms.
+ *
+ * @param [in] pixels Counters of each pixel.
+ * @param [in] width Image width.
+ * @param [in] height Image height.
+ * @param [in,out] report Reduced counters (source and variant are kept).
+ */
+void reducePixelCounters(const std::vector<PixelCounters>& pixels, int width, int height, CounterReport& report){
+    report.width = width;
+    report.height = height;
+    for (int c = 0; c < COUNTER_COUNT; c++) {
+        CounterHistogram& histogram = report.counters[c];
+        histogram = CounterHistogram();
+        for (const PixelCounters& pixel : pixels) {
+            uint32_t value = getPixelCounter(pixel, c);
+            histogram.total += value;
+            histogram.maximum = std::max(histogram.maximum, value);
+        }
+        histogram.mean = pixels.empty() ? 0.0 : (double)histogram.total / pixels.size();
+        histogram.binWidth = std::max<uint32_t>(1, (histogram.maximum + COUNTER_BINS) / COUNTER_BINS);
+        histogram.bins.assign(COUNTER_BINS, 0);
+        for (const PixelCounters& pixel : pixels) {
+            histogram.bins[std::min<uint32_t>(getPixelCounter(pixel, c) / histogram.binWidth, COUNTER_BINS - 1)]++;
+        }
+    }
+}
+
+/**
+ * @brief Print the totals of the counters.
+ *
+ * @param [in] report Reduced counters.
+ */
+void printCounterReport(const CounterReport& report){
+    std::printf("%s %s %dx%d:", report.source.c_str(), report.variant.c_str(), report.width, report.height);
+    for (int c = 0; c < COUNTER_COUNT; c++) {
+        const CounterHistogram& histogram = report.counters[c];
+        std::printf(" %s %llu (%.2f/pixel, max %u)%s", COUNTER_NAMES[c], (unsigned long long)histogram.total,
+                    histogram.mean, histogram.maximum, c + 1 < COUNTER_COUNT ? "," : "\n");
+    }
+}
+
+/**
+ * @brief Write the reduced counters as JSON.
+ *
+ * @param [in] path File path.
+ * @param [in] report Reduced counters.
+ * @return False if the file could not be written.
+ */
+bool writeCounterReport(const char* path, const CounterReport& report){
+    FILE* file = std::fopen(path, "w");
+    if (file == nullptr) return false;
+    std::fprintf(file, "{\n  \"source\": \"%s\",\n  \"variant\": \"%s\",\n  \"width\": %d,\n  \"height\": %d,\n  \"counters\": {",
+                 report.source.c_str(), report.variant.c_str(), report.width, report.height);
+    for (int c = 0; c < COUNTER_COUNT; c++) {
+        const CounterHistogram& histogram = report.counters[c];
+        std::fprintf(file, "%s\n    \"%s\": {\"total\": %llu, \"mean\": %.6f, \"max\": %u, \"bin_width\": %u, \"histogram\": [",
+                     c > 0 ? "," : "", COUNTER_NAMES[c], (unsigned long long)histogram.total, histogram.mean,
+                     histogram.maximum, histogram.binWidth);
+        for (size_t i = 0; i < histogram.bins.size(); i++) {
+            std::fprintf(file, "%s%llu", i > 0 ? ", " : "", (unsigned long long)histogram.bins[i]);
+        }
+        std::fprintf(file, "]}");
+    }
+    std::fprintf(file, "\n  }\n}\n");
+    return std::fclose(file) == 0;
+}
+
+#endif
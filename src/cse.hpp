@@ -0,0 +1,288 @@
+/**
+ * @file cse.hpp
+ * @brief Shared sub-computations between primitives.
+ *
+ * Primitives often repeat work: a ring is two cylinders with the same center, so both compute
+ * the same length(p.xy - offset), and the boxes of one axis only differ in th or depth after
+ * the same rotation. Identical primitives are merged in the tree, and the rest is split in a
+ * shared 2D term (the center distance of a cylinder, the rotated absolute position of a box)
+ * and a cheap per-primitive part (radius or thickness plus the extrusion). Each term is
+ * evaluated once per point and reused by every primitive of the same key. A term is only
+ * shared when it costs more than the cache check, store and load that replace it (see
+ * getTermCost): the center distance of a cylinder is a single 2D length and stays inline,
+ * which made the rings scenes slower when it was shared. Without any shared term or cached
+ * primitive, sdfShared() is the plain evaluation.
+ *
+ * CPU only: a GLSL version of this evaluation was slower than the plain marcher.
+ *
+ * @author Edson Martinelli
+ * @date 2026
+ */
+
+#ifndef CSE_HPP
+#define CSE_HPP
+
+#include <cmath>
+#include <vector>
+#include <algorithm>
+#include "shape.hpp"
+#include "vector.hpp"
+#include "evaluator.hpp"
+
+const int SHARE_MIN_COST = 8; /**< Smallest term cost (see getTermCost) worth a cache round trip per point. */
+
+/**
+ * @brief Sharing of one primitive.
+ */
+struct PrimitiveShare{
+    int term; /**< Index of the first primitive with the same term key, -1 if the term is not shared. */
+    int cached; /**< 1 when more than one node uses the primitive, its value is kept for the point. */
+};
+
+/**
+ * @brief Shared terms of a scene.
+ */
+struct SharedTerms{
+    std::vector<PrimitiveShare> primitives; /**< Sharing of each primitive. */
+    int terms; /**< Number of distinct terms. */
+    int merged; /**< Primitives merged with an identical one. */
+    int cached; /**< Primitives whose value is kept for the point. */
+};
+
+/**
+ * @brief Per-point cache of the shared evaluation.
+ *
+ * Entries are valid when their stamp equals the current one, so a new point only increments
+ * the stamp instead of clearing the arrays.
+ */
+struct SharedCache{
+    std::vector<vec3> termValues; /**< Term value by term index. */
+    std::vector<float> primitiveValues; /**< Primitive value by primitive index. */
+    std::vector<int> termStamp; /**< Point of each term value. */
+    std::vector<int> primitiveStamp; /**< Point of each primitive value. */
+    int stamp = 0; /**< Current point. */
+};
+
+/**
+ * @brief Same primitive parameters.
+ *
+ * @param [in] a First primitive.
+ * @param [in] b Second primitive.
+ * @return True when both primitives have the same SDF.
+ */
+bool isSamePrimitive(const Primitive& a, const Primitive& b){
+    if (a.type != b.type) return false;
+    switch (a.type) {
+        case PRIMITIVE_CYLINDER:
+            return a.offsetX == b.offsetX && a.offsetY == b.offsetY && a.r == b.r && a.depth == b.depth;
+        case PRIMITIVE_BOX:
+            return a.sideCenterX == b.sideCenterX && a.sideCenterY == b.sideCenterY && a.m == b.m &&
+                   a.xEnd == b.xEnd && a.th == b.th && a.depth == b.depth;
+        default:
+            return true;
+    }
+}
+
+/**
+ * @brief Same shared term.
+ *
+ * @param [in] a First primitive.
+ * @param [in] b Second primitive.
+ * @return True when both primitives have the same 2D term.
+ */
+bool isSameTerm(const Primitive& a, const Primitive& b){
+    if (a.type != b.type) return false;
+    switch (a.type) {
+        case PRIMITIVE_CYLINDER:
+            return a.offsetX == b.offsetX && a.offsetY == b.offsetY;
+        case PRIMITIVE_BOX:
+            return a.sideCenterX == b.sideCenterX && a.sideCenterY == b.sideCenterY && a.m == b.m && a.xEnd == b.xEnd;
+        default:
+            return false;
+    }
+}
+
+/**
+ * @brief Rough cost of the shared term of a primitive.
+ *
+ * Arithmetic operations of evalTerm(): a cylinder term is one 2D distance, a box term also
+ * builds the box axis and rotates the position into it.
+ *
+ * @param [in] pr Cylinder or box primitive.
+ * @return Operations of the term.
+ */
+int getTermCost(const Primitive& pr){
+    return pr.type == PRIMITIVE_BOX ? 24 : 5;
+}
+
+/**
+ * @brief Find the shared terms and merge identical primitives.
+ *
+ * Nodes of a primitive identical to an earlier one are rewritten to the earlier primitive,
+ * so their value is computed once per point.
+ *
+ * @param [in] scene Scene with primitives.
+ * @param [in,out] nodes Post-order node array.
+ * @param [out] shared Term of each primitive.
+ */
+void compileSharedTerms(const Scene& scene, std::vector<Node>& nodes, SharedTerms& shared){
+    int count = scene.primitives.size();
+    std::vector<int> alias(count);
+    std::vector<int> users(count, 0);
+    shared.primitives.assign(count, {-1, 0});
+    shared.terms = 0;
+    shared.merged = 0;
+
+    for (int i = 0; i < count; i++) {
+        const Primitive& pr = scene.primitives[i];
+        alias[i] = i;
+        for (int j = 0; j < i; j++) {
+            if (alias[j] == j && isSamePrimitive(pr, scene.primitives[j])) {
+                alias[i] = j;
+                shared.merged++;
+                break;
+            }
+        }
+        if (alias[i] != i || (pr.type != PRIMITIVE_CYLINDER && pr.type != PRIMITIVE_BOX)) continue;
+
+        shared.primitives[i].term = i;
+        for (int j = 0; j < i; j++) {
+            if (shared.primitives[j].term == j && isSameTerm(pr, scene.primitives[j])) {
+                shared.primitives[i].term = j;
+                users[j]++;
+                break;
+            }
+        }
+        if (shared.primitives[i].term == i) users[i]++;
+    }
+
+    // Termo de uma primitiva só, ou mais barato que o cache, não economiza nada: avaliação direta
+    for (int i = 0; i < count; i++) {
+        int term = shared.primitives[i].term;
+        bool worth = term >= 0 && users[term] >= 2 && getTermCost(scene.primitives[term]) >= SHARE_MIN_COST;
+        if (term >= 0 && !worth) shared.primitives[i].term = -1;
+        if (term == i && worth) shared.terms++;
+    }
+
+    std::vector<int> uses(count, 0);
+    for (Node& node : nodes) {
+        if (node.type != NODE_PRIMITIVE) continue;
+        node.index = alias[node.index];
+        uses[node.index]++;
+    }
+    shared.cached = 0;
+    for (int i = 0; i < count; i++) {
+        shared.primitives[i].cached = uses[i] > 1;
+        shared.cached += shared.primitives[i].cached;
+    }
+}
+
+/**
+ * @brief Shared 2D term of a primitive.
+ *
+ * @param [in] p 3D space position.
+ * @param [in] pr Cylinder or box primitive.
+ * @return Center distance of a cylinder (x), or absolute position in the box frame (x, y) and
+ * half length of the box (z).
+ */
+vec3 evalTerm(vec3 p, const Primitive& pr){
+    if (pr.type == PRIMITIVE_CYLINDER) {
+        return {length(vec2{p.x, p.y} - vec2{pr.offsetX, pr.offsetY}), 0.0f, 0.0f};
+    }
+    vec2 sideOriginCenter = {pr.sideCenterX, pr.sideCenterY};
+    vec2 sideEndCenter = calculateLinearPoint(sideOriginCenter, pr.m, pr.xEnd);
+    float l = length(sideEndCenter - sideOriginCenter);
+    vec2 d = (sideEndCenter - sideOriginCenter) / l;
+    vec2 q = vec2{p.x, p.y} - (sideOriginCenter + sideEndCenter) * 0.5f;
+    q = {d.x * q.x + d.y * q.y, -d.y * q.x + d.x * q.y};
+    q = abs(q);
+    return {q.x, q.y, l * 0.5f};
+}
+
+/**
+ * @brief Primitive value from its shared term.
+ *
+ * Second half of sdCircle() and sdOBox(), same operations in the same order.
+ *
+ * @param [in] p 3D space position.
+ * @param [in] pr Cylinder or box primitive.
+ * @param [in] term Value of evalTerm() for the primitive key.
+ * @return The SDF value at the position.
+ */
+float evalFromTerm(vec3 p, const Primitive& pr, vec3 term){
+    if (pr.type == PRIMITIVE_CYLINDER) {
+        return opExtrusion(p, term.x - pr.r, pr.depth);
+    }
+    vec2 q = {term.x - term.z, term.y - pr.th};
+    float v = length(max(q, 0.0f)) + std::min(std::max(q.x, q.y), 0.0f);
+    return opExtrusion(p, v, pr.depth);
+}
+
+/**
+ * @brief Post-order tree evaluation with shared terms.
+ *
+ * Same as sdf(), but each primitive and each term is computed once per call. Only primitives
+ * and terms used more than once go through the cache.
+ *
+ * @param [in] p 3D space position.
+ * @param [in] scene Scene with primitives and binary operations.
+ * @param [in] nodes Post-order node array (rewritten by compileSharedTerms).
+ * @param [in] size Number of nodes.
+ * @param [in] shared Term of each primitive.
+ * @param [in,out] cache Evaluation cache.
+ * @param [out] saved Incremented by the primitive nodes served by a cached value or term (optional).
+ * @return The SDF value at the position.
+ */
+float sdfShared(vec3 p, const Scene& scene, const Node* nodes, int size, const SharedTerms& shared,
+                SharedCache& cache, int* saved = nullptr){
+    // Nada a reaproveitar: avaliação simples, sem o custo do cache
+    if (shared.terms == 0 && shared.cached == 0) return sdf(p, scene, nodes, size);
+
+    int count = scene.primitives.size();
+    if ((int)cache.primitiveStamp.size() != count) {
+        cache.termValues.assign(count, {0.0f, 0.0f, 0.0f});
+        cache.primitiveValues.assign(count, 0.0f);
+        cache.termStamp.assign(count, 0);
+        cache.primitiveStamp.assign(count, 0);
+    }
+    int stamp = ++cache.stamp;
+
+    float stack[STACK_MAX];
+    int stackParent[STACK_MAX];
+    int stackIndex = 0;
+
+    for (int i = 0; i < size; i++) {
+        const Node& node = nodes[i];
+        float d;
+        if (node.type == NODE_BINARY || node.type == NODE_NARY) {
+            int operands = node.type == NODE_NARY ? 1 : 2;
+            stackIndex -= operands;
+            d = foldOperation(scene.binaryOperations[node.index], stack + stackIndex, operands);
+        } else if (shared.primitives[node.index].cached && cache.primitiveStamp[node.index] == stamp) {
+            d = cache.primitiveValues[node.index];
+            if (saved != nullptr) (*saved)++;
+        } else {
+            const Primitive& pr = scene.primitives[node.index];
+            int term = shared.primitives[node.index].term;
+            if (term < 0) {
+                d = evalPrimitive(p, pr);
+            } else {
+                if (cache.termStamp[term] != stamp) {
+                    cache.termValues[term] = evalTerm(p, scene.primitives[term]);
+                    cache.termStamp[term] = stamp;
+                } else if (saved != nullptr) {
+                    (*saved)++;
+                }
+                d = evalFromTerm(p, pr, cache.termValues[term]);
+            }
+            cache.primitiveValues[node.index] = d;
+            cache.primitiveStamp[node.index] = stamp;
+        }
+
+        pushValue(scene, nodes, stack, stackParent, stackIndex, d * node.sign, node.parent);
+    }
+
+    return stack[0];
+}
+
+#endif
@@ -0,0 +1,359 @@
+/**
+ * @file evaluator.hpp
+ * @brief CPU evaluator of the post-order node tree.
+ *
+ * CPU port of the primitive SDFs and of the post-order interpreter used by the
+ * lipschitzPruning shaders. It reads the same Primitive, BinaryOperation and Node
+ * arrays uploaded to the SSBOs.
+ *
+ * @author Edson Martinelli
+ * @date 2026
+ */
+
+#ifndef EVALUATOR_HPP
+#define EVALUATOR_HPP
+
+#include <cmath>
+#include "shape.hpp"
+#include "vector.hpp"
+#include "bounds.hpp"
+
+const float RAY_EPSILON = 0.0001f; /**< Minimun next step to consider the ray hits a surface (e in the shaders). */
+const int STACK_MAX = 64; /**< Maximum depth of the post-order evaluation stack. */
+
+/**
+ * @brief Smooth minimum function.
+ *
+ * A quadractic polynomial smooth mininum function.
+ *
+ * @param [in] a Point value in the first SDF.
+ * @param [in] b Point value in the second SDF.
+ * @param [in] k Smooth value parameter.
+ * @return Smooth value for given values.
+ */
+float smoothFunction(float a, float b, float k){
+    if(k == 0) return 0;
+    float d = std::fabs(a - b);
+    float h = std::max(k - d, 0.0f);
+    return h * h * (1.0f / (4.0f * k));
+}
+
+/**
+ * @brief Extrusion operation for 2D SDFs.
+ *
+ * @param [in] p 3D space position.
+ * @param [in] sdf 2D SDF value for the position.
+ * @param [in] h Extrusion size.
+ * @return Correct value of 3D SDF at p point.
+ */
+float opExtrusion(vec3 p, float sdf, float h){
+    vec2 w = {sdf, std::fabs(p.z) - h};
+    return std::min(std::max(w.x, w.y), 0.0f) + length(max(w, 0.0f));
+}
+
+/**
+ * @brief Calculate Y coordenate of the linear equation and return the point.
+ *
+ * @param [in] origin A point in the line.
+ * @param [in] m Equation slope.
+ * @param [in] x Second point X coordenate.
+ * @return A point (2D) with X coordenate and correspondent Y.
+ */
+vec2 calculateLinearPoint(vec2 origin, float m, float x){
+    float c = (m * origin.x) - origin.y;
+    float y = (m * x) - c;
+    return {x, y};
+}
+
+/**
+ * @brief 2D profile of the plane with sin function used to cut.
+ *
+ * @param [in] p 2D space position.
+ * @return The correct value of the 2D SDF at the position.
+ */
+float sdPlaneCutterProfile(vec2 p){
+    vec2 offset = {-0.82f, 0.245f};
+    p = p - offset;
+    float f = p.x + 0.09f * std::sin(9.0f * p.y);
+    vec2 df = {1.0f, 0.81f * std::cos(9.0f * p.y)};
+    float g = std::max(length(df), RAY_EPSILON);
+    return f / g;
+}
+
+/**
+ * @brief Plane SDF with sin function used to cut.
+ *
+ * @param [in] p3 3D space position.
+ * @return The correct value of SDF at the position.
+ */
+float sdPlaneCutter(vec3 p3){
+    return opExtrusion(p3, sdPlaneCutterProfile({p3.x, p3.y}), 0.51f);
+}
+
+/**
+ * @brief 2D profile of the oriented box.
+ *
+ * @param [in] p 2D space position.
+ * @param [in] sideOriginCenter Center point of box origin side.
+ * @param [in] m Box slope.
+ * @param [in] xEndCenter X coordenate of the center point of box end side.
+ * @param [in] th Thickness of the box.
+ * @return The correct value of the 2D SDF at the position.
+ */
+float sdOBoxProfile(vec2 p, vec2 sideOriginCenter, float m, float xEndCenter, float th){
+    vec2 sideEndCenter = calculateLinearPoint(sideOriginCenter, m, xEndCenter);
+    float l = length(sideEndCenter - sideOriginCenter);
+    vec2 d = (sideEndCenter - sideOriginCenter) / l;
+    vec2 q = p - (sideOriginCenter + sideEndCenter) * 0.5f;
+    q = {d.x * q.x + d.y * q.y, -d.y * q.x + d.x * q.y};
+    q = abs(q) - vec2{l * 0.5f, th};
+    return length(max(q, 0.0f)) + std::min(std::max(q.x, q.y), 0.0f);
+}
+
+/**
+ * @brief Oriented Box SDF.
+ *
+ * @param [in] p3 3D space position.
+ * @param [in] sideOriginCenter Center point of box origin side.
+ * @param [in] m Box slope.
+ * @param [in] xEndCenter X coordenate of the center point of box end side.
+ * @param [in] th Thickness of the box.
+ * @param [in] depth Extrude depth.
+ * @return The correct value of SDF at the position.
+ */
+float sdOBox(vec3 p3, vec2 sideOriginCenter, float m, float xEndCenter, float th, float depth){
+    return opExtrusion(p3, sdOBoxProfile({p3.x, p3.y}, sideOriginCenter, m, xEndCenter, th), depth);
+}
+
+/**
+ * @brief 2D profile of the circle.
+ *
+ * @param [in] p 2D space position.
+ * @param [in] offset Circle center.
+ * @param [in] r Circle radius.
+ * @return The correct value of the 2D SDF at the position.
+ */
+float sdCircleProfile(vec2 p, vec2 offset, float r){
+    return length(p - offset) - r;
+}
+
+/**
+ * @brief Circle SDF.
+ *
+ * @param [in] p3 3D space position.
+ * @param [in] offset Circle center.
+ * @param [in] r Circle radius.
+ * @param [in] depth Extrude depth.
+ * @return The correct value of SDF at the position.
+ */
+float sdCircle(vec3 p3, vec2 offset, float r, float depth){
+    return opExtrusion(p3, sdCircleProfile({p3.x, p3.y}, offset, r), depth);
+}
+
+/**
+ * @brief Plane SDF.
+ *
+ * @param [in] p 3D space position.
+ * @return The correct value of SDF at the position.
+ */
+float sdFloor(vec3 p){
+    return p.y + 1.0f;
+}
+
+/**
+ * @brief Primitive Evaluation.
+ *
+ * @param [in] p 3D space position.
+ * @param [in] pr Primitive.
+ * @return The correct value of SDF at the position.
+ */
+float evalPrimitive(vec3 p, const Primitive& pr){
+    switch (pr.type) {
+        case PRIMITIVE_CYLINDER:
+            return sdCircle(p, {pr.offsetX, pr.offsetY}, pr.r, pr.depth);
+        case PRIMITIVE_BOX:
+            return sdOBox(p, {pr.sideCenterX, pr.sideCenterY}, pr.m, pr.xEnd, pr.th, pr.depth);
+        case PRIMITIVE_PLANE_CUTTER:
+            return sdPlaneCutter(p);
+        case PRIMITIVE_FLOOR:
+            return sdFloor(p);
+        default:
+            return 1e20f;
+    }
+}
+
+/**
+ * @brief Binary operation of two values.
+ *
+ * @param [in] binaryOperation Operation of the node.
+ * @param [in] a Left value.
+ * @param [in] b Right value.
+ * @return The operation value.
+ */
+inline float applyOperation(const BinaryOperation& binaryOperation, float a, float b){
+    float k = binaryOperation.k;
+    int s = binaryOperation.s;
+    return s * (std::min(s * a, s * b) - smoothFunction(a, b, k));
+}
+
+/**
+ * @brief Binary operation folded over the operands of a node.
+ *
+ * A binary node has two operands. An n-ary node (see flatten.hpp) applies the operation from
+ * left to right over all its operands, which is the same as the min/max for k = 0.
+ *
+ * @param [in] binaryOperation Operation of the node.
+ * @param [in] values Operand values, left to right.
+ * @param [in] count Number of operands.
+ * @return The operation value.
+ */
+inline float foldOperation(const BinaryOperation& binaryOperation, const float* values, int count){
+    float d = values[0];
+    for (int j = 1; j < count; j++) d = applyOperation(binaryOperation, d, values[j]);
+    return d;
+}
+
+/**
+ * @brief Push a node value on the evaluation stack.
+ *
+ * The operands of an n-ary node (see flatten.hpp) are folded into a running accumulator as
+ * they are computed: when the value below on the stack has the same n-ary parent, the new
+ * value is folded into it instead of pushed. The n-ary node then finds a single value, and
+ * the stack is never deeper than the one of the binary tree. The cheap test (same parent as
+ * the value below) comes first, so the values of binary nodes only pay one compare.
+ *
+ * @param [in] scene Scene with binary operations.
+ * @param [in] nodes Post-order node array.
+ * @param [in,out] stack Values on the stack.
+ * @param [in,out] stackParent Parent of each value on the stack.
+ * @param [in,out] stackIndex Number of values on the stack.
+ * @param [in] value Node value, sign applied.
+ * @param [in] parent Parent of the node (-1 for the root).
+ */
+inline void pushValue(const Scene& scene, const Node* nodes, float* stack, int* stackParent, int& stackIndex,
+                      float value, int parent){
+    if (stackIndex > 0 && stackParent[stackIndex - 1] == parent && parent >= 0 && nodes[parent].type == NODE_NARY) {
+        stack[stackIndex - 1] = applyOperation(scene.binaryOperations[nodes[parent].index], stack[stackIndex - 1], value);
+        return;
+    }
+    stack[stackIndex] = value;
+    stackParent[stackIndex] = parent;
+    stackIndex++;
+}
+
+/**
+ * @brief Post-order tree evaluation.
+ *
+ * Same interpreter as the sdf() of the shaders. When bounds are given, a replaceable
+ * subtree whose box is farther than BOUND_MARGIN is not evaluated and its box distance
+ * is pushed instead (see computeNodeBounds).
+ *
+ * @param [in] p 3D space position.
+ * @param [in] scene Scene with primitives and binary operations.
+ * @param [in] nodes Post-order node array.
+ * @param [in] size Number of nodes.
+ * @param [in] bounds Bounds of the nodes or nullptr to evaluate the whole tree.
+ * @param [out] evaluated Incremented by the number of nodes evaluated (optional).
+ * @return The SDF value at the position.
+ */
+float sdf(vec3 p, const Scene& scene, const Node* nodes, int size, const NodeBound* bounds = nullptr,
+          int* evaluated = nullptr){
+    float stack[STACK_MAX];
+    int stackParent[STACK_MAX];
+    int stackIndex = 0;
+
+    for (int i = 0; i < size; i++) {
+        if (bounds != nullptr) {
+            int root = bounds[i].skipRoot;
+            float boundValue = 0.0f;
+            while (root >= 0) {
+                boundValue = distanceAABB(p, bounds[root]);
+                if (boundValue > BOUND_MARGIN) break;
+                root = bounds[root].nextSkipRoot;
+            }
+            if (root >= 0) {
+                pushValue(scene, nodes, stack, stackParent, stackIndex, boundValue, nodes[root].parent);
+                i = root;
+                continue;
+            }
+        }
+
+        const Node& node = nodes[i];
+        float d;
+        if (node.type == NODE_BINARY) {
+            stackIndex -= 2;
+            d = applyOperation(scene.binaryOperations[node.index], stack[stackIndex], stack[stackIndex + 1]);
+        } else if (node.type == NODE_NARY) {
+            // Os operandos do nó n-ário já estão dobrados em um valor
+            d = stack[--stackIndex];
+        } else {
+            d = evalPrimitive(p, scene.primitives[node.index]);
+        }
+
+        pushValue(scene, nodes, stack, stackParent, stackIndex, d * node.sign, node.parent);
+        if (evaluated != nullptr) (*evaluated)++;
+    }
+
+    return stack[0];
+}
+
+/**
+ * @brief Lazy post-order tree evaluation.
+ *
+ * Before evaluating the right operand of a binary node, its box distance is compared with
+ * the left value already on the stack (for an n-ary node, every operand after the first is
+ * compared with the running fold of the operands before it, see pushValue). For a union, a
+ * right operand whose box distance is at least the left value plus k cannot win the minimum
+ * (the smooth term is zero when the values differ by k or more), so the result is the left
+ * value. For an intersection the same test means the right operand wins the maximum, and its
+ * box distance is used instead when it is farther than BOUND_MARGIN. The result equals the
+ * full evaluation near the surface; away from it, it is meant as a conservative step and not
+ * a proven lower bound (a replaced operand under a subtraction can raise the value).
+ *
+ * @param [in] p 3D space position.
+ * @param [in] scene Scene with primitives and binary operations.
+ * @param [in] nodes Post-order node array.
+ * @param [in] size Number of nodes.
+ * @param [in] bounds Bounds of the nodes (see computeNodeBounds).
+ * @param [out] evaluated Incremented by the number of nodes evaluated (optional).
+ * @return The SDF value at the position.
+ */
+float sdfLazy(vec3 p, const Scene& scene, const Node* nodes, int size, const NodeBound* bounds,
+              int* evaluated = nullptr){
+    float stack[STACK_MAX];
+    int stackParent[STACK_MAX];
+    int stackIndex = 0;
+
+    for (int i = 0; i < size; i++) {
+        int right = bounds[i].rightRoot;
+        if (right >= 0) {
+            const BinaryOperation& binaryOperation = scene.binaryOperations[nodes[nodes[right].parent].index];
+            float leftValue = stack[stackIndex - 1];
+            float boundValue = distanceAABB(p, bounds[right]);
+            bool outside = binaryOperation.s == 1 ? boundValue > 0.0f : boundValue > BOUND_MARGIN;
+            if (outside && boundValue >= leftValue + binaryOperation.k) {
+                pushValue(scene, nodes, stack, stackParent, stackIndex, boundValue, nodes[right].parent);
+                i = right;
+                continue;
+            }
+        }
+
+        const Node& node = nodes[i];
+        float d;
+        if (node.type == NODE_BINARY) {
+            stackIndex -= 2;
+            d = applyOperation(scene.binaryOperations[node.index], stack[stackIndex], stack[stackIndex + 1]);
+        } else if (node.type == NODE_NARY) {
+            d = stack[--stackIndex];
+        } else {
+            d = evalPrimitive(p, scene.primitives[node.index]);
+        }
+
+        pushValue(scene, nodes, stack, stackParent, stackIndex, d * node.sign, node.parent);
+        if (evaluated != nullptr) (*evaluated)++;
+    }
+
+    return stack[0];
+}
+
+#endif
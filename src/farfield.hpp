@@ -0,0 +1,184 @@
+/**
+ * @file farfield.hpp
+ * @brief Quantized far-field storage with filtered lookup.
+ *
+ * The far-field value of a cell is a lower bound of the distance inside it. The values are
+ * kept as max(v, 0), a lower bound of the positive part of the SDF, and stored as 8 or 16 bit
+ * normalized integers scaled by the largest value, always rounded down, so the stored value
+ * never exceeds the exact one. Cells with a tree store 0.
+ *
+ * The lookup filters the 8 closest cell centers (the GPU trilinear filtering of the texture
+ * in lipschitzPruning/full3DTreePruningQuantized.frag). Each neighbor bound is valid in its own
+ * cell, at a distance of at most (0.5 - s)h per axis from the point, where s is the offset of
+ * the point from its cell center in cells. With the neighbor weight s, the filtered value minus
+ * the sum of s(0.5 - s)h over the axes (at most 3h/16) stays a lower bound, and it grows
+ * toward the far side of the cell instead of staying constant. Neighbors with a tree pull the
+ * filtered value down, so the lookup keeps the largest of it and the cell own value. On the
+ * CPU, when the 8 codes are equal the filtered value can not beat the own value, so the
+ * lookup returns it without filtering (most of the far cells away from the surface).
+ *
+ * @author Edson Martinelli
+ * @date 2026
+ */
+
+#ifndef FARFIELD_HPP
+#define FARFIELD_HPP
+
+#include <cmath>
+#include <cstdint>
+#include <vector>
+#include <algorithm>
+#include "shape.hpp"
+#include "vector.hpp"
+#include "pruning.hpp"
+
+/**
+ * @brief Quantized far-field values.
+ */
+struct QuantizedFarField{
+    AABB aabb; /**< Grid extent. */
+    int subdivisions; /**< Cells per axis. */
+    int bits; /**< Bits per value (8 or 16). */
+    float scale; /**< Value of the largest code. */
+    std::vector<uint16_t> values; /**< Code of each cell (cell index order, x fastest). */
+};
+
+/**
+ * @brief Quantize the far-field values of a pruning grid.
+ *
+ * @param [in] grid Pruning grid with far-fields.
+ * @param [in] bits Bits per value (8 or 16).
+ * @param [out] field Quantized values.
+ */
+void quantizeFarFields(const PruningGrid& grid, int bits, QuantizedFarField& field){
+    int cellCount = grid.cells.size();
+    float maximum = 0.0f;
+    for (int i = 0; i < cellCount; i++) {
+        if (grid.cells[i].size == 0) maximum = std::max(maximum, grid.farFieldValues[i]);
+    }
+
+    field.aabb = grid.aabb;
+    field.subdivisions = grid.subdivisions;
+    field.bits = bits;
+    field.scale = maximum > 0.0f ? maximum : 1.0f;
+    field.values.assign(cellCount, 0);
+
+    float codes = (float)((1 << bits) - 1);
+    for (int i = 0; i < cellCount; i++) {
+        if (grid.cells[i].size > 0) continue;
+        float v = std::max(grid.farFieldValues[i], 0.0f);
+        // Arredonda para baixo: o valor lido nunca passa do limite exato
+        int code = std::clamp((int)std::floor(v / field.scale * codes), 0, (int)codes);
+        while (code > 0 && (float)code / codes * field.scale > v) code--;
+        field.values[i] = code;
+    }
+}
+
+/**
+ * @brief Stored code of a cell.
+ *
+ * @param [in] field Quantized values.
+ * @param [in] x Cell coordinate in X axis (clamped to the grid).
+ * @param [in] y Cell coordinate in Y axis (clamped to the grid).
+ * @param [in] z Cell coordinate in Z axis (clamped to the grid).
+ * @return The code (value / scale * (2^bits - 1)).
+ */
+int getQuantizedCode(const QuantizedFarField& field, int x, int y, int z){
+    int last = field.subdivisions - 1;
+    x = std::clamp(x, 0, last);
+    y = std::clamp(y, 0, last);
+    z = std::clamp(z, 0, last);
+    return field.values[getCellIndex(x, y, z, field.subdivisions)];
+}
+
+/**
+ * @brief Decoded value of a code.
+ *
+ * Same rounding as the check of quantizeFarFields, so it never exceeds the exact value.
+ *
+ * @param [in] field Quantized values.
+ * @param [in] code Stored code.
+ * @return The decoded value.
+ */
+float decodeFarField(const QuantizedFarField& field, int code){
+    float codes = (float)((1 << field.bits) - 1);
+    return (float)code / codes * field.scale;
+}
+
+/**
+ * @brief Filtered far-field lookup.
+ *
+ * Same as farField() of full3DTreePruningQuantized.frag.
+ *
+ * @param [in] p 3D space position inside the grid.
+ * @param [in] field Quantized values.
+ * @return A lower bound of the distance at the position (positive part).
+ */
+float sdfQuantizedFarField(vec3 p, const QuantizedFarField& field){
+    vec3 minimum = {field.aabb.minimum.x, field.aabb.minimum.y, field.aabb.minimum.z};
+    vec3 maximum = {field.aabb.maximum.x, field.aabb.maximum.y, field.aabb.maximum.z};
+    vec3 cellSize = (maximum - minimum) / (float)field.subdivisions;
+    vec3 c = (p - minimum) / cellSize - vec3{0.5f, 0.5f, 0.5f};
+
+    int x = (int)std::floor(c.x);
+    int y = (int)std::floor(c.y);
+    int z = (int)std::floor(c.z);
+    vec3 t = c - vec3{(float)x, (float)y, (float)z};
+
+    int code[2][2][2];
+    int n = field.subdivisions;
+    if (x >= 0 && y >= 0 && z >= 0 && x + 1 < n && y + 1 < n && z + 1 < n) {
+        // Longe da borda os vizinhos não precisam ser limitados à grade
+        const uint16_t* base = field.values.data() + getCellIndex(x, y, z, n);
+        for (int k = 0; k < 2; k++)
+        for (int j = 0; j < 2; j++)
+        for (int i = 0; i < 2; i++) code[k][j][i] = base[k * n * n + j * n + i];
+    } else {
+        for (int k = 0; k < 2; k++)
+        for (int j = 0; j < 2; j++)
+        for (int i = 0; i < 2; i++) code[k][j][i] = getQuantizedCode(field, x + i, y + j, z + k);
+    }
+    // Vizinhos iguais: o filtro menos a correção nunca passa do valor da própria célula
+    const int* codes = &code[0][0][0];
+    if (std::all_of(codes + 1, codes + 8, [&](int v){ return v == codes[0]; })) return decodeFarField(field, codes[0]);
+
+    float v[2][2][2];
+    for (int k = 0; k < 2; k++)
+    for (int j = 0; j < 2; j++)
+    for (int i = 0; i < 2; i++) v[k][j][i] = decodeFarField(field, code[k][j][i]);
+    float x00 = v[0][0][0] * (1.0f - t.x) + v[0][0][1] * t.x;
+    float x10 = v[0][1][0] * (1.0f - t.x) + v[0][1][1] * t.x;
+    float x01 = v[1][0][0] * (1.0f - t.x) + v[1][0][1] * t.x;
+    float x11 = v[1][1][0] * (1.0f - t.x) + v[1][1][1] * t.x;
+    float y0 = x00 * (1.0f - t.y) + x10 * t.y;
+    float y1 = x01 * (1.0f - t.y) + x11 * t.y;
+    float value = y0 * (1.0f - t.z) + y1 * t.z;
+
+    // Distância do ponto às células vizinhas, ponderada pelos pesos
+    vec3 s = {0.5f - std::fabs(t.x - 0.5f), 0.5f - std::fabs(t.y - 0.5f), 0.5f - std::fabs(t.z - 0.5f)};
+    float correction = s.x * (0.5f - s.x) * cellSize.x + s.y * (0.5f - s.y) * cellSize.y + s.z * (0.5f - s.z) * cellSize.z;
+    float own = v[t.z >= 0.5f][t.y >= 0.5f][t.x >= 0.5f];
+    return std::max(value - correction, own);
+}
+
+/**
+ * @brief SDF evaluation with the pruning grid and the quantized far-fields.
+ *
+ * Same as sdf() of full3DTreePruningQuantized.frag.
+ *
+ * @param [in] p 3D space position inside the grid.
+ * @param [in] scene Scene with primitives and binary operations.
+ * @param [in] grid Pruning grid.
+ * @param [in] field Quantized far-field values of the grid.
+ * @return The SDF value at the position.
+ */
+float sdfGridQuantized(vec3 p, const Scene& scene, const PruningGrid& grid, const QuantizedFarField& field){
+    int cellIndex = getGridCellIndex(p, grid);
+    const CellInfo& cell = grid.cells[cellIndex];
+    if (cell.size == 0) {
+        return sdfQuantizedFarField(p, field);
+    }
+    return sdf(p, scene, grid.nodes.data() + cell.offset, cell.size);
+}
+
+#endif
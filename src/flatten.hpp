@@ -0,0 +1,123 @@
+/**
+ * @file flatten.hpp
+ * @brief Flattening of binary operation chains into n-ary nodes.
+ *
+ * A chain of the same operation, like min(min(a, b), min(c, d)), becomes one NODE_NARY node
+ * with the operands a, b, c, d. The tree gets fewer nodes, and the pruning can drop each
+ * operand on its own instead of one side of a binary node. The evaluators fold each operand
+ * into a running accumulator as soon as it is computed (see pushValue), so the evaluation
+ * stack is never deeper than the one of the binary tree. Hard operations (k = 0) are
+ * associative, so any operand with the same operation is opened. A smooth operation is only a
+ * left fold, so only the left-deep chain op(op(a, b), c) is opened and the n-ary node keeps
+ * the same value.
+ *
+ * The children of an n-ary node are found by their parent field (see getSubtreeStarts). The
+ * pruning passes still keep all operands of a node on their stack, since each operand is
+ * compared with the others, which is why the arity is capped.
+ *
+ * @author Edson Martinelli
+ * @date 2026
+ */
+
+#ifndef FLATTEN_HPP
+#define FLATTEN_HPP
+
+#include <vector>
+#include "shape.hpp"
+#include "bounds.hpp"
+
+const int NARY_MAX = 16; /**< Maximum operands of one n-ary node, bounds the stack of the pruning passes. */
+
+/**
+ * @brief Collect the operands of a chain.
+ *
+ * The operands are opened one level at a time, so a balanced chain stays balanced and the
+ * stack of the pruning passes grows by at most NARY_MAX - 1 values per level.
+ *
+ * @param [in] scene Scene with binary operations.
+ * @param [in] nodes Post-order node array.
+ * @param [in] start First node of each subtree (see getSubtreeStarts).
+ * @param [in] root Node being opened.
+ * @param [out] operands Roots of the collected operands, left to right.
+ */
+void collectOperands(const Scene& scene, const Node* nodes, const std::vector<int>& start, int root,
+                     std::vector<int>& operands){
+    const BinaryOperation& op = scene.binaryOperations[nodes[root].index];
+    getChildren(start, root, operands);
+
+    std::vector<int> children;
+    std::vector<int> next;
+    bool opened = true;
+    while (opened) {
+        opened = false;
+        next.clear();
+        int count = operands.size();
+        for (int j = 0; j < (int)operands.size(); j++) {
+            int operand = operands[j];
+            const Node& node = nodes[operand];
+            // Smooth só é dobra à esquerda: abre apenas o primeiro operando
+            if (node.type != NODE_PRIMITIVE && node.sign == 1 && (op.k == 0 || j == 0)) {
+                const BinaryOperation& childOp = scene.binaryOperations[node.index];
+                getChildren(start, operand, children);
+                if (childOp.k == op.k && childOp.s == op.s && count - 1 + (int)children.size() <= NARY_MAX) {
+                    next.insert(next.end(), children.begin(), children.end());
+                    count += children.size() - 1;
+                    opened = true;
+                    continue;
+                }
+            }
+            next.push_back(operand);
+        }
+        operands.swap(next);
+    }
+}
+
+/**
+ * @brief Append the flattened subtree in post-order.
+ *
+ * @param [in] scene Scene with binary operations.
+ * @param [in] nodes Post-order node array.
+ * @param [in] start First node of each subtree (see getSubtreeStarts).
+ * @param [in] root Subtree root.
+ * @param [out] flat Flattened tree.
+ * @return Index of the subtree root in the flattened tree.
+ */
+int emitFlat(const Scene& scene, const Node* nodes, const std::vector<int>& start, int root, std::vector<Node>& flat){
+    Node node = nodes[root];
+    if (node.type == NODE_PRIMITIVE) {
+        node.parent = -1;
+        flat.push_back(node);
+        return flat.size() - 1;
+    }
+
+    std::vector<int> operands;
+    collectOperands(scene, nodes, start, root, operands);
+
+    std::vector<int> roots;
+    for (int operand : operands) roots.push_back(emitFlat(scene, nodes, start, operand, flat));
+
+    int index = flat.size();
+    for (int r : roots) flat[r].parent = index;
+    node.type = operands.size() > 2 ? NODE_NARY : NODE_BINARY;
+    node.parent = -1;
+    flat.push_back(node);
+    return index;
+}
+
+/**
+ * @brief Flatten the operation chains of a post-order tree.
+ *
+ * @param [in] scene Scene with binary operations.
+ * @param [in] nodes Post-order node array (binary or already flattened).
+ * @param [out] flat Flattened tree with the parents recomputed.
+ */
+void flattenTree(const Scene& scene, const std::vector<Node>& nodes, std::vector<Node>& flat){
+    flat.clear();
+    if (nodes.empty()) return;
+    std::vector<int> start;
+    getSubtreeStarts(nodes.data(), nodes.size(), start);
+    flat.reserve(nodes.size());
+    emitFlat(scene, nodes.data(), start, nodes.size() - 1, flat);
+}
+
+#endif
@@ -0,0 +1,233 @@
+/**
+ * @file governor.hpp
+ * @brief Frame-time governor: render scale, ray steps and hit epsilon against a frame time target.
+ *
+ * The governor is fed the time of each frame: the latest GPU time read by the pass timers
+ * (march and upscale), or the CPU frame time when larger (software renderers such as llvmpipe
+ * do the work outside the timestamps). Once GOVERNOR_WINDOW frames rendered with the current
+ * settings were fed, it compares their mean with the target. Above the target by more than the hysteresis it lowers the
+ * quality, below by more than the hysteresis it raises it, always one knob per decision:
+ *
+ * - lowering: first the render scale (the cost follows the pixel count, so the scale moves by
+ *   the square root of target / measured, at most GOVERNOR_SCALE_CHANGE per decision), then the
+ *   hit epsilon (doubled, the rays stop sooner near the surfaces), then the ray steps (times
+ *   GOVERNOR_STEPS_FACTOR, the rays at grazing angles give up sooner);
+ * - raising: the same knobs in the reverse order, so the last knob lowered is the first restored.
+ *
+ * Every knob stays inside its bounds and starts at the best quality (scale and steps at the
+ * maximum, epsilon at the minimum, the values of the shaders). The first GOVERNOR_SETTLE frames
+ * and, after a change, the frames still in flight with the old settings are discarded. Every
+ * decision is kept with the measurement that caused it and can be written as CSV.
+ *
+ * @author Edson Martinelli
+ * @date 2026
+ */
+
+#ifndef GOVERNOR_HPP
+#define GOVERNOR_HPP
+
+#include <cmath>
+#include <cstdio>
+#include <vector>
+#include <algorithm>
+
+const int GOVERNOR_WINDOW = 8; /**< Frames averaged per decision. */
+const int GOVERNOR_SETTLE = 8; /**< Frames discarded at the start and after a change (GPU_TIMER_RING, the GPU timer results in flight). */
+const double GOVERNOR_HYSTERESIS = 0.1; /**< Relative distance to the target that keeps the settings. */
+const float GOVERNOR_SCALE_CHANGE = 0.25f; /**< Largest relative scale change per decision. */
+const float GOVERNOR_STEPS_FACTOR = 0.75f; /**< Ray steps multiplier when lowering the quality. */
+const float GOVERNOR_EPSILON_FACTOR = 2.0f; /**< Hit epsilon multiplier when lowering the quality. */
+
+/**
+ * @brief Bounds of the knobs.
+ */
+struct GovernorBounds{
+    float minScale = 0.5f; /**< Smallest render scale (fraction of the window side). */
+    float maxScale = 1.0f; /**< Largest render scale. */
+    float minSteps = 64.0f; /**< Fewest ray steps. */
+    float maxSteps = 256.0f; /**< Most ray steps (MAX_STEP of the shaders). */
+    float minEpsilon = 0.0001f; /**< Smallest hit epsilon (e of the shaders). */
+    float maxEpsilon = 0.001f; /**< Largest hit epsilon. */
+};
+
+/**
+ * @brief Settings change and the measurement behind it.
+ */
+struct GovernorDecision{
+    long frame; /**< Frame of the decision. */
+    double time; /**< Seconds since the start. */
+    double measured; /**< Mean frame time of the window in ms. */
+    const char* action; /**< Knob moved. */
+    float scale; /**< New render scale. */
+    int renderWidth; /**< Render width at the new scale. */
+    int renderHeight; /**< Render height at the new scale. */
+    float maxSteps; /**< New ray steps. */
+    float epsilon; /**< New hit epsilon. */
+};
+
+/**
+ * @brief Governor state.
+ */
+struct Governor{
+    double target = 0.0; /**< Target time per frame in ms (0 disables the governor). */
+    GovernorBounds bounds; /**< Knob bounds. */
+    float scale = 1.0f; /**< Render scale. */
+    float maxSteps = 256.0f; /**< Ray steps. */
+    float epsilon = 0.0001f; /**< Hit epsilon. */
+    int settle = 0; /**< Samples still to discard after a change. */
+    std::vector<double> window; /**< Samples of the current settings. */
+    std::vector<GovernorDecision> decisions; /**< Every change. */
+};
+
+/**
+ * @brief Start the governor at the best quality.
+ *
+ * @param [out] governor Governor.
+ * @param [in] target Target time per frame in ms.
+ * @param [in] bounds Knob bounds.
+ */
+void initGovernor(Governor& governor, double target, const GovernorBounds& bounds){
+    governor = Governor();
+    governor.target = target;
+    governor.bounds = bounds;
+    governor.scale = bounds.maxScale;
+    governor.maxSteps = bounds.maxSteps;
+    governor.epsilon = bounds.minEpsilon;
+    // Os primeiros quadros também pagam o pruning e a compilação no driver
+    governor.settle = GOVERNOR_SETTLE;
+}
+
+/**
+ * @brief Render size of a window at the current scale.
+ *
+ * @param [in] governor Governor.
+ * @param [in] width Window width.
+ * @param [in] height Window height.
+ * @param [out] renderWidth Render width (at least 1).
+ * @param [out] renderHeight Render height (at least 1).
+ */
+void getGovernorSize(const Governor& governor, int width, int height, int& renderWidth, int& renderHeight){
+    renderWidth = std::max(1, (int)std::lround(width * governor.scale));
+    renderHeight = std::max(1, (int)std::lround(height * governor.scale));
+}
+
+/**
+ * @brief Lower the quality by one knob.
+ *
+ * @param [in,out] governor Governor.
+ * @param [in] measured Mean frame time in ms.
+ * @return Knob moved, or null when every knob is at its bound.
+ */
+const char* lowerGovernorQuality(Governor& governor, double measured){
+    const GovernorBounds& bounds = governor.bounds;
+    if (governor.scale > bounds.minScale) {
+        float factor = std::max((float)std::sqrt(governor.target / measured), 1.0f - GOVERNOR_SCALE_CHANGE);
+        governor.scale = std::max(governor.scale * factor, bounds.minScale);
+        return "scale down";
+    }
+    if (governor.epsilon < bounds.maxEpsilon) {
+        governor.epsilon = std::min(governor.epsilon * GOVERNOR_EPSILON_FACTOR, bounds.maxEpsilon);
+        return "epsilon up";
+    }
+    if (governor.maxSteps > bounds.minSteps) {
+        governor.maxSteps = std::max(std::round(governor.maxSteps * GOVERNOR_STEPS_FACTOR), bounds.minSteps);
+        return "steps down";
+    }
+    return nullptr;
+}
+
+/**
+ * @brief Raise the quality by one knob (the reverse order of lowerGovernorQuality()).
+ *
+ * @param [in,out] governor Governor.
+ * @param [in] measured Mean frame time in ms.
+ * @return Knob moved, or null when every knob is at its bound.
+ */
+const char* raiseGovernorQuality(Governor& governor, double measured){
+    const GovernorBounds& bounds = governor.bounds;
+    if (governor.maxSteps < bounds.maxSteps) {
+        governor.maxSteps = std::min(std::round(governor.maxSteps / GOVERNOR_STEPS_FACTOR), bounds.maxSteps);
+        return "steps up";
+    }
+    if (governor.epsilon > bounds.minEpsilon) {
+        governor.epsilon = std::max(governor.epsilon / GOVERNOR_EPSILON_FACTOR, bounds.minEpsilon);
+        return "epsilon down";
+    }
+    if (governor.scale < bounds.maxScale) {
+        float factor = std::min((float)std::sqrt(governor.target / measured), 1.0f + GOVERNOR_SCALE_CHANGE);
+        governor.scale = std::min(governor.scale * factor, bounds.maxScale);
+        return "scale up";
+    }
+    return nullptr;
+}
+
+/**
+ * @brief Feed the time of a frame and decide.
+ *
+ * @param [in,out] governor Governor.
+ * @param [in] frameMs Time of the frame in ms.
+ * @param [in] frame Current frame.
+ * @param [in] time Seconds since the start.
+ * @param [in] width Window width.
+ * @param [in] height Window height.
+ * @return True when the settings changed.
+ */
+bool updateGovernor(Governor& governor, double frameMs, long frame, double time, int width, int height){
+    if (governor.settle > 0) {
+        governor.settle--;
+        return false;
+    }
+    governor.window.push_back(frameMs);
+    if ((int)governor.window.size() < GOVERNOR_WINDOW) return false;
+
+    double measured = 0.0;
+    for (double sample : governor.window) measured += sample;
+    measured /= governor.window.size();
+    governor.window.clear();
+
+    const char* action = nullptr;
+    if (measured > governor.target * (1.0 + GOVERNOR_HYSTERESIS)) action = lowerGovernorQuality(governor, measured);
+    else if (measured < governor.target * (1.0 - GOVERNOR_HYSTERESIS)) action = raiseGovernorQuality(governor, measured);
+    if (action == nullptr) return false;
+
+    // Os quadros em voo ainda usam os valores antigos
+    governor.settle = GOVERNOR_SETTLE;
+    int renderWidth, renderHeight;
+    getGovernorSize(governor, width, height, renderWidth, renderHeight);
+    governor.decisions.push_back({frame, time, measured, action, governor.scale, renderWidth, renderHeight,
+                                  governor.maxSteps, governor.epsilon});
+    return true;
+}
+
+/**
+ * @brief Print a decision.
+ *
+ * @param [in] governor Governor.
+ * @param [in] decision Decision.
+ */
+void printGovernorDecision(const Governor& governor, const GovernorDecision& decision){
+    std::printf("Governador: quadro %ld, %.3f ms (alvo %.3f ms), %s: escala %.3f (%dx%d), %.0f passos, epsilon %g\n",
+                decision.frame, decision.measured, governor.target, decision.action, decision.scale,
+                decision.renderWidth, decision.renderHeight, decision.maxSteps, decision.epsilon);
+}
+
+/**
+ * @brief Write the decisions as CSV.
+ *
+ * @param [in] path File path.
+ * @param [in] governor Governor.
+ * @return False if the file could not be written.
+ */
+bool writeGovernorLog(const char* path, const Governor& governor){
+    FILE* file = std::fopen(path, "w");
+    if (file == nullptr) return false;
+    std::fprintf(file, "frame,time_s,measured_ms,target_ms,action,scale,render_width,render_height,max_steps,epsilon\n");
+    for (const GovernorDecision& decision : governor.decisions) {
+        std::fprintf(file, "%ld,%.4f,%.4f,%.4f,%s,%.4f,%d,%d,%.0f,%g\n", decision.frame, decision.time, decision.measured,
+                     governor.target, decision.action, decision.scale, decision.renderWidth, decision.renderHeight,
+                     decision.maxSteps, decision.epsilon);
+    }
+    return std::fclose(file) == 0;
+}
+
+#endif
@@ -0,0 +1,198 @@
+/**
+ * @file gputimer.hpp
+ * @brief Non-blocking GPU pass timers.
+ *
+ * Each pass has a ring of GPU_TIMER_RING pairs of GL_TIMESTAMP queries. A pass writes one pair
+ * per run, and collectGpuTimer() reads the pairs whose result is already available, in issue
+ * order, without waiting, so the CPU never stalls on the GPU: the values arrive some frames
+ * later. If a pass wraps around the ring before its oldest pair is available, that sample is
+ * dropped (and counted) instead of waiting. The cost per pass is two query commands, so the
+ * timers can stay on outside the benchmarks. With a trace (traceGpuTimer), every pair read is
+ * also a GPU zone of the timeline.
+ *
+ * @author Edson Martinelli
+ * @date 2026
+ */
+
+#ifndef GPUTIMER_HPP
+#define GPUTIMER_HPP
+
+#include <glad/glad.h>
+#include <string>
+#include <vector>
+#include "trace.hpp"
+
+const int GPU_TIMER_RING = 8; /**< Timestamp pairs in flight per pass. */
+
+/**
+ * @brief Timers of the GPU passes.
+ */
+struct GpuTimer{
+    std::vector<std::string> names; /**< Pass names. */
+    std::vector<GLuint> queries; /**< GPU_TIMER_RING begin/end pairs per pass. */
+    std::vector<char> recording; /**< Keep the sample of each pair in samples. */
+    std::vector<long> issued; /**< Pairs written per pass. */
+    std::vector<long> collected; /**< Pairs read or dropped per pass. */
+    std::vector<double> latest; /**< Last time read per pass in ms (-1 before the first). */
+    std::vector<double> total; /**< Sum of the times read per pass in ms. */
+    std::vector<long> count; /**< Times read per pass. */
+    std::vector<long> dropped; /**< Samples lost to a full ring per pass. */
+    std::vector<std::vector<double>> samples; /**< Times of the pairs issued while recording. */
+    bool record = false; /**< New pairs keep their sample. */
+    Trace* trace = nullptr; /**< Timeline of the pairs read, null when not tracing. */
+    GLint64 traceOrigin = 0; /**< GPU timestamp at the trace time traceStart. */
+    double traceStart = 0.0; /**< Trace time in microseconds of traceOrigin. */
+};
+
+/**
+ * @brief Add a pass.
+ *
+ * @param [in,out] timer GPU timers.
+ * @param [in] name Pass name.
+ * @return Index of the pass.
+ */
+int addGpuPass(GpuTimer& timer, const std::string& name){
+    int pass = timer.names.size();
+    timer.names.push_back(name);
+    timer.queries.resize(timer.queries.size() + GPU_TIMER_RING * 2);
+    glGenQueries(GPU_TIMER_RING * 2, &timer.queries[pass * GPU_TIMER_RING * 2]);
+    timer.recording.resize(timer.recording.size() + GPU_TIMER_RING, 0);
+    timer.issued.push_back(0);
+    timer.collected.push_back(0);
+    timer.latest.push_back(-1.0);
+    timer.total.push_back(0.0);
+    timer.count.push_back(0);
+    timer.dropped.push_back(0);
+    timer.samples.emplace_back();
+    return pass;
+}
+
+/**
+ * @brief Query of a pair.
+ *
+ * @param [in] timer GPU timers.
+ * @param [in] pass Pass index.
+ * @param [in] pair Pair number (issue order).
+ * @param [in] end End (1) or begin (0) query.
+ * @return The query name.
+ */
+GLuint getGpuQuery(const GpuTimer& timer, int pass, long pair, int end){
+    return timer.queries[(pass * GPU_TIMER_RING + pair % GPU_TIMER_RING) * 2 + end];
+}
+
+/**
+ * @brief Read the available pairs of a pass.
+ *
+ * @param [in,out] timer GPU timers.
+ * @param [in] pass Pass index.
+ * @param [in] wait Wait for every issued pair (end of the run only).
+ */
+void collectGpuPass(GpuTimer& timer, int pass, bool wait){
+    while (timer.collected[pass] < timer.issued[pass]) {
+        long pair = timer.collected[pass];
+        GLint available = GL_TRUE;
+        if (!wait) glGetQueryObjectiv(getGpuQuery(timer, pass, pair, 1), GL_QUERY_RESULT_AVAILABLE, &available);
+        if (available == GL_FALSE) break;
+
+        GLuint64 begin, end;
+        glGetQueryObjectui64v(getGpuQuery(timer, pass, pair, 0), GL_QUERY_RESULT, &begin);
+        glGetQueryObjectui64v(getGpuQuery(timer, pass, pair, 1), GL_QUERY_RESULT, &end);
+        double ms = (end - begin) / 1000000.0;
+        if (timer.trace != nullptr && timer.trace->enabled) {
+            double start = timer.traceStart + ((GLint64)begin - timer.traceOrigin) / 1000.0;
+            addTraceEvent(*timer.trace, timer.names[pass], "gpu", start, ms * 1000.0, TRACE_GPU_THREAD);
+        }
+        timer.latest[pass] = ms;
+        timer.total[pass] += ms;
+        timer.count[pass]++;
+        if (timer.recording[pass * GPU_TIMER_RING + pair % GPU_TIMER_RING]) timer.samples[pass].push_back(ms);
+        timer.collected[pass]++;
+    }
+}
+
+/**
+ * @brief Start a pass run.
+ *
+ * @param [in,out] timer GPU timers.
+ * @param [in] pass Pass index.
+ */
+void beginGpuPass(GpuTimer& timer, int pass){
+    // Anel cheio: descarta o par mais antigo em vez de esperar a GPU
+    collectGpuPass(timer, pass, false);
+    if (timer.issued[pass] - timer.collected[pass] >= GPU_TIMER_RING) {
+        timer.collected[pass]++;
+        timer.dropped[pass]++;
+    }
+    long pair = timer.issued[pass];
+    timer.recording[pass * GPU_TIMER_RING + pair % GPU_TIMER_RING] = timer.record;
+    glQueryCounter(getGpuQuery(timer, pass, pair, 0), GL_TIMESTAMP);
+}
+
+/**
+ * @brief End a pass run.
+ *
+ * @param [in,out] timer GPU timers.
+ * @param [in] pass Pass index.
+ */
+void endGpuPass(GpuTimer& timer, int pass){
+    glQueryCounter(getGpuQuery(timer, pass, timer.issued[pass], 1), GL_TIMESTAMP);
+    timer.issued[pass]++;
+}
+
+/**
+ * @brief Send the pairs read from now on to a trace.
+ *
+ * Matches the GPU clock with the trace clock at the call (GL_TIMESTAMP of the current
+ * commands), so the GPU zones are placed on the CPU timeline.
+ *
+ * @param [in,out] timer GPU timers.
+ * @param [in] trace Started trace.
+ */
+void traceGpuTimer(GpuTimer& timer, Trace& trace){
+    timer.trace = &trace;
+    glGetInteger64v(GL_TIMESTAMP, &timer.traceOrigin);
+    timer.traceStart = getTraceTime(trace);
+}
+
+/**
+ * @brief Read the available results of every pass without waiting.
+ *
+ * @param [in,out] timer GPU timers.
+ */
+void collectGpuTimer(GpuTimer& timer){
+    for (int pass = 0; pass < (int)timer.names.size(); pass++) collectGpuPass(timer, pass, false);
+}
+
+/**
+ * @brief Check if some issued result was not read yet.
+ *
+ * @param [in] timer GPU timers.
+ * @return True while a pass has pairs in flight.
+ */
+bool isGpuTimerPending(const GpuTimer& timer){
+    for (int pass = 0; pass < (int)timer.names.size(); pass++) {
+        if (timer.collected[pass] < timer.issued[pass]) return true;
+    }
+    return false;
+}
+
+/**
+ * @brief Wait for and read every issued result (end of a run).
+ *
+ * @param [in,out] timer GPU timers.
+ */
+void finishGpuTimer(GpuTimer& timer){
+    for (int pass = 0; pass < (int)timer.names.size(); pass++) collectGpuPass(timer, pass, true);
+}
+
+/**
+ * @brief Delete the queries.
+ *
+ * @param [in,out] timer GPU timers.
+ */
+void freeGpuTimer(GpuTimer& timer){
+    if (!timer.queries.empty()) glDeleteQueries(timer.queries.size(), timer.queries.data());
+    timer = GpuTimer();
+}
+
+#endif
@@ -0,0 +1,111 @@
+/**
+ * @file image.hpp
+ * @brief 8 bit RGB images, PPM files and image comparison.
+ *
+ * Images keep their rows bottom to top like gl_FragCoord and glReadPixels, and are flipped
+ * when written to or read from binary PPM (P6) files. Two images of the same size are compared
+ * by the absolute difference of their channels, so a shader variant can be checked against the
+ * CPU reference of render.hpp.
+ *
+ * @author Edson Martinelli
+ * @date 2026
+ */
+
+#ifndef IMAGE_HPP
+#define IMAGE_HPP
+
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+#include <algorithm>
+
+/**
+ * @brief RGB image.
+ */
+struct Image{
+    int width = 0; /**< Image width. */
+    int height = 0; /**< Image height. */
+    std::vector<unsigned char> pixels; /**< RGB bytes, rows from the bottom. */
+};
+
+/**
+ * @brief Difference between two images.
+ */
+struct ImageDiff{
+    double meanError = 0.0; /**< Mean absolute channel difference, in [0, 255]. */
+    int maxError = 0; /**< Largest absolute channel difference. */
+    double differentFraction = 0.0; /**< Fraction of pixels with a channel above the tolerance. */
+};
+
+/**
+ * @brief Write an image as binary PPM.
+ *
+ * @param [in] path File path.
+ * @param [in] image Image.
+ * @return False if the file could not be written.
+ */
+bool writeImage(const char* path, const Image& image){
+    FILE* file = std::fopen(path, "wb");
+    if (file == nullptr) return false;
+    std::fprintf(file, "P6\n%d %d\n255\n", image.width, image.height);
+    for (int y = image.height - 1; y >= 0; y--) {
+        std::fwrite(image.pixels.data() + (size_t)y * image.width * 3, 1, (size_t)image.width * 3, file);
+    }
+    return std::fclose(file) == 0;
+}
+
+/**
+ * @brief Read a binary PPM image with 255 as maximum value.
+ *
+ * @param [in] path File path.
+ * @param [out] image Image.
+ * @return False if the file does not exist or is not a binary PPM.
+ */
+bool readImage(const char* path, Image& image){
+    FILE* file = std::fopen(path, "rb");
+    if (file == nullptr) return false;
+    int maximum = 0;
+    bool valid = std::fscanf(file, "P6 %d %d %d", &image.width, &image.height, &maximum) == 3 && maximum == 255 &&
+                 image.width > 0 && image.height > 0 && std::fgetc(file) != EOF;
+    if (valid) {
+        size_t row = (size_t)image.width * 3;
+        image.pixels.resize(row * image.height);
+        for (int y = image.height - 1; y >= 0 && valid; y--) {
+            valid = std::fread(image.pixels.data() + y * row, 1, row, file) == row;
+        }
+    }
+    std::fclose(file);
+    return valid;
+}
+
+/**
+ * @brief Compare two images of the same size.
+ *
+ * @param [in] a First image.
+ * @param [in] b Second image.
+ * @param [in] tolerance Channel difference that still counts as equal.
+ * @param [out] diff Difference.
+ * @return False if the sizes differ.
+ */
+bool compareImages(const Image& a, const Image& b, int tolerance, ImageDiff& diff){
+    diff = ImageDiff();
+    if (a.width != b.width || a.height != b.height || a.pixels.size() != b.pixels.size()) return false;
+    size_t pixelCount = (size_t)a.width * a.height;
+    long long total = 0;
+    size_t different = 0;
+    for (size_t i = 0; i < pixelCount; i++) {
+        int pixelError = 0;
+        for (int c = 0; c < 3; c++) {
+            int error = std::abs((int)a.pixels[i * 3 + c] - (int)b.pixels[i * 3 + c]);
+            total += error;
+            pixelError = std::max(pixelError, error);
+        }
+        diff.maxError = std::max(diff.maxError, pixelError);
+        different += pixelError > tolerance;
+    }
+    diff.meanError = pixelCount > 0 ? (double)total / (pixelCount * 3) : 0.0;
+    diff.differentFraction = pixelCount > 0 ? (double)different / pixelCount : 0.0;
+    return true;
+}
+
+#endif
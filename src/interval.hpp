@@ -0,0 +1,238 @@
+/**
+ * @file interval.hpp
+ * @brief Interval arithmetic over the post-order node tree.
+ *
+ * Bounds of the primitive SDFs and of the binary operations over a whole box, used by the
+ * interval pruning mode. Every function returns an interval that contains all values of the
+ * corresponding function of evaluator.hpp for points inside the box.
+ *
+ * @author Edson Martinelli
+ * @date 2026
+ */
+
+#ifndef INTERVAL_HPP
+#define INTERVAL_HPP
+
+#include <cmath>
+#include <algorithm>
+#include "shape.hpp"
+#include "vector.hpp"
+#include "evaluator.hpp"
+
+const float PI = 3.14159265358979f; /**< Pi constant. */
+
+/**
+ * @brief Closed interval [lo, hi].
+ */
+struct interval{
+    float lo; /**< Lower bound. */
+    float hi; /**< Upper bound. */
+};
+
+inline interval operator+(interval a, interval b){ return {a.lo + b.lo, a.hi + b.hi}; }
+inline interval operator+(interval a, float s){ return {a.lo + s, a.hi + s}; }
+inline interval operator-(interval a, float s){ return {a.lo - s, a.hi - s}; }
+inline interval operator-(interval a){ return {-a.hi, -a.lo}; }
+inline interval operator*(interval a, float s){ return s >= 0.0f ? interval{a.lo * s, a.hi * s} : interval{a.hi * s, a.lo * s}; }
+
+/**
+ * @brief Absolute value of an interval.
+ *
+ * @param [in] a Interval.
+ * @return Interval of |x| for x in a.
+ */
+inline interval abs(interval a){
+    if (a.lo >= 0.0f) return a;
+    if (a.hi <= 0.0f) return -a;
+    return {0.0f, std::max(-a.lo, a.hi)};
+}
+
+/**
+ * @brief Length of a 2D vector with interval components.
+ *
+ * @param [in] x Interval of the X component.
+ * @param [in] y Interval of the Y component.
+ * @return Interval of the vector length.
+ */
+inline interval length(interval x, interval y){
+    vec2 nearest = {std::clamp(0.0f, x.lo, x.hi), std::clamp(0.0f, y.lo, y.hi)};
+    vec2 farthest = {std::max(std::fabs(x.lo), std::fabs(x.hi)), std::max(std::fabs(y.lo), std::fabs(y.hi))};
+    return {length(nearest), length(farthest)};
+}
+
+/**
+ * @brief Sine of an interval.
+ *
+ * @param [in] a Interval.
+ * @return Interval of sin(x) for x in a.
+ */
+inline interval sin(interval a){
+    if (a.hi - a.lo >= 2.0f * PI) return {-1.0f, 1.0f};
+    interval r = {std::min(std::sin(a.lo), std::sin(a.hi)), std::max(std::sin(a.lo), std::sin(a.hi))};
+    // Picos em pi/2 + 2pi*n e vales em -pi/2 + 2pi*n dentro do intervalo.
+    float peak = PI * 0.5f + 2.0f * PI * std::ceil((a.lo - PI * 0.5f) / (2.0f * PI));
+    float valley = -PI * 0.5f + 2.0f * PI * std::ceil((a.lo + PI * 0.5f) / (2.0f * PI));
+    if (peak <= a.hi) r.hi = 1.0f;
+    if (valley <= a.hi) r.lo = -1.0f;
+    return r;
+}
+
+/**
+ * @brief Cosine of an interval.
+ *
+ * @param [in] a Interval.
+ * @return Interval of cos(x) for x in a.
+ */
+inline interval cos(interval a){
+    return sin(a + PI * 0.5f);
+}
+
+/**
+ * @brief Extrusion operation over intervals.
+ *
+ * opExtrusion is non-decreasing in the 2D value and in |z| - h, so the bounds come from the
+ * interval ends.
+ *
+ * @param [in] z Interval of the Z coordinate.
+ * @param [in] sdf Interval of the 2D SDF.
+ * @param [in] h Extrusion size.
+ * @return Interval of the 3D SDF.
+ */
+interval opExtrusion(interval z, interval sdf, float h){
+    interval wy = abs(z) - h;
+    auto extrusion = [](float x, float y){
+        return std::min(std::max(x, y), 0.0f) + length(max(vec2{x, y}, 0.0f));
+    };
+    return {extrusion(sdf.lo, wy.lo), extrusion(sdf.hi, wy.hi)};
+}
+
+/**
+ * @brief Plane cutter SDF over a box.
+ *
+ * @param [in] x Interval of the X coordinate.
+ * @param [in] y Interval of the Y coordinate.
+ * @param [in] z Interval of the Z coordinate.
+ * @return Interval of the SDF.
+ */
+interval sdPlaneCutter(interval x, interval y, interval z){
+    interval px = x - (-0.82f);
+    interval py = y - 0.245f;
+    interval f = px + sin(py * 9.0f) * 0.09f;
+    interval c = abs(cos(py * 9.0f));
+    interval g = {std::max(std::sqrt(1.0f + 0.6561f * c.lo * c.lo), RAY_EPSILON),
+                  std::max(std::sqrt(1.0f + 0.6561f * c.hi * c.hi), RAY_EPSILON)};
+    interval v;
+    if (f.lo >= 0.0f) {
+        v = {f.lo / g.hi, f.hi / g.lo};
+    } else if (f.hi <= 0.0f) {
+        v = {f.lo / g.lo, f.hi / g.hi};
+    } else {
+        v = {f.lo / g.lo, f.hi / g.lo};
+    }
+    return opExtrusion(z, v, 0.51f);
+}
+
+/**
+ * @brief Oriented Box SDF over a box.
+ *
+ * The rotation to the box frame is affine, so the rotated coordinates are bounded exactly by
+ * the cell center and the projected half extents.
+ *
+ * @param [in] x Interval of the X coordinate.
+ * @param [in] y Interval of the Y coordinate.
+ * @param [in] z Interval of the Z coordinate.
+ * @param [in] sideOriginCenter Center point of box origin side.
+ * @param [in] m Box slope.
+ * @param [in] xEndCenter X coordenate of the center point of box end side.
+ * @param [in] th Thickness of the box.
+ * @param [in] depth Extrude depth.
+ * @return Interval of the SDF.
+ */
+interval sdOBox(interval x, interval y, interval z, vec2 sideOriginCenter, float m, float xEndCenter, float th, float depth){
+    vec2 sideEndCenter = calculateLinearPoint(sideOriginCenter, m, xEndCenter);
+    float l = length(sideEndCenter - sideOriginCenter);
+    vec2 d = (sideEndCenter - sideOriginCenter) / l;
+    vec2 center = (sideOriginCenter + sideEndCenter) * 0.5f;
+    vec2 c = vec2{(x.lo + x.hi) * 0.5f, (y.lo + y.hi) * 0.5f} - center;
+    vec2 h = {(x.hi - x.lo) * 0.5f, (y.hi - y.lo) * 0.5f};
+
+    float qx = d.x * c.x + d.y * c.y;
+    float qy = -d.y * c.x + d.x * c.y;
+    float rx = std::fabs(d.x) * h.x + std::fabs(d.y) * h.y;
+    float ry = std::fabs(d.y) * h.x + std::fabs(d.x) * h.y;
+    interval ix = abs(interval{qx - rx, qx + rx}) - l * 0.5f;
+    interval iy = abs(interval{qy - ry, qy + ry}) - th;
+
+    auto box = [](float qx, float qy){
+        return length(max(vec2{qx, qy}, 0.0f)) + std::min(std::max(qx, qy), 0.0f);
+    };
+    return opExtrusion(z, {box(ix.lo, iy.lo), box(ix.hi, iy.hi)}, depth);
+}
+
+/**
+ * @brief Circle SDF over a box.
+ *
+ * @param [in] x Interval of the X coordinate.
+ * @param [in] y Interval of the Y coordinate.
+ * @param [in] z Interval of the Z coordinate.
+ * @param [in] offset Circle center.
+ * @param [in] r Circle radius.
+ * @param [in] depth Extrude depth.
+ * @return Interval of the SDF.
+ */
+interval sdCircle(interval x, interval y, interval z, vec2 offset, float r, float depth){
+    interval v = length(x - offset.x, y - offset.y) - r;
+    return opExtrusion(z, v, depth);
+}
+
+/**
+ * @brief Primitive evaluation over a box.
+ *
+ * @param [in] minimum Box minimum point.
+ * @param [in] maximum Box maximum point.
+ * @param [in] pr Primitive.
+ * @return Interval of the primitive SDF inside the box.
+ */
+interval evalPrimitive(vec3 minimum, vec3 maximum, const Primitive& pr){
+    interval x = {minimum.x, maximum.x};
+    interval y = {minimum.y, maximum.y};
+    interval z = {minimum.z, maximum.z};
+    switch (pr.type) {
+        case PRIMITIVE_CYLINDER:
+            return sdCircle(x, y, z, {pr.offsetX, pr.offsetY}, pr.r, pr.depth);
+        case PRIMITIVE_BOX:
+            return sdOBox(x, y, z, {pr.sideCenterX, pr.sideCenterY}, pr.m, pr.xEnd, pr.th, pr.depth);
+        case PRIMITIVE_PLANE_CUTTER:
+            return sdPlaneCutter(x, y, z);
+        case PRIMITIVE_FLOOR:
+            return y + 1.0f;
+        default:
+            return {1e20f, 1e20f};
+    }
+}
+
+/**
+ * @brief Binary operation over intervals.
+ *
+ * d = s * (min(s * a, s * b) - smoothFunction(a, b, k)). The smooth term decreases with
+ * |a - b|, so its bounds come from the smallest and largest gap between the intervals.
+ *
+ * @param [in] a Interval of the left value.
+ * @param [in] b Interval of the right value.
+ * @param [in] k Smooth radius.
+ * @param [in] s Operation (1 min, -1 max).
+ * @return Interval of the operation.
+ */
+interval evalBinary(interval a, interval b, float k, int s){
+    float gapMin = std::max(0.0f, std::max(a.lo - b.hi, b.lo - a.hi));
+    float gapMax = std::max(a.hi - b.lo, b.hi - a.lo);
+    float smoothMax = smoothFunction(gapMin, 0.0f, k);
+    float smoothMin = smoothFunction(gapMax, 0.0f, k);
+
+    interval sa = a * (float)s;
+    interval sb = b * (float)s;
+    interval d = {std::min(sa.lo, sb.lo) - smoothMax, std::min(sa.hi, sb.hi) - smoothMin};
+    return d * (float)s;
+}
+
+#endif
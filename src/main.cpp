@@ -4,7 +4,8 @@
  *
  * Main project file. This setup the libraries GLFW (window manager)
  * and GLAD (OpenGL Loader), create vertices to render, load shaders and
- * create the application main loop.
+ * create the application main loop. Built with USE_HEADLESS_CONTEXT=1 it renders
+ * into a framebuffer of a headless EGL context instead of a window (context.hpp).
  * 
  * @author Edson Martinelli
  * @date 2025
@@ -19,22 +20,78 @@
 #include <cmath>
 #include <vector>
 #include <array>
+#include <cstdlib>
 
 #include "shape.hpp"
-
-#define CALCULATE_FPS 0 /**< Define if the program will calculate FPS (1) or not (0)*/
-#define CALCULATE_SHADER_TIME 0 /**< Define if the program will calculate fragment shader time (1) or not (0). It blocks the CPU, just for Benchmark.*/
-#define CALCULATE_COMPUTE_SHADER_TIME 1 /**< Define if the program will calculate compute shader time (1) or not (0). It blocks the CPU, just for Benchmark.*/
+#include "bounds.hpp"
+#include "tape.hpp"
+#include "flatten.hpp"
+#include "brickmap.hpp"
+#include "farfield.hpp"
+#include "stats.hpp"
+#include "gputimer.hpp"
+#include "counters.hpp"
+#include "trace.hpp"
+#include "image.hpp"
+#include "context.hpp"
+#include "usage.hpp"
+#include "governor.hpp"
+#include "upscale.hpp"
+
+#ifndef USE_PRUNING_ALG
 #define USE_PRUNING_ALG 1 /**< Define if the program gonna use pruning algorithm (1) or not (0)*/
+#endif
+#ifndef USE_FAR_FIELDS_ALG
 #define USE_FAR_FIELDS_ALG 1 /**< Define if the program gonna use far-fields algorithm (1) or not (0)*/
+#endif
+#ifndef USE_INTERVAL_ALG
+#define USE_INTERVAL_ALG 0 /**< Define if the far-fields pruning gonna bound the nodes by interval arithmetic over the cell (1) or by the cell center value (0)*/
+#endif
+#ifndef USE_TAPE_ALG
+#define USE_TAPE_ALG 0 /**< Define if the far-fields pruned cells gonna be compiled to instruction tapes (1) or rendered from the node trees (0)*/
+#endif
+#ifndef USE_NARY_ALG
+#define USE_NARY_ALG 0 /**< Define if the operation chains of the tree gonna be flattened into n-ary nodes (1) or kept binary (0)*/
+#endif
+#ifndef USE_BRICK_MAP_ALG
+#define USE_BRICK_MAP_ALG 0 /**< Define if the far-fields pruned cells gonna be baked into a brick map and rendered by trilinear lookups (1) or from the node trees (0)*/
+#endif
+#ifndef USE_QUANTIZED_FAR_FIELDS_ALG
+#define USE_QUANTIZED_FAR_FIELDS_ALG 0 /**< Define the bits of the filtered far-fields texture (8 or 16) or if the far-fields stay in a float buffer (0)*/
+#endif
+#ifndef USE_FAR_FIELD_CORNERS_ALG
+#define USE_FAR_FIELD_CORNERS_ALG 0 /**< Define if the far-fields cells gonna interpolate bounds kept at their corners (1) or use the center bound (0)*/
+#endif
+
+#define USE_COUNTERS_SHADER (USE_PRUNING_ALG && !(USE_FAR_FIELDS_ALG && (USE_TAPE_ALG || USE_BRICK_MAP_ALG || USE_QUANTIZED_FAR_FIELDS_ALG || USE_FAR_FIELD_CORNERS_ALG))) /**< Define if the variant renders with full3DTreePruningFarFields.frag, the marcher with the pixel counters (1) or not (0)*/
 
 int WINDOW_WIDTH = 800; /**< Global window width size. */
 int WINDOW_HEIGHT = 600; /**< Global window height size. */
 
 int GRID_LEVEL = 3; /**< Compute Shader's grid level. */
 
-int SAMPLES = 10;/**< Number of samples for avarage FPS and Shader Time calculte.*/
-double ONE_MINUTE = 60.0; /** Time of each sample. */
+const double TIMER_POLL_INTERVAL = 0.01; /**< Longest wait in seconds while GPU timer results are in flight. */
+
+/**
+ * @brief Command line options.
+ */
+struct Options{
+    bool benchmark = false; /**< Measure frame and shader times and exit (1) or render until the window closes (0). */
+    double warmup = 2.0; /**< Seconds rendered before the measurement. */
+    double duration = 60.0; /**< Maximum measured seconds. */
+    double tolerance = 0.01; /**< Confidence interval half width, relative to the mean, that stops the measurement. */
+    int minFrames = 100; /**< Minimum measured frames. */
+    std::string output; /**< Report path (.json or .csv), empty for standard output only. */
+    std::string counters; /**< Pixel counters report path (.json), empty to skip the counted frame. */
+    std::string trace; /**< Chrome trace path (.json), empty to not trace. */
+    std::string shader; /**< Fragment shader path replacing the one of the variant, empty to keep it. */
+    std::string image; /**< Image path (.ppm) of one more frame, empty to skip it. */
+    bool hidden = false; /**< Render on a window that is not shown. */
+    bool continuous = false; /**< Redraw every iteration (1) or only when the image changes (0); benchmarks are always continuous. */
+    double targetMs = 0.0; /**< Frame time target of the frame-time governor in ms, 0 to render at full quality. */
+    GovernorBounds governorBounds; /**< Bounds of the render scale, ray steps and hit epsilon of the governor. */
+    std::string governorLog; /**< Governor decisions path (.csv), empty to not write them. */
+};
 
 /**
  * @brief Callback function for error handler.
@@ -65,13 +122,14 @@ void errorCallback(int error, const char* description)
 void keyCallback(GLFWwindow* window, int key, int scancode, int action, int mods)
 {
     std::cout << "Key: " << key << std::endl;
+    markWindowDirty(window);
 }
 
 /**
  * @brief Window resize handler function callback.
  * 
  * This used as callback by GLFW when window got resized. This modify WINDOW_WIDTH and WINDOW_HEIGHT
- * globals used in uniforms and change OpenGL viewport to current window size.
+ * globals used in uniforms, change OpenGL viewport to current window size and ask a new frame.
  * 
  * @param window Window pointer to indicate the window resized.
  * @param width Current window width size.
@@ -82,127 +140,198 @@ void framebufferSizeCallback(GLFWwindow* window, int width, int height)
     WINDOW_WIDTH = width;
     WINDOW_HEIGHT = height;
     glViewport(0, 0, WINDOW_WIDTH, (int)WINDOW_HEIGHT);
+    markWindowDirty(window);
 }
 
 
-#if CALCULATE_FPS
 /**
- * @brief Calculate metrics related to FPS.
+ * @brief Print metrics related to Compute Shader time.
  * 
- * Calculate average, variance and standard deviation of FPS samples.
+ * Sum in ms of the pruning level passes, once all of them were read by the GPU timers.
  * 
- * @param [in] FPSamples FPS samples.
+ * @param [in] gpuTimer GPU pass timers.
+ * @param [in] pruningPasses Pass of each pruning level.
+ * @return Compute shader time in ms, or -1 while a level is not read yet.
  */
-void calculteFPSMetrics(double FPSamples[]){
-    double averageFPSSamples = 0;
-    double averageShaderTimeSamples = 0;
-    for(int i = 0; i < SAMPLES; i++){
-        averageFPSSamples += FPSamples[i];
-    }
-    
-    averageFPSSamples = averageFPSSamples / SAMPLES;
-    printf("Média de FPS nas amostras: %.2f\n", averageFPSSamples);
-
-    double varianceFPSSamples = 0;
-    for(int i = 0; i < SAMPLES; i++){
-        double difference = (FPSamples[i] -averageFPSSamples);
-        varianceFPSSamples += difference * difference;
-    }
 
-    varianceFPSSamples =  varianceFPSSamples / SAMPLES;
-    printf("Variância de FPS nas amostras: %.2f\n", varianceFPSSamples);
-    printf("Desvio Padrão de FPS nas amostras: %.2f\n", sqrt(varianceFPSSamples));
+double printComputeShaderMetrics(const GpuTimer& gpuTimer, const std::vector<int>& pruningPasses){
+   if (pruningPasses.empty()) return 0.0;
+   double computeShaderTime = 0.0;
+   for (int pass : pruningPasses) {
+       if (gpuTimer.count[pass] == 0) return -1.0;
+       computeShaderTime += gpuTimer.latest[pass];
+   }
+   printf("Tempo de execução do compute shader: %.4f\n", computeShaderTime);
+   return computeShaderTime;
 }
-#endif
 
-#if CALCULATE_SHADER_TIME
 /**
- * @brief Calculate metrics related to Shader time.
- * 
- * Calculate average, variance and standard deviation of Shader samples.
- * 
- * @param [in] ShaderTimeSamples Shader time samples.
+ * @brief Name of the shader variant selected by the USE_*_ALG defines.
+ *
+ * @return Variant name (the names of gpubench.sh).
  */
-
-void calculteShaderMetrics(double ShaderTimeSamples[]){
-    double averageShaderTimeSamples = 0;
-    for(int i = 0; i < SAMPLES; i++){
-        averageShaderTimeSamples += ShaderTimeSamples[i];
-    }
-    averageShaderTimeSamples = averageShaderTimeSamples / SAMPLES;
-    printf("Média de tempo do shader nas amostras: %.4f\n", averageShaderTimeSamples);
-
-    double varianceShaderTimeSamples = 0;
-    for(int i = 0; i < SAMPLES; i++){
-        double difference = (ShaderTimeSamples[i] - averageShaderTimeSamples);
-        varianceShaderTimeSamples += difference * difference;
-    }
-
-    varianceShaderTimeSamples =  varianceShaderTimeSamples / SAMPLES;
-    printf("Variância de FPS nas amostras: %.4f\n", varianceShaderTimeSamples);
-    printf("Desvio Padrão de FPS nas amostras: %.4f\n", sqrt(varianceShaderTimeSamples));
-}
+std::string getVariantName(){
+#if !USE_PRUNING_ALG
+    std::string name = "full";
+#elif !USE_FAR_FIELDS_ALG
+    std::string name = "pruning";
+#elif USE_TAPE_ALG
+    std::string name = "tape";
+#elif USE_BRICK_MAP_ALG
+    std::string name = "bricks";
+#elif USE_QUANTIZED_FAR_FIELDS_ALG
+    std::string name = "quantized" + std::to_string(USE_QUANTIZED_FAR_FIELDS_ALG);
+#elif USE_FAR_FIELD_CORNERS_ALG
+    std::string name = "corners";
+#elif USE_INTERVAL_ALG
+    std::string name = "intervals";
+#else
+    std::string name = "farfields";
 #endif
+#if USE_NARY_ALG
+    name += "+nary";
+#endif
+    return name;
+}
 
-#if CALCULATE_COMPUTE_SHADER_TIME
 /**
- * @brief Print metrics related to Compute Shader time.
- * 
- * Calculate time in ms of compute shader.
- * 
- * @param [in] timeStart time when the querie start.
- * @param [in] timeEnd  time when the querie end.
+ * @brief Name of the rendered variant.
+ *
+ * @param [in] options Options (the fragment shader that replaces the one of the variant).
+ * @return Variant name, followed by the fragment shader file name when it was replaced.
  */
+std::string getRenderName(const Options& options){
+    if (options.shader.empty()) return getVariantName();
+    std::string file = options.shader.substr(options.shader.find_last_of('/') + 1);
+    return getVariantName() + ":" + file.substr(0, file.find('.'));
+}
 
-void printComputeShaderMetrics(GLuint64 timeStart, GLuint64 timeEnd){
-   double computeShaderTime = (timeEnd - timeStart) / 1000000.0;
-   printf("Tempo de execução do compute shader: %.4f\n", computeShaderTime);
+/**
+ * @brief Read the command line options.
+ *
+ * Options: --benchmark, --hidden, --continuous, --width N, --height N, --grid-level N, --warmup S, --duration S,
+ * --tolerance X, --min-frames N, --output PATH and --counters PATH (both imply --benchmark),
+ * --trace PATH, --shader PATH (fragment shader rendered over the buffers of the variant),
+ * --image PATH, --target-ms X (frame-time governor, implies --continuous) with its bounds
+ * --min-scale X, --min-steps N and --max-epsilon X, and --governor-log PATH.
+ *
+ * @param [in] argc Number of arguments.
+ * @param [in] argv Arguments.
+ * @param [out] options Options read.
+ * @return False if an option is unknown or misses its value.
+ */
+bool parseOptions(int argc, char** argv, Options& options){
+    for (int i = 1; i < argc; i++) {
+        std::string option = argv[i];
+        if (option == "--benchmark") {
+            options.benchmark = true;
+            continue;
+        }
+        if (option == "--hidden") {
+            options.hidden = true;
+            continue;
+        }
+        if (option == "--continuous") {
+            options.continuous = true;
+            continue;
+        }
+        if (i + 1 >= argc) return false;
+        const char* value = argv[++i];
+        if (option == "--width") WINDOW_WIDTH = std::atoi(value);
+        else if (option == "--height") WINDOW_HEIGHT = std::atoi(value);
+        else if (option == "--grid-level") GRID_LEVEL = std::atoi(value);
+        else if (option == "--warmup") options.warmup = std::atof(value);
+        else if (option == "--duration") options.duration = std::atof(value);
+        else if (option == "--tolerance") options.tolerance = std::atof(value);
+        else if (option == "--min-frames") options.minFrames = std::atoi(value);
+        else if (option == "--output") {
+            options.output = value;
+            options.benchmark = true;
+        }
+        else if (option == "--counters") {
+            options.counters = value;
+            options.benchmark = true;
+        }
+        else if (option == "--trace") options.trace = value;
+        else if (option == "--shader") options.shader = value;
+        else if (option == "--image") options.image = value;
+        else if (option == "--target-ms") options.targetMs = std::atof(value);
+        else if (option == "--min-scale") options.governorBounds.minScale = std::atof(value);
+        else if (option == "--min-steps") options.governorBounds.minSteps = std::atof(value);
+        else if (option == "--max-epsilon") options.governorBounds.maxEpsilon = std::atof(value);
+        else if (option == "--governor-log") options.governorLog = value;
+        else return false;
+    }
+    const GovernorBounds& bounds = options.governorBounds;
+    bool validBounds = bounds.minScale > 0.0f && bounds.minScale <= bounds.maxScale && bounds.minSteps >= 1.0f &&
+                       bounds.minSteps <= bounds.maxSteps && bounds.maxEpsilon >= bounds.minEpsilon;
+    return WINDOW_WIDTH > 0 && WINDOW_HEIGHT > 0 && GRID_LEVEL > 0 && validBounds;
 }
-#endif
 
 /**
  * @brief Main function of program to generate image.
  * 
  * Main function: Initialized GLFW and GLAD, setup callback functions, read the shaders, create the vertices
  * square that encompasses the entire viewport and execute the main loop to generate the image in the window.
+ * Outside benchmark mode the loop draws only when the image changes (resize, input, window exposed)
+ * and otherwise blocks waiting for events, reporting the CPU use and power while idle at the end;
+ * --continuous redraws every iteration (for a shader animated by iTimer). With --target-ms the frame-time
+ * governor adjusts the render scale, ray steps and hit epsilon every few frames to meet the target
+ * frame time (only the render scale for a --shader without the MAX_STEP and e uniforms), and the
+ * scene rendered below the window size is upscaled by an edge-aware filter.
+ * In benchmark mode the loop always redraws, measures the frame and shader times after the warmup,
+ * stops when their confidence intervals converge or the duration ends, and writes the report.
  * 
+ * @param [in] argc Number of arguments.
+ * @param [in] argv Arguments (see parseOptions).
  */
-int main() {
-    if (!glfwInit()) {
-        std::cerr << "Failed to initialize GLFW\n";
+int main(int argc, char** argv) {
+    Options options;
+    if (!parseOptions(argc, argv, options)) {
+        std::cerr << "Usage: " << argv[0] << " [--benchmark] [--hidden] [--continuous] [--width N] [--height N] [--grid-level N] [--warmup S]"
+                  << " [--duration S] [--tolerance X] [--min-frames N] [--output file.json|file.csv] [--counters file.json]"
+                  << " [--trace file.json] [--shader file.frag] [--image file.ppm] [--target-ms X] [--min-scale X]"
+                  << " [--min-steps N] [--max-epsilon X] [--governor-log file.csv]\n";
         return -1;
     }
-    glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 4);
-    glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 3);
-    glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
-
-    GLFWwindow* window = glfwCreateWindow(WINDOW_WIDTH, WINDOW_HEIGHT, "PGC - RayMarching", nullptr, nullptr);
-    if (!window) {
-        std::cerr << "Failed to create window\n";
-        glfwTerminate();
-        return -1;
-    }
-    
-    glfwMakeContextCurrent(window);
-    glfwSwapInterval(0);
-    
 
-    if (!gladLoadGLLoader((GLADloadproc)glfwGetProcAddress))
-    {
-        std::cout << "Failed to initialize GLAD" << std::endl;
-        return -1;
-    } 
+    Trace trace;
+    if (!options.trace.empty()) startTrace(trace);
+    TraceScope startupZone(&trace, "startup", "startup");
+    TraceScope contextZone(&trace, "window and context", "startup");
 
-    glfwSetErrorCallback(errorCallback);
-    glfwSetKeyCallback(window, keyCallback);
-    glfwSetFramebufferSizeCallback(window, framebufferSizeCallback);  
+    RenderContext context;
+    if (!createRenderContext(context, WINDOW_WIDTH, WINDOW_HEIGHT, "PGC - RayMarching", options.hidden)) return -1;
 
-    glViewport(0, 0, WINDOW_WIDTH, WINDOW_HEIGHT);
+#if !USE_HEADLESS_CONTEXT
+    glfwSetErrorCallback(errorCallback);
+    glfwSetKeyCallback(context.window, keyCallback);
+    glfwSetFramebufferSizeCallback(context.window, framebufferSizeCallback);
+#endif
+    endTraceScope(contextZone);
 
+    TraceScope shaderZone(&trace, "shader load and compile", "startup");
     unsigned int vertexShader = createShader(GL_VERTEX_SHADER, "src/shaders/vertexshader.vert");
-    unsigned int fragmentShader = createShader(GL_FRAGMENT_SHADER, "src/shaders/lipschitzPruning/full3DTreePruningFarFields.frag");
-    //unsigned int fragmentShader = createShader(GL_FRAGMENT_SHADER, "src/shaders/prototypes/normal.frag");
+#if !USE_PRUNING_ALG
+    const char* fragmentPath = "src/shaders/lipschitzPruning/full3DTree.frag";
+#elif USE_PRUNING_ALG && USE_FAR_FIELDS_ALG && USE_TAPE_ALG
+    const char* fragmentPath = "src/shaders/lipschitzPruning/full3DTreePruningTape.frag";
+#elif USE_PRUNING_ALG && USE_FAR_FIELDS_ALG && USE_BRICK_MAP_ALG
+    const char* fragmentPath = "src/shaders/lipschitzPruning/full3DTreePruningBricks.frag";
+#elif USE_PRUNING_ALG && USE_FAR_FIELDS_ALG && USE_QUANTIZED_FAR_FIELDS_ALG
+    const char* fragmentPath = "src/shaders/lipschitzPruning/full3DTreePruningQuantized.frag";
+#elif USE_PRUNING_ALG && USE_FAR_FIELDS_ALG && USE_FAR_FIELD_CORNERS_ALG
+    const char* fragmentPath = "src/shaders/lipschitzPruning/full3DTreePruningCorners.frag";
+#else
+    const char* fragmentPath = "src/shaders/lipschitzPruning/full3DTreePruningFarFields.frag";
+#endif
+    //const char* fragmentPath = "src/shaders/prototypes/normal.frag";
+    if (!options.shader.empty()) fragmentPath = options.shader.c_str();
+    unsigned int fragmentShader = createShader(GL_FRAGMENT_SHADER, fragmentPath);
     unsigned int shaderProgram = createShaderProgram(vertexShader, fragmentShader); 
+    endTraceScope(shaderZone);
+
+    TraceScope vertexZone(&trace, "vertex buffers", "startup");
 
     float vertices[] = {
         1.0f,  1.0f, 0.0f,
@@ -231,21 +360,44 @@ int main() {
 
     glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 3 * sizeof(float), (void*)0);
     glEnableVertexAttribArray(0);  
+    endTraceScope(vertexZone);
+
 
+    double pruningTime = -1.0;
+    GpuTimer gpuTimer;
+    if (!options.trace.empty()) traceGpuTimer(gpuTimer, trace);
+    std::vector<int> pruningPasses;
+    std::vector<PruningLevelStats> pruningLevels;
 
 #if USE_PRUNING_ALG   
 
+    TraceScope sceneZone(&trace, "scene setup", "startup");
+    struct AABB limits;
     struct AABB aabb;
     std::array<Primitive,13> primitives;
     std::array<BinaryOperation,12> binaryOperations;
-    std::array<Node,25> nodes;
-    std::array<CellInfo,1> cells = {{{.offset = 0, .size = 25}}};
 
     getPrimitivesPost(primitives);
     getBinaryOperationsPost(binaryOperations);
-    getNodesPost(nodes);
-    getAABB(aabb);
+    getAABB(limits);
+
+    Scene scene;
+    getScenePost(scene);
+    #if USE_NARY_ALG
+    std::vector<Node> nodes;
+    flattenTree(scene, scene.nodes, nodes);
+    #else
+    std::vector<Node> nodes = scene.nodes;
+    #endif
+    const int nodesSize = nodes.size();
+    std::array<CellInfo,1> cells = {{{.offset = 0, .size = nodesSize}}};
+
+    std::vector<NodeBound> nodeBounds(nodesSize);
+    computeNodeBounds(scene, nodes.data(), nodesSize, nodeBounds.data());
+    getSceneAABB(nodeBounds[nodesSize - 1], limits, 0.01f, aabb);
+    endTraceScope(sceneZone);
 
+    TraceScope bufferZone(&trace, "buffer allocation", "startup");
     GLuint ssbo[6];
     glGenBuffers(6, ssbo);
 
@@ -270,6 +422,15 @@ int main() {
 
     #endif
 
+    #if USE_FAR_FIELDS_ALG && USE_FAR_FIELD_CORNERS_ALG
+    GLuint farFieldCorners[2];
+    glGenBuffers(2, farFieldCorners);
+    for (int i = 0; i < 2; i++) {
+        glBindBuffer(GL_SHADER_STORAGE_BUFFER, farFieldCorners[i]);
+        glBufferData(GL_SHADER_STORAGE_BUFFER, (1 << (GRID_LEVEL * 2)) * (1 << (GRID_LEVEL * 2)) * (1 << (GRID_LEVEL * 2)) * 8 * sizeof(float), nullptr, GL_DYNAMIC_DRAW);
+    }
+    #endif
+
     GLuint zero = 0;
   
     glBindBuffer(GL_SHADER_STORAGE_BUFFER, ssbo[0]);
@@ -279,15 +440,15 @@ int main() {
     glBufferData(GL_SHADER_STORAGE_BUFFER, 12 * sizeof(binaryOperations.data()[0]), binaryOperations.data(), GL_DYNAMIC_DRAW);
     
     glBindBuffer(GL_SHADER_STORAGE_BUFFER, ssbo[2]);
-    glBufferData(GL_SHADER_STORAGE_BUFFER, (1 << (GRID_LEVEL * 2)) * (1 << (GRID_LEVEL * 2)) * (1 << (GRID_LEVEL * 2)) * 25 * sizeof(Node), nullptr, GL_DYNAMIC_DRAW);
-    glBufferSubData(GL_SHADER_STORAGE_BUFFER, 0, 25 * sizeof(nodes[0]), nodes.data());
+    glBufferData(GL_SHADER_STORAGE_BUFFER, (1 << (GRID_LEVEL * 2)) * (1 << (GRID_LEVEL * 2)) * (1 << (GRID_LEVEL * 2)) * nodesSize * sizeof(Node), nullptr, GL_DYNAMIC_DRAW);
+    glBufferSubData(GL_SHADER_STORAGE_BUFFER, 0, nodesSize * sizeof(nodes[0]), nodes.data());
 
     glBindBuffer(GL_SHADER_STORAGE_BUFFER, ssbo[3]);
     glBufferData(GL_SHADER_STORAGE_BUFFER,  (1 << (GRID_LEVEL * 2)) * (1 << (GRID_LEVEL * 2)) * (1 << (GRID_LEVEL * 2)) * sizeof(CellInfo), nullptr, GL_DYNAMIC_DRAW);
     glBufferSubData(GL_SHADER_STORAGE_BUFFER, 0, sizeof(cells[0]), cells.data());
 
     glBindBuffer(GL_SHADER_STORAGE_BUFFER, ssbo[4]);
-    glBufferData(GL_SHADER_STORAGE_BUFFER, (1 << (GRID_LEVEL * 2)) * (1 << (GRID_LEVEL * 2)) * (1 << (GRID_LEVEL * 2)) * 25 * sizeof(Node), nullptr, GL_DYNAMIC_DRAW);
+    glBufferData(GL_SHADER_STORAGE_BUFFER, (1 << (GRID_LEVEL * 2)) * (1 << (GRID_LEVEL * 2)) * (1 << (GRID_LEVEL * 2)) * nodesSize * sizeof(Node), nullptr, GL_DYNAMIC_DRAW);
     
     glBindBuffer(GL_SHADER_STORAGE_BUFFER, ssbo[5]);
     glBufferData(GL_SHADER_STORAGE_BUFFER, (1 << (GRID_LEVEL * 2)) * (1 << (GRID_LEVEL * 2)) * (1 << (GRID_LEVEL * 2)) * sizeof(CellInfo), nullptr, GL_DYNAMIC_DRAW);
@@ -297,15 +458,21 @@ int main() {
     
     glBindBuffer(GL_UNIFORM_BUFFER, aabbBuffer);
     glBufferData(GL_UNIFORM_BUFFER, sizeof(struct AABB), &aabb, GL_DYNAMIC_DRAW);
-
-    
-    #if USE_FAR_FIELDS_ALG
+    endTraceScope(bufferZone);
+
+    TraceScope computeZone(&trace, "compute shader load and compile", "startup");
+    #if USE_FAR_FIELDS_ALG && USE_FAR_FIELD_CORNERS_ALG
+        unsigned int computeShader = createShader(GL_COMPUTE_SHADER, "src/shaders/lipschitzPruning/compute/pruningFarFieldCorners.comp.glsl");
+    #elif USE_FAR_FIELDS_ALG && USE_INTERVAL_ALG
+        unsigned int computeShader = createShader(GL_COMPUTE_SHADER, "src/shaders/lipschitzPruning/compute/pruningIntervals.comp.glsl");
+    #elif USE_FAR_FIELDS_ALG
         unsigned int computeShader = createShader(GL_COMPUTE_SHADER, "src/shaders/lipschitzPruning/compute/pruningFarFields.comp.glsl");
     #else 
         unsigned int computeShader = createShader(GL_COMPUTE_SHADER, "src/shaders/lipschitzPruning/compute/pruning.comp.glsl");
     #endif
 
     unsigned int computeShaderProgram = createComputeShaderProgram(computeShader); 
+    endTraceScope(computeZone);
 
     glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 0, ssbo[0]);
     glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 1, ssbo[1]);
@@ -315,17 +482,12 @@ int main() {
     glUseProgram(computeShaderProgram);
     int loc = glGetUniformLocation(computeShaderProgram, "subdivisions");
 
-    #if CALCULATE_COMPUTE_SHADER_TIME
-
-    GLuint queries[2];
-    glGenQueries(2, queries);
-
-    glQueryCounter(queries[0], GL_TIMESTAMP);
-
-    #endif
+    for (int i = 0; i < GRID_LEVEL; i++) pruningPasses.push_back(addGpuPass(gpuTimer, "pruning level " + std::to_string(i)));
 
 
     for(int i = 0; i < GRID_LEVEL ; i++){
+        std::string levelName = "pruning level " + std::to_string(i);
+        TraceScope levelZone(&trace, levelName.c_str(), "pruning", i);
         int x = 1 << (i * 2);
         int y = 1 << (i * 2);
         int z = 1 << (i * 2);
@@ -357,29 +519,37 @@ int main() {
             glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 8, farFieldValueInput);
         }
         #endif
+
+        #if USE_FAR_FIELDS_ALG && USE_FAR_FIELD_CORNERS_ALG
+        glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 9, farFieldCorners[i % 2]);
+        glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 10, farFieldCorners[(i + 1) % 2]);
+        #endif
         
 
+        beginGpuPass(gpuTimer, pruningPasses[i]);
         glDispatchCompute(x,y,z);
         glMemoryBarrier(GL_SHADER_STORAGE_BARRIER_BIT | GL_BUFFER_UPDATE_BARRIER_BIT);
+        endGpuPass(gpuTimer, pruningPasses[i]);
+        endTraceScope(levelZone);
+
+        // Leitura das células do nível fora do intervalo medido (só no modo benchmark, ela espera a GPU)
+        if (options.benchmark) {
+            TraceScope readbackZone(&trace, "pruning level readback", "pruning", i);
+            int levelCellCount = (1 << ((i + 1) * 2)) * (1 << ((i + 1) * 2)) * (1 << ((i + 1) * 2));
+            GLuint levelNodeCount = 0;
+            std::vector<CellInfo> levelCells(levelCellCount);
+            glBindBuffer(GL_SHADER_STORAGE_BUFFER, nodesCount);
+            glGetBufferSubData(GL_SHADER_STORAGE_BUFFER, 0, sizeof(GLuint), &levelNodeCount);
+            glBindBuffer(GL_SHADER_STORAGE_BUFFER, i % 2 == 0 ? ssbo[5] : ssbo[3]);
+            glGetBufferSubData(GL_SHADER_STORAGE_BUFFER, 0, levelCellCount * sizeof(CellInfo), levelCells.data());
+            pruningLevels.emplace_back();
+            getPruningLevelStats(levelCells.data(), levelCellCount, levelNodeCount, i, pruningLevels.back());
+        }
     }
 
-    #if CALCULATE_COMPUTE_SHADER_TIME
-
-    glQueryCounter(queries[1], GL_TIMESTAMP);
-
-    GLint available0, available1 = GL_FALSE;
-    while (available0 == GL_FALSE && available1 == GL_FALSE) {
-        glGetQueryObjectiv(queries[0], GL_QUERY_RESULT_AVAILABLE, &available0);
-        glGetQueryObjectiv(queries[1], GL_QUERY_RESULT_AVAILABLE, &available1);
-    }
-    GLuint64 timeStart, timeEnd;
-    glGetQueryObjectui64v(queries[0], GL_QUERY_RESULT, &timeStart);
-    glGetQueryObjectui64v(queries[1], GL_QUERY_RESULT, &timeEnd);
-    printComputeShaderMetrics(timeStart, timeEnd);
-
-    #endif
 
 
+    TraceScope gridZone(&trace, "grid setup", "startup");
     glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 0, ssbo[0]);
     glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 1, ssbo[1]);
 
@@ -398,25 +568,133 @@ int main() {
         glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 4, farFieldValueOutput);
     }
     #endif
+
+    #if USE_FAR_FIELDS_ALG && USE_FAR_FIELD_CORNERS_ALG
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 5, farFieldCorners[GRID_LEVEL % 2]);
+    #endif
+
+    #if USE_FAR_FIELDS_ALG && (USE_TAPE_ALG || USE_BRICK_MAP_ALG || USE_QUANTIZED_FAR_FIELDS_ALG)
+    int gridCellCount = (1 << (GRID_LEVEL * 2)) * (1 << (GRID_LEVEL * 2)) * (1 << (GRID_LEVEL * 2));
+    GLuint gridNodeCount = 0;
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, nodesCount);
+    glGetBufferSubData(GL_SHADER_STORAGE_BUFFER, 0, sizeof(GLuint), &gridNodeCount);
+
+    PruningGrid grid;
+    grid.aabb = aabb;
+    grid.subdivisions = 1 << (GRID_LEVEL * 2);
+    grid.cells.resize(gridCellCount);
+    grid.nodes.resize(gridNodeCount);
+    grid.farFieldValues.resize(gridCellCount);
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, GRID_LEVEL % 2 == 0 ? ssbo[3] : ssbo[5]);
+    glGetBufferSubData(GL_SHADER_STORAGE_BUFFER, 0, gridCellCount * sizeof(CellInfo), grid.cells.data());
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, GRID_LEVEL % 2 == 0 ? ssbo[2] : ssbo[4]);
+    glGetBufferSubData(GL_SHADER_STORAGE_BUFFER, 0, gridNodeCount * sizeof(Node), grid.nodes.data());
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, GRID_LEVEL % 2 == 0 ? farFieldValueInput : farFieldValueOutput);
+    glGetBufferSubData(GL_SHADER_STORAGE_BUFFER, 0, gridCellCount * sizeof(float), grid.farFieldValues.data());
+    #endif
+
+    #if USE_FAR_FIELDS_ALG && USE_TAPE_ALG
+    std::vector<CellInfo> tapeCells;
+    std::vector<Instruction> tape;
+    compileGridTapes(scene, grid.cells, grid.nodes, tapeCells, tape);
+    printf("Nós nas células: %u, instruções nas fitas: %zu\n", gridNodeCount, tape.size());
+
+    GLuint tapeBuffers[2];
+    glGenBuffers(2, tapeBuffers);
+
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, tapeBuffers[0]);
+    glBufferData(GL_SHADER_STORAGE_BUFFER, std::max<size_t>(tape.size(), 1) * sizeof(Instruction), tape.data(), GL_STATIC_DRAW);
+
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, tapeBuffers[1]);
+    glBufferData(GL_SHADER_STORAGE_BUFFER, gridCellCount * sizeof(CellInfo), tapeCells.data(), GL_STATIC_DRAW);
+
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 2, tapeBuffers[0]);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 3, tapeBuffers[1]);
+    #endif
+
+    #if USE_FAR_FIELDS_ALG && USE_BRICK_MAP_ALG
+    BrickMap brickMap;
+    bakeBrickMap(scene, grid, brickMap);
+    std::vector<float> atlas;
+    getBrickAtlas(brickMap, atlas);
+    printf("Tijolos: %zu, atlas: %d^3, erro máximo: %.5f\n", brickMap.samples.size() / (BRICK_SIZE * BRICK_SIZE * BRICK_SIZE),
+           brickMap.atlasSize, brickMap.errorBound);
+
+    GLuint brickAtlas;
+    glGenTextures(1, &brickAtlas);
+    glActiveTexture(GL_TEXTURE0);
+    glBindTexture(GL_TEXTURE_3D, brickAtlas);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    glTexImage3D(GL_TEXTURE_3D, 0, GL_R32F, brickMap.atlasSize, brickMap.atlasSize, brickMap.atlasSize, 0, GL_RED, GL_FLOAT, atlas.data());
+    glTexParameteri(GL_TEXTURE_3D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_3D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_3D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_3D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_3D, GL_TEXTURE_WRAP_R, GL_CLAMP_TO_EDGE);
+
+    GLuint brickIndexBuffer;
+    glGenBuffers(1, &brickIndexBuffer);
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, brickIndexBuffer);
+    glBufferData(GL_SHADER_STORAGE_BUFFER, gridCellCount * sizeof(int), brickMap.bricks.data(), GL_STATIC_DRAW);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 5, brickIndexBuffer);
+    #endif
+
+    #if USE_FAR_FIELDS_ALG && USE_QUANTIZED_FAR_FIELDS_ALG
+    QuantizedFarField quantizedFarField;
+    quantizeFarFields(grid, USE_QUANTIZED_FAR_FIELDS_ALG, quantizedFarField);
+    printf("Far-fields em %d bits, escala: %.4f\n", quantizedFarField.bits, quantizedFarField.scale);
+
+    GLuint farFieldTexture;
+    glGenTextures(1, &farFieldTexture);
+    glActiveTexture(GL_TEXTURE0);
+    glBindTexture(GL_TEXTURE_3D, farFieldTexture);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    #if USE_QUANTIZED_FAR_FIELDS_ALG == 8
+    std::vector<GLubyte> farFieldCodes(quantizedFarField.values.begin(), quantizedFarField.values.end());
+    glTexImage3D(GL_TEXTURE_3D, 0, GL_R8, grid.subdivisions, grid.subdivisions, grid.subdivisions, 0, GL_RED, GL_UNSIGNED_BYTE, farFieldCodes.data());
+    #else
+    glTexImage3D(GL_TEXTURE_3D, 0, GL_R16, grid.subdivisions, grid.subdivisions, grid.subdivisions, 0, GL_RED, GL_UNSIGNED_SHORT, quantizedFarField.values.data());
+    #endif
+    glTexParameteri(GL_TEXTURE_3D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_3D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_3D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_3D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_3D, GL_TEXTURE_WRAP_R, GL_CLAMP_TO_EDGE);
+
+    // A textura substitui os buffers float dos far-fields
+    glDeleteBuffers(1, &farFieldValueInput);
+    glDeleteBuffers(1, &farFieldValueOutput);
+    #endif
+    endTraceScope(gridZone);
 #endif
 
 
 
 
 #if !USE_PRUNING_ALG
-    const int N = 25; 
-    
+    TraceScope sceneZone(&trace, "scene setup and buffers", "startup");
     std::array<Primitive,13> primitives;
     std::array<BinaryOperation,12> binaryOperations;
-    std::array<Node,25> nodes;
-    std::array<CellInfo,1> cells = {{{.offset = 0, .size = 25}}};
 
     getPrimitivesPost(primitives);
     getBinaryOperationsPost(binaryOperations);
-    getNodesPost(nodes);
 
-    GLuint ssbo[4];
-    glGenBuffers(4, ssbo);
+    Scene scene;
+    getScenePost(scene);
+    #if USE_NARY_ALG
+    std::vector<Node> nodes;
+    flattenTree(scene, scene.nodes, nodes);
+    #else
+    std::vector<Node> nodes = scene.nodes;
+    #endif
+    const int nodesSize = nodes.size();
+    std::array<CellInfo,1> cells = {{{.offset = 0, .size = nodesSize}}};
+
+    std::vector<NodeBound> nodeBounds(nodesSize);
+    computeNodeBounds(scene, nodes.data(), nodesSize, nodeBounds.data());
+
+    GLuint ssbo[5];
+    glGenBuffers(5, ssbo);
   
     glBindBuffer(GL_SHADER_STORAGE_BUFFER, ssbo[0]);
     glBufferData(GL_SHADER_STORAGE_BUFFER, 13 * sizeof(primitives.data()[0]), primitives.data(), GL_DYNAMIC_DRAW);
@@ -425,111 +703,276 @@ int main() {
     glBufferData(GL_SHADER_STORAGE_BUFFER, 12 * sizeof(binaryOperations.data()[0]), binaryOperations.data(), GL_DYNAMIC_DRAW);
 
     glBindBuffer(GL_SHADER_STORAGE_BUFFER, ssbo[2]);
-    glBufferData(GL_SHADER_STORAGE_BUFFER, 25 * sizeof(nodes.data()[0]), nodes.data(), GL_DYNAMIC_DRAW);
+    glBufferData(GL_SHADER_STORAGE_BUFFER, nodesSize * sizeof(nodes.data()[0]), nodes.data(), GL_DYNAMIC_DRAW);
 
     glBindBuffer(GL_SHADER_STORAGE_BUFFER, ssbo[3]);
     glBufferData(GL_SHADER_STORAGE_BUFFER, 1 * sizeof(cells.data()[0]), cells.data(), GL_DYNAMIC_DRAW);
 
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, ssbo[4]);
+    glBufferData(GL_SHADER_STORAGE_BUFFER, nodesSize * sizeof(nodeBounds.data()[0]), nodeBounds.data(), GL_DYNAMIC_DRAW);
+
     glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 0, ssbo[0]);
     glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 1, ssbo[1]);
     glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 2, ssbo[2]);
     glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 3, ssbo[3]);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 4, ssbo[4]);
+    endTraceScope(sceneZone);
 
 #endif
 
-    //Shader Time
-    unsigned int queryID;
-    glGenQueries(1, &queryID);
-    double totalShaderTime = 0;
-    double ShaderTimeSamples[SAMPLES];
-
-    //FPS
-    double totalTime = 0.0;
-    int totalFrames = 0;
-    double lastFrameTime = glfwGetTime();
-    double FPSamples[SAMPLES];
-
-    int samplesCount = 0;
+    //Benchmark
+    int marchPass = addGpuPass(gpuTimer, "march");
+    int presentPass = addGpuPass(gpuTimer, "present");
+
+    // Governador do tempo de quadro
+    Governor governor;
+    ScaledTarget scaledTarget;
+    int upscalePass = -1;
+    bool governedRays = glGetUniformLocation(shaderProgram, "MAX_STEP") == 5 && glGetUniformLocation(shaderProgram, "e") == 6;
+    if (options.targetMs > 0.0) {
+        GovernorBounds bounds = options.governorBounds;
+        // Shader sem os uniforms de passos e epsilon: só a escala muda
+        if (!governedRays) {
+            std::cerr << "The shader has no MAX_STEP and e uniforms, the frame-time governor changes the render scale only\n";
+            bounds.minSteps = bounds.maxSteps;
+            bounds.maxEpsilon = bounds.minEpsilon;
+        }
+        initGovernor(governor, options.targetMs, bounds);
+        createScaledTarget(scaledTarget);
+        upscalePass = addGpuPass(gpuTimer, "upscale");
+    }
+    std::vector<double> frameTimes;
+    SampleStats frameStats, shaderStats;
+    bool converged = false;
+    double measureStart = getContextTime(context) + options.warmup;
 
 
     int subdivisions = (1 << (GRID_LEVEL * 2)); 
 
     glUseProgram(shaderProgram);
-  
-
-    while (!glfwWindowShouldClose(window)) {
-        double currentTime = glfwGetTime();
-        double deltaTime = currentTime - lastFrameTime;
-        totalTime += deltaTime;
-        totalFrames++;
-        lastFrameTime = currentTime;
+    endTraceScope(startupZone);
+
+    bool continuous = options.benchmark || options.continuous || governor.target > 0.0;
+
+    // Cena direto na saída ou, com o governador, no tamanho dele e ampliada até a janela
+    auto drawScene = [&](double time){
+        int renderWidth = WINDOW_WIDTH, renderHeight = WINDOW_HEIGHT;
+        if (governor.target > 0.0) getGovernorSize(governor, WINDOW_WIDTH, WINDOW_HEIGHT, renderWidth, renderHeight);
+        bool scaled = renderWidth != WINDOW_WIDTH || renderHeight != WINDOW_HEIGHT;
+        if (scaled) resizeScaledTarget(scaledTarget, renderWidth, renderHeight);
+        if (governor.target > 0.0) {
+            glBindFramebuffer(GL_FRAMEBUFFER, scaled ? scaledTarget.framebuffer : getContextFramebuffer(context));
+            glViewport(0, 0, renderWidth, renderHeight);
+        }
 
         glClearColor(1.0f, 1.0f, 1.0f, 1.0f);
         glClear(GL_COLOR_BUFFER_BIT);
 
-        glBeginQuery(GL_TIME_ELAPSED, queryID);
+        beginGpuPass(gpuTimer, marchPass);
 
-        glUniform2f(0, (float)WINDOW_WIDTH, (float)WINDOW_HEIGHT);
-        glUniform1f(1, currentTime);
+        glUniform2f(0, (float)renderWidth, (float)renderHeight);
+        glUniform1f(1, time);
         glUniform1i(2, subdivisions);
-        
+        #if USE_PRUNING_ALG && USE_FAR_FIELDS_ALG && USE_QUANTIZED_FAR_FIELDS_ALG
+        glUniform1f(3, quantizedFarField.scale);
+        #endif
+        if (governor.target > 0.0 && governedRays) {
+            glUniform1f(5, governor.maxSteps);
+            glUniform1f(6, governor.epsilon);
+        }
 
         glBindVertexArray(VAO);
         //glPolygonMode(GL_FRONT_AND_BACK, GL_LINE);
         glDrawElements(GL_TRIANGLES, 6, GL_UNSIGNED_INT, 0);
         glBindVertexArray(0);
 
-        glEndQuery(GL_TIME_ELAPSED);
+        endGpuPass(gpuTimer, marchPass);
 
-#if CALCULATE_SHADER_TIME
-            GLint available = GL_FALSE;
-            while (available == GL_FALSE) {
-                glGetQueryObjectiv(queryID, GL_QUERY_RESULT_AVAILABLE, &available);
+        if (upscalePass < 0) return;
+        beginGpuPass(gpuTimer, upscalePass);
+        if (scaled) {
+            upscaleScaledTarget(scaledTarget, getContextFramebuffer(context), WINDOW_WIDTH, WINDOW_HEIGHT, VAO);
+            glUseProgram(shaderProgram);
+        }
+        endGpuPass(gpuTimer, upscalePass);
+    };
+    IdleUsage idleUsage;
+    long framesDrawn = 0;
+
+    while (isContextOpen(context)) {
+        // Imagem inalterada: espera eventos em vez de redesenhar (só acorda antes para ler os timers)
+        if (!continuous && !context.dirty) {
+            TraceScope waitZone(&trace, "wait events", "frame");
+            UsageSample before, after;
+            getUsageSample(before);
+            waitRenderContext(context, isGpuTimerPending(gpuTimer) ? TIMER_POLL_INTERVAL : -1.0);
+            getUsageSample(after);
+            addIdleUsage(idleUsage, before, after);
+            collectGpuTimer(gpuTimer);
+            if (pruningTime < 0.0) pruningTime = printComputeShaderMetrics(gpuTimer, pruningPasses);
+            continue;
+        }
+        context.dirty = false;
+        framesDrawn++;
+
+        TraceScope frameZone(&trace, "frame", "frame");
+        TraceScope drawZone(&trace, "draw", "frame");
+        double currentTime = getContextTime(context);
+        bool measuring = options.benchmark && currentTime >= measureStart;
+        gpuTimer.record = measuring;
+
+        drawScene(currentTime);
+        endTraceScope(drawZone);
+
+        TraceScope swapZone(&trace, "swap buffers", "frame");
+        beginGpuPass(gpuTimer, presentPass);
+        presentRenderContext(context);
+        endGpuPass(gpuTimer, presentPass);
+        endTraceScope(swapZone);
+
+        TraceScope eventsZone(&trace, "poll events", "frame");
+        pollRenderContext(context);
+        endTraceScope(eventsZone);
+
+        // Resultados de quadros anteriores, sem esperar a GPU
+        TraceScope timersZone(&trace, "collect timers", "frame");
+        collectGpuTimer(gpuTimer);
+        if (pruningTime < 0.0) pruningTime = printComputeShaderMetrics(gpuTimer, pruningPasses);
+        endTraceScope(timersZone);
+
+        // Governador: o tempo de GPU mais recente (march e ampliação) ou, se maior, o tempo do quadro na CPU,
+        // que cobre renderizadores que adiam o trabalho e cujos timestamps não o medem (llvmpipe)
+        if (governor.target > 0.0) {
+            double gpuMs = std::max(gpuTimer.latest[marchPass], 0.0) + std::max(gpuTimer.latest[upscalePass], 0.0);
+            double cpuMs = (getContextTime(context) - currentTime) * 1000.0;
+            if (updateGovernor(governor, std::max(gpuMs, cpuMs), framesDrawn, currentTime, WINDOW_WIDTH, WINDOW_HEIGHT)) {
+                printGovernorDecision(governor, governor.decisions.back());
             }
-            GLuint64 elapsedTime;
-            glGetQueryObjectui64v(queryID, GL_QUERY_RESULT, &elapsedTime);
-            double ms = (double)elapsedTime / 1000000.0;
-            totalShaderTime += ms;
-#endif
+        }
 
-        glfwSwapBuffers(window);
-        glfwPollEvents();
+    #if USE_HEADLESS_CONTEXT
+        // Sem janela para fechar: fora do modo benchmark só um quadro
+        if (!options.benchmark) closeRenderContext(context);
+    #endif
 
-         //FPS
-        if (totalTime >= ONE_MINUTE) {
+        if (!measuring) continue;
+        frameTimes.push_back((getContextTime(context) - currentTime) * 1000.0);
 
-#if CALCULATE_FPS
-            double averageFPS = (double)totalFrames / totalTime;
-            printf("Média de FPS em %.1f segundos: %.2f\n", totalTime, averageFPS);
-            FPSamples[samplesCount] = averageFPS;
-#endif
+        // Para quando as médias estão dentro da tolerância ou acabou o tempo
+        if (frameTimes.size() % 10 == 0) {
+            getSampleStats(frameTimes, frameStats);
+            getSampleStats(gpuTimer.samples[marchPass], shaderStats);
+            converged = isConverged(frameStats, options.tolerance, options.minFrames) &&
+                        isConverged(shaderStats, options.tolerance, options.minFrames);
+        }
+        if (converged || getContextTime(context) - measureStart >= options.duration) break;
+    }
 
-#if CALCULATE_SHADER_TIME
-            double averageShaderTime = (double)totalShaderTime / totalFrames;
-            ShaderTimeSamples[samplesCount] = averageShaderTime;
-            printf("Média de tempo do shader em %.1f segundos: %.4f (ms)\n", totalTime, averageShaderTime);
-#endif
+    gpuTimer.record = false;
+    if (!continuous && idleUsage.waits > 0) printIdleUsage(idleUsage, framesDrawn);
+    if (governor.target > 0.0) {
+        printf("Governador: %zu decisões, escala %.3f, %.0f passos, epsilon %g\n", governor.decisions.size(),
+               governor.scale, governor.maxSteps, governor.epsilon);
+        if (!options.governorLog.empty() && !writeGovernorLog(options.governorLog.c_str(), governor)) {
+            std::cerr << "Failed to write " << options.governorLog << "\n";
+        }
+    }
 
-            samplesCount++;
-            totalShaderTime = 0;
-            totalTime = 0;
-            totalFrames = 0;
+    if (options.benchmark) {
+        finishGpuTimer(gpuTimer);
+        if (pruningTime < 0.0) pruningTime = printComputeShaderMetrics(gpuTimer, pruningPasses);
+
+        BenchmarkReport report;
+        report.variant = getRenderName(options);
+        report.width = WINDOW_WIDTH;
+        report.height = WINDOW_HEIGHT;
+        report.gridLevel = GRID_LEVEL;
+        report.warmup = options.warmup;
+        report.duration = getContextTime(context) - measureStart;
+        report.converged = converged;
+        report.pruningTime = std::max(pruningTime, 0.0);
+        for (int pass = 0; pass < (int)gpuTimer.names.size(); pass++) {
+            report.passes.push_back({gpuTimer.names[pass], gpuTimer.count[pass] > 0 ? gpuTimer.total[pass] / gpuTimer.count[pass] : 0.0});
+        }
+        for (PruningLevelStats& level : pruningLevels) {
+            level.time = std::max(gpuTimer.latest[pruningPasses[level.level]], 0.0);
+            printf("Nível %d (%d^3): %.4f ms, %d células ativas, %ld nós, %.2f nós por célula (máximo %d), %.1f%% só far-field\n",
+                   level.level, level.subdivisions, level.time, level.activeCells, level.nodes, level.meanNodes,
+                   level.maxNodes, level.farFieldFraction * 100.0);
+        }
+        report.pruningLevels = pruningLevels;
+        getSampleStats(frameTimes, report.frameTime);
+        getSampleStats(gpuTimer.samples[marchPass], report.shaderTime);
+
+        printf("%s %dx%d: %d quadros, quadro %.4f ms (p99 %.4f), shader %.4f ms (p99 %.4f)%s\n", report.variant.c_str(),
+               report.width, report.height, report.frameTime.count, report.frameTime.mean, report.frameTime.p99,
+               report.shaderTime.mean, report.shaderTime.p99, converged ? "" : ", sem convergir");
+        if (!options.output.empty() && !writeReport(options.output.c_str(), report)) {
+            std::cerr << "Failed to write " << options.output << "\n";
+        }
+    }
 
-            if(samplesCount == SAMPLES){
+    // Um quadro a mais para a imagem, fora das medidas
+    if (!options.image.empty()) {
+        Image image;
+        image.width = WINDOW_WIDTH;
+        image.height = WINDOW_HEIGHT;
+        image.pixels.resize(WINDOW_WIDTH * WINDOW_HEIGHT * 3);
+        drawScene(getContextTime(context));
+        glPixelStorei(GL_PACK_ALIGNMENT, 1);
+        glReadPixels(0, 0, WINDOW_WIDTH, WINDOW_HEIGHT, GL_RGB, GL_UNSIGNED_BYTE, image.pixels.data());
+        if (!writeImage(options.image.c_str(), image)) std::cerr << "Failed to write " << options.image << "\n";
+    }
 
-#if CALCULATE_FPS
-                calculteFPSMetrics(FPSamples);
+    // Um quadro a mais com os contadores, fora das medidas
+    if (!options.counters.empty() && !options.shader.empty()) {
+        std::cerr << "The pixel counters need the fragment shader of the variant\n";
+    }
+    else if (!options.counters.empty()) {
+#if USE_COUNTERS_SHADER
+        int pixelCount = WINDOW_WIDTH * WINDOW_HEIGHT;
+        GLuint countersBuffer;
+        glGenBuffers(1, &countersBuffer);
+        glBindBuffer(GL_SHADER_STORAGE_BUFFER, countersBuffer);
+        glBufferData(GL_SHADER_STORAGE_BUFFER, pixelCount * sizeof(PixelCounters), nullptr, GL_DYNAMIC_READ);
+        glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 6, countersBuffer);
+
+        // Contadores por pixel da janela, com os passos e o epsilon do governador
+        if (governor.target > 0.0) {
+            glBindFramebuffer(GL_FRAMEBUFFER, getContextFramebuffer(context));
+            glViewport(0, 0, WINDOW_WIDTH, WINDOW_HEIGHT);
+            glUniform2f(0, (float)WINDOW_WIDTH, (float)WINDOW_HEIGHT);
+        }
+        glUniform1i(4, 1);
+        glClear(GL_COLOR_BUFFER_BIT);
+        glBindVertexArray(VAO);
+        glDrawElements(GL_TRIANGLES, 6, GL_UNSIGNED_INT, 0);
+        glBindVertexArray(0);
+        glUniform1i(4, 0);
+        glMemoryBarrier(GL_BUFFER_UPDATE_BARRIER_BIT);
+
+        std::vector<PixelCounters> pixels(pixelCount);
+        glGetBufferSubData(GL_SHADER_STORAGE_BUFFER, 0, pixelCount * sizeof(PixelCounters), pixels.data());
+        glDeleteBuffers(1, &countersBuffer);
+
+        CounterReport counterReport;
+        counterReport.source = "gpu";
+        counterReport.variant = getVariantName();
+        reducePixelCounters(pixels, WINDOW_WIDTH, WINDOW_HEIGHT, counterReport);
+        printCounterReport(counterReport);
+        if (!writeCounterReport(options.counters.c_str(), counterReport)) {
+            std::cerr << "Failed to write " << options.counters << "\n";
+        }
+#else
+        std::cerr << "The pixel counters need a variant rendered by full3DTreePruningFarFields.frag\n";
 #endif
+    }
 
-#if CALCULATE_SHADER_TIME
-                calculteShaderMetrics(ShaderTimeSamples);
-#endif
-                return 0;
-            }
-        }
+    if (!options.trace.empty()) {
+        finishGpuTimer(gpuTimer);
+        if (!writeTrace(options.trace.c_str(), trace)) std::cerr << "Failed to write " << options.trace << "\n";
     }
 
-    glfwDestroyWindow(window);
-    glfwTerminate();
+    destroyRenderContext(context);
     return 0;
 }
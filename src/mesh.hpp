@@ -0,0 +1,284 @@
+/**
+ * @file mesh.hpp
+ * @brief Triangle mesh extraction over the pruned cells.
+ *
+ * Dual contouring with mass-point vertices (surface nets): each cell with a tree is split in
+ * resolution^3 voxels, sampled at the voxel corners with the reduced tree of the cell, and
+ * every voxel with a sign change gets one vertex at the mean of its edge crossings. Each edge
+ * with a sign change becomes a quad between the vertices of its 4 voxels.
+ *
+ * A far-field cell has no zero in its closed box, so every edge with a crossing and its 4
+ * voxels belong to cells with a tree, and only those cells are visited. A voxel has exactly
+ * one vertex, so the vertices are welded across cell boundaries by their global voxel index.
+ * The cells are polygonized in parallel: first the samples and vertices, then, after the
+ * vertex numbering, the quads of the edges starting in each cell.
+ *
+ * @author Edson Martinelli
+ * @date 2026
+ */
+
+#ifndef MESH_HPP
+#define MESH_HPP
+
+#include <cmath>
+#include <cstdio>
+#include <cstdint>
+#include <vector>
+#include <algorithm>
+#include "shape.hpp"
+#include "vector.hpp"
+#include "evaluator.hpp"
+#include "pruning.hpp"
+#include "threads.hpp"
+
+/**
+ * @brief Indexed triangle mesh.
+ */
+struct Mesh{
+    std::vector<vec3> vertices; /**< Vertex positions. */
+    std::vector<vec3> normals; /**< Normalized SDF gradient at each vertex. */
+    std::vector<int> triangles; /**< 3 vertex indices per triangle, counter-clockwise seen from outside. */
+};
+
+/**
+ * @brief Polygonization state of one cell.
+ */
+struct MeshCell{
+    int cell; /**< Grid cell index. */
+    std::vector<float> samples; /**< (resolution + 1)^3 corner samples, x fastest. */
+    std::vector<int> vertices; /**< Local vertex of each voxel (resolution^3), -1 without crossing. */
+    std::vector<vec3> positions; /**< Local vertex positions. */
+    std::vector<vec3> normals; /**< Local vertex normals. */
+    int firstVertex; /**< Index of the first local vertex in the mesh. */
+    std::vector<int> triangles; /**< Triangles of the edges starting in the cell. */
+};
+
+/**
+ * @brief Sample one cell and place the vertices of its voxels.
+ *
+ * @param [in] scene Scene with primitives and binary operations.
+ * @param [in] grid Pruning grid.
+ * @param [in] resolution Voxels per cell axis.
+ * @param [in,out] meshCell Cell to polygonize (cell set).
+ */
+void sampleMeshCell(const Scene& scene, const PruningGrid& grid, int resolution, MeshCell& meshCell){
+    int n = grid.subdivisions;
+    int r = resolution;
+    int s = r + 1;
+    const CellInfo& info = grid.cells[meshCell.cell];
+    const Node* nodes = grid.nodes.data() + info.offset;
+
+    vec3 minimum = {grid.aabb.minimum.x, grid.aabb.minimum.y, grid.aabb.minimum.z};
+    vec3 maximum = {grid.aabb.maximum.x, grid.aabb.maximum.y, grid.aabb.maximum.z};
+    vec3 cellSize = (maximum - minimum) / (float)n;
+    vec3 voxelSize = cellSize / (float)r;
+    vec3 cellMinimum = minimum + cellSize * vec3{(float)(meshCell.cell % n), (float)(meshCell.cell / n % n),
+                                                 (float)(meshCell.cell / (n * n))};
+
+    meshCell.samples.resize(s * s * s);
+    for (int k = 0; k < s; k++)
+    for (int j = 0; j < s; j++)
+    for (int i = 0; i < s; i++) {
+        vec3 p = cellMinimum + voxelSize * vec3{(float)i, (float)j, (float)k};
+        meshCell.samples[(k * s + j) * s + i] = sdf(p, scene, nodes, info.size);
+    }
+
+    const int corner[8][3] = {{0, 0, 0}, {1, 0, 0}, {0, 1, 0}, {1, 1, 0}, {0, 0, 1}, {1, 0, 1}, {0, 1, 1}, {1, 1, 1}};
+    const int edges[12][2] = {{0, 1}, {2, 3}, {4, 5}, {6, 7}, {0, 2}, {1, 3}, {4, 6}, {5, 7}, {0, 4}, {1, 5}, {2, 6}, {3, 7}};
+    float h = 0.25f * std::min(voxelSize.x, std::min(voxelSize.y, voxelSize.z));
+
+    meshCell.vertices.assign(r * r * r, -1);
+    for (int k = 0; k < r; k++)
+    for (int j = 0; j < r; j++)
+    for (int i = 0; i < r; i++) {
+        float v[8];
+        for (int c = 0; c < 8; c++) {
+            v[c] = meshCell.samples[((k + corner[c][2]) * s + (j + corner[c][1])) * s + (i + corner[c][0])];
+        }
+
+        vec3 sum = {0.0f, 0.0f, 0.0f};
+        int crossings = 0;
+        for (const auto& edge : edges) {
+            float a = v[edge[0]];
+            float b = v[edge[1]];
+            if ((a < 0.0f) == (b < 0.0f)) continue;
+            float t = a / (a - b);
+            const int* ca = corner[edge[0]];
+            const int* cb = corner[edge[1]];
+            sum = sum + vec3{ca[0] + (cb[0] - ca[0]) * t, ca[1] + (cb[1] - ca[1]) * t, ca[2] + (cb[2] - ca[2]) * t};
+            crossings++;
+        }
+        if (crossings == 0) continue;
+
+        vec3 p = cellMinimum + voxelSize * (vec3{(float)i, (float)j, (float)k} + sum / (float)crossings);
+        vec3 gradient = {sdf(p + vec3{h, 0.0f, 0.0f}, scene, nodes, info.size) - sdf(p - vec3{h, 0.0f, 0.0f}, scene, nodes, info.size),
+                         sdf(p + vec3{0.0f, h, 0.0f}, scene, nodes, info.size) - sdf(p - vec3{0.0f, h, 0.0f}, scene, nodes, info.size),
+                         sdf(p + vec3{0.0f, 0.0f, h}, scene, nodes, info.size) - sdf(p - vec3{0.0f, 0.0f, h}, scene, nodes, info.size)};
+        float l = length(gradient);
+
+        meshCell.vertices[(k * r + j) * r + i] = meshCell.positions.size();
+        meshCell.positions.push_back(p);
+        meshCell.normals.push_back(l > 0.0f ? gradient / l : vec3{0.0f, 0.0f, 0.0f});
+    }
+}
+
+/**
+ * @brief Quads of the crossing edges starting in one cell.
+ *
+ * @param [in] grid Pruning grid.
+ * @param [in] resolution Voxels per cell axis.
+ * @param [in] cellSlot Slot of each grid cell in meshCells, -1 for far-field cells.
+ * @param [in] meshCells Sampled cells with the vertices numbered.
+ * @param [in,out] meshCell Cell whose edges are polygonized.
+ */
+void triangulateMeshCell(const PruningGrid& grid, int resolution, const std::vector<int>& cellSlot,
+                         const std::vector<MeshCell>& meshCells, MeshCell& meshCell){
+    int n = grid.subdivisions;
+    int r = resolution;
+    int s = r + 1;
+    int voxels = n * r;
+    int cx = meshCell.cell % n * r;
+    int cy = meshCell.cell / n % n * r;
+    int cz = meshCell.cell / (n * n) * r;
+
+    // Vértice de um voxel pelas coordenadas globais, -1 se não houver
+    auto getVertex = [&](int x, int y, int z){
+        if (x < 0 || y < 0 || z < 0 || x >= voxels || y >= voxels || z >= voxels) return -1;
+        int slot = cellSlot[getCellIndex(x / r, y / r, z / r, n)];
+        if (slot < 0) return -1;
+        const MeshCell& other = meshCells[slot];
+        int local = other.vertices[((z % r) * r + (y % r)) * r + (x % r)];
+        return local < 0 ? -1 : other.firstVertex + local;
+    };
+
+    for (int k = 0; k < r; k++)
+    for (int j = 0; j < r; j++)
+    for (int i = 0; i < r; i++) {
+        float a = meshCell.samples[(k * s + j) * s + i];
+        for (int axis = 0; axis < 3; axis++) {
+            int di = axis == 0, dj = axis == 1, dk = axis == 2;
+            float b = meshCell.samples[((k + dk) * s + (j + dj)) * s + (i + di)];
+            if ((a < 0.0f) == (b < 0.0f)) continue;
+
+            // Os 4 voxels em volta da aresta, em ordem no plano perpendicular
+            int x = cx + i, y = cy + j, z = cz + k;
+            int quad[4];
+            if (axis == 0) {
+                quad[0] = getVertex(x, y - 1, z - 1); quad[1] = getVertex(x, y, z - 1);
+                quad[2] = getVertex(x, y, z); quad[3] = getVertex(x, y - 1, z);
+            } else if (axis == 1) {
+                quad[0] = getVertex(x - 1, y, z - 1); quad[1] = getVertex(x - 1, y, z);
+                quad[2] = getVertex(x, y, z); quad[3] = getVertex(x, y, z - 1);
+            } else {
+                quad[0] = getVertex(x - 1, y - 1, z); quad[1] = getVertex(x, y - 1, z);
+                quad[2] = getVertex(x, y, z); quad[3] = getVertex(x - 1, y, z);
+            }
+            if (quad[0] < 0 || quad[1] < 0 || quad[2] < 0 || quad[3] < 0) continue;
+
+            // Dentro (negativo) no início da aresta: a normal aponta para +eixo
+            if (a < 0.0f) {
+                meshCell.triangles.insert(meshCell.triangles.end(), {quad[0], quad[1], quad[2], quad[0], quad[2], quad[3]});
+            } else {
+                meshCell.triangles.insert(meshCell.triangles.end(), {quad[0], quad[2], quad[1], quad[0], quad[3], quad[2]});
+            }
+        }
+    }
+}
+
+/**
+ * @brief Extract the surface of the pruned cells.
+ *
+ * @param [in] scene Scene with primitives and binary operations.
+ * @param [in] grid Pruning grid with far-fields (cells without tree are skipped).
+ * @param [in] resolution Voxels per cell axis.
+ * @param [out] mesh Welded triangle mesh.
+ * @param [in] threads Number of threads (0 for the hardware concurrency).
+ */
+void extractMesh(const Scene& scene, const PruningGrid& grid, int resolution, Mesh& mesh, int threads = 0){
+    std::vector<int> cellSlot(grid.cells.size(), -1);
+    std::vector<MeshCell> meshCells;
+    for (int i = 0; i < (int)grid.cells.size(); i++) {
+        if (grid.cells[i].size == 0) continue;
+        cellSlot[i] = meshCells.size();
+        meshCells.emplace_back();
+        meshCells.back().cell = i;
+    }
+
+    parallelFor(meshCells.size(), threads, [&](int i){ sampleMeshCell(scene, grid, resolution, meshCells[i]); });
+
+    int vertexCount = 0;
+    for (MeshCell& meshCell : meshCells) {
+        meshCell.firstVertex = vertexCount;
+        vertexCount += meshCell.positions.size();
+    }
+
+    parallelFor(meshCells.size(), threads, [&](int i){
+        triangulateMeshCell(grid, resolution, cellSlot, meshCells, meshCells[i]);
+    });
+
+    mesh.vertices.clear();
+    mesh.normals.clear();
+    mesh.triangles.clear();
+    mesh.vertices.reserve(vertexCount);
+    mesh.normals.reserve(vertexCount);
+    for (const MeshCell& meshCell : meshCells) {
+        mesh.vertices.insert(mesh.vertices.end(), meshCell.positions.begin(), meshCell.positions.end());
+        mesh.normals.insert(mesh.normals.end(), meshCell.normals.begin(), meshCell.normals.end());
+        mesh.triangles.insert(mesh.triangles.end(), meshCell.triangles.begin(), meshCell.triangles.end());
+    }
+}
+
+/**
+ * @brief Write a mesh as binary little-endian PLY.
+ *
+ * @param [in] path File path.
+ * @param [in] mesh Mesh to write.
+ * @return False if the file could not be written.
+ */
+bool writePLY(const char* path, const Mesh& mesh){
+    FILE* file = std::fopen(path, "wb");
+    if (file == nullptr) return false;
+
+    int faces = mesh.triangles.size() / 3;
+    std::fprintf(file, "ply\nformat binary_little_endian 1.0\n");
+    std::fprintf(file, "element vertex %zu\n", mesh.vertices.size());
+    std::fprintf(file, "property float x\nproperty float y\nproperty float z\n");
+    std::fprintf(file, "property float nx\nproperty float ny\nproperty float nz\n");
+    std::fprintf(file, "element face %d\nproperty list uchar int vertex_indices\nend_header\n", faces);
+
+    for (size_t i = 0; i < mesh.vertices.size(); i++) {
+        float v[6] = {mesh.vertices[i].x, mesh.vertices[i].y, mesh.vertices[i].z,
+                      mesh.normals[i].x, mesh.normals[i].y, mesh.normals[i].z};
+        std::fwrite(v, sizeof(float), 6, file);
+    }
+    for (int i = 0; i < faces; i++) {
+        uint8_t count = 3;
+        std::fwrite(&count, 1, 1, file);
+        std::fwrite(&mesh.triangles[i * 3], sizeof(int), 3, file);
+    }
+
+    return std::fclose(file) == 0;
+}
+
+/**
+ * @brief Write a mesh as Wavefront OBJ.
+ *
+ * @param [in] path File path.
+ * @param [in] mesh Mesh to write.
+ * @return False if the file could not be written.
+ */
+bool writeOBJ(const char* path, const Mesh& mesh){
+    FILE* file = std::fopen(path, "w");
+    if (file == nullptr) return false;
+
+    for (const vec3& v : mesh.vertices) std::fprintf(file, "v %.6f %.6f %.6f\n", v.x, v.y, v.z);
+    for (const vec3& n : mesh.normals) std::fprintf(file, "vn %.6f %.6f %.6f\n", n.x, n.y, n.z);
+    for (size_t i = 0; i < mesh.triangles.size(); i += 3) {
+        int a = mesh.triangles[i] + 1, b = mesh.triangles[i + 1] + 1, c = mesh.triangles[i + 2] + 1;
+        std::fprintf(file, "f %d//%d %d//%d %d//%d\n", a, a, b, b, c, c);
+    }
+
+    return std::fclose(file) == 0;
+}
+
+#endif
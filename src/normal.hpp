@@ -0,0 +1,108 @@
+/**
+ * @file normal.hpp
+ * @brief Normal estimators of the normal/phong*Points.frag shaders.
+ *
+ * Every estimator is a stencil of directions around the point: 4 points (forward differences
+ * with the value at the point, phong4Points.frag), 6 points (central differences,
+ * phong6Points.frag), 18 points (the 3x3x3 neighbors without the corners, phong18Points.frag)
+ * and 26 points (all neighbors, phong26Points.frag), each direction weighted by the inverse
+ * of its length. The scalar version calls the SDF once per stencil point, the packet version
+ * evaluates all the stencil points with one call (sdfPacket() of query.hpp).
+ *
+ * @author Edson Martinelli
+ * @date 2026
+ */
+
+#ifndef NORMAL_HPP
+#define NORMAL_HPP
+
+#include <cmath>
+#include <cstdlib>
+#include "vector.hpp"
+
+const float NORMAL_H = 1e-4f; /**< Stencil offset (hOffset of the shaders). */
+const int NORMAL_STENCIL_MAX = 26; /**< Largest stencil. */
+
+/**
+ * @brief Directions and weights of an estimator.
+ */
+struct NormalStencil{
+    int points; /**< Estimator (4, 6, 18 or 26 points). */
+    int count; /**< SDF evaluations (3 for the 4 points estimator, it reuses the value at the point). */
+    bool forward; /**< Subtract the value at the point (4 points estimator). */
+    vec3 directions[NORMAL_STENCIL_MAX]; /**< Offset direction of each evaluation. */
+    float weights[NORMAL_STENCIL_MAX]; /**< Weight of each evaluation. */
+};
+
+/**
+ * @brief Build the stencil of an estimator.
+ *
+ * @param [in] points Estimator (4, 6, 18 or 26 points).
+ * @param [out] stencil Directions and weights.
+ */
+void getNormalStencil(int points, NormalStencil& stencil){
+    stencil.points = points;
+    stencil.count = 0;
+    stencil.forward = points == 4;
+    for (int z = -1; z <= 1; z++)
+    for (int y = -1; y <= 1; y++)
+    for (int x = -1; x <= 1; x++) {
+        int v = std::abs(x) + std::abs(y) + std::abs(z);
+        if (v == 0) continue;
+        if (points == 4 && (v > 1 || x + y + z < 0)) continue;
+        if (points == 6 && v > 1) continue;
+        if (points == 18 && v == 3) continue;
+        vec3 direction = {(float)x, (float)y, (float)z};
+        stencil.directions[stencil.count] = direction;
+        stencil.weights[stencil.count] = 1.0f / length(direction);
+        stencil.count++;
+    }
+}
+
+/**
+ * @brief Normal estimation, one SDF call per stencil point.
+ *
+ * @param [in] p 3D space position.
+ * @param [in] value SDF value at the position (used by the 4 points estimator).
+ * @param [in] stencil Estimator stencil.
+ * @param [in] f SDF, called as f(vec3).
+ * @param [in] h Stencil offset.
+ * @return The normalized normal.
+ */
+template <typename F>
+vec3 getNormal(vec3 p, float value, const NormalStencil& stencil, F&& f, float h = NORMAL_H){
+    vec3 normal = {0.0f, 0.0f, 0.0f};
+    float base = stencil.forward ? value : 0.0f;
+    for (int i = 0; i < stencil.count; i++) {
+        float r = f(p + stencil.directions[i] * h) - base;
+        normal = normal + stencil.directions[i] * (r * stencil.weights[i]);
+    }
+    return normalize(normal);
+}
+
+/**
+ * @brief Normal estimation, all the stencil points in one SDF call.
+ *
+ * @param [in] p 3D space position.
+ * @param [in] value SDF value at the position (used by the 4 points estimator).
+ * @param [in] stencil Estimator stencil.
+ * @param [in] f Packet SDF, called as f(const vec3* points, int count, float* values).
+ * @param [in] h Stencil offset.
+ * @return The normalized normal.
+ */
+template <typename F>
+vec3 getNormalPacket(vec3 p, float value, const NormalStencil& stencil, F&& f, float h = NORMAL_H){
+    vec3 points[NORMAL_STENCIL_MAX] = {};
+    float values[NORMAL_STENCIL_MAX];
+    for (int i = 0; i < stencil.count; i++) points[i] = p + stencil.directions[i] * h;
+    f(points, stencil.count, values);
+
+    vec3 normal = {0.0f, 0.0f, 0.0f};
+    float base = stencil.forward ? value : 0.0f;
+    for (int i = 0; i < stencil.count; i++) {
+        normal = normal + stencil.directions[i] * ((values[i] - base) * stencil.weights[i]);
+    }
+    return normalize(normal);
+}
+
+#endif
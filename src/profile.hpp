@@ -0,0 +1,236 @@
+/**
+ * @file profile.hpp
+ * @brief 2D profile factorization of the extruded primitives.
+ *
+ * Every primitive except the floor is opExtrusion(p, profile(p.xy), depth). Points of one
+ * column (same x and y) share the profiles, so a column query computes them once and only
+ * applies the extrusion per z. opExtrusion is non-decreasing in the profile value, so it
+ * commutes with hard min/max: a subtree of hard operations over extrusions of the same depth,
+ * without complements inside, is evaluated in 2D once per column and extruded once per z.
+ *
+ * @author Edson Martinelli
+ * @date 2026
+ */
+
+#ifndef PROFILE_HPP
+#define PROFILE_HPP
+
+#include <cmath>
+#include <vector>
+#include "shape.hpp"
+#include "vector.hpp"
+#include "bounds.hpp"
+#include "evaluator.hpp"
+
+/**
+ * @brief Factorization of a tree.
+ */
+struct ProfilePlan{
+    std::vector<int> factorRoot; /**< At the first node of a factored subtree, its root (-1 otherwise). */
+    std::vector<float> depth; /**< Extrusion depth of each factored subtree root. */
+    int factored; /**< Number of factored subtrees. */
+    int merged; /**< Primitives inside factored subtrees with more than one primitive. */
+};
+
+/**
+ * @brief Whether a primitive is an extrusion.
+ *
+ * @param [in] pr Primitive.
+ * @param [out] depth Extrusion depth.
+ * @return True for extruded primitives.
+ */
+bool getExtrusionDepth(const Primitive& pr, float& depth){
+    switch (pr.type) {
+        case PRIMITIVE_CYLINDER:
+        case PRIMITIVE_BOX:
+            depth = pr.depth;
+            return true;
+        case PRIMITIVE_PLANE_CUTTER:
+            depth = 0.51f;
+            return true;
+        default:
+            return false;
+    }
+}
+
+/**
+ * @brief 2D profile of an extruded primitive.
+ *
+ * @param [in] p 2D space position.
+ * @param [in] pr Extruded primitive.
+ * @return The correct value of the 2D SDF at the position.
+ */
+float evalProfile(vec2 p, const Primitive& pr){
+    switch (pr.type) {
+        case PRIMITIVE_CYLINDER:
+            return sdCircleProfile(p, {pr.offsetX, pr.offsetY}, pr.r);
+        case PRIMITIVE_BOX:
+            return sdOBoxProfile(p, {pr.sideCenterX, pr.sideCenterY}, pr.m, pr.xEnd, pr.th);
+        case PRIMITIVE_PLANE_CUTTER:
+            return sdPlaneCutterProfile(p);
+        default:
+            return 1e20f;
+    }
+}
+
+/**
+ * @brief Find the largest factored subtrees.
+ *
+ * A node is factorable when it is an extruded primitive, or a hard operation whose operands
+ * all have sign 1, are factorable and share the depth.
+ *
+ * @param [in] scene Scene with primitives and binary operations.
+ * @param [in] nodes Post-order node array.
+ * @param [in] size Number of nodes.
+ * @param [out] plan Factored subtrees.
+ */
+void compileProfilePlan(const Scene& scene, const Node* nodes, int size, ProfilePlan& plan){
+    std::vector<int> start;
+    std::vector<int> children;
+    std::vector<bool> factorable(size, false);
+    getSubtreeStarts(nodes, size, start);
+    plan.factorRoot.assign(size, -1);
+    plan.depth.assign(size, 0.0f);
+    plan.factored = 0;
+    plan.merged = 0;
+
+    for (int i = 0; i < size; i++) {
+        const Node& node = nodes[i];
+        if (node.type == NODE_PRIMITIVE) {
+            factorable[i] = getExtrusionDepth(scene.primitives[node.index], plan.depth[i]);
+            continue;
+        }
+        if (scene.binaryOperations[node.index].k != 0) continue;
+
+        getChildren(start, i, children);
+        bool ok = true;
+        for (int child : children) {
+            ok = ok && factorable[child] && nodes[child].sign == 1 && plan.depth[child] == plan.depth[children[0]];
+        }
+        factorable[i] = ok;
+        plan.depth[i] = plan.depth[children[0]];
+    }
+
+    for (int i = 0; i < size; i++) {
+        int parent = nodes[i].parent;
+        if (factorable[i] && (parent < 0 || !factorable[parent])) {
+            plan.factorRoot[start[i]] = i;
+            plan.factored++;
+            if (i > start[i]) {
+                for (int j = start[i]; j <= i; j++) plan.merged += nodes[j].type == NODE_PRIMITIVE;
+            }
+        }
+    }
+}
+
+/**
+ * @brief 2D value of a factored subtree.
+ *
+ * @param [in] p 2D space position.
+ * @param [in] scene Scene with primitives and binary operations.
+ * @param [in] nodes Post-order node array.
+ * @param [in] first First node of the subtree.
+ * @param [in] root Root node of the subtree.
+ * @return Profile of the subtree, without the root sign.
+ */
+float evalProfileTree(vec2 p, const Scene& scene, const Node* nodes, int first, int root){
+    float stack[STACK_MAX];
+    int stackParent[STACK_MAX];
+    int stackIndex = 0;
+
+    for (int i = first; i <= root; i++) {
+        const Node& node = nodes[i];
+        float d;
+        if (node.type == NODE_PRIMITIVE) {
+            d = evalProfile(p, scene.primitives[node.index]);
+        } else {
+            int count = node.type == NODE_NARY ? 1 : 2;
+            stackIndex -= count;
+            d = foldOperation(scene.binaryOperations[node.index], stack + stackIndex, count);
+        }
+        pushValue(scene, nodes, stack, stackParent, stackIndex, d, node.parent);
+    }
+
+    return stack[0];
+}
+
+/**
+ * @brief SDF values along one column.
+ *
+ * The profiles of the factored subtrees are computed once, then each z only runs the
+ * extrusions and the operations above them.
+ *
+ * @param [in] xy Column position.
+ * @param [in] z Z coordinate of each sample.
+ * @param [in] count Number of samples.
+ * @param [in] scene Scene with primitives and binary operations.
+ * @param [in] nodes Post-order node array.
+ * @param [in] size Number of nodes.
+ * @param [in] plan Factored subtrees (see compileProfilePlan).
+ * @param [in,out] profiles Scratch buffer of at least size values, owned by the caller.
+ * @param [out] values SDF value of each sample.
+ */
+void sdfColumn(vec2 xy, const float* z, int count, const Scene& scene, const Node* nodes, int size,
+               const ProfilePlan& plan, float* profiles, float* values){
+    for (int i = 0; i < size; i++) {
+        int root = plan.factorRoot[i];
+        if (root < 0) continue;
+        profiles[root] = evalProfileTree(xy, scene, nodes, i, root);
+        i = root;
+    }
+
+    for (int k = 0; k < count; k++) {
+        vec3 p = {xy.x, xy.y, z[k]};
+        float stack[STACK_MAX];
+        int stackParent[STACK_MAX];
+        int stackIndex = 0;
+
+        for (int i = 0; i < size; i++) {
+            int root = plan.factorRoot[i];
+            int current = root >= 0 ? root : i;
+            const Node& node = nodes[current];
+            float d;
+            if (root >= 0) {
+                d = opExtrusion(p, profiles[root], plan.depth[root]);
+                i = root;
+            } else if (node.type == NODE_PRIMITIVE) {
+                d = evalPrimitive(p, scene.primitives[node.index]);
+            } else {
+                int operands = node.type == NODE_NARY ? 1 : 2;
+                stackIndex -= operands;
+                d = foldOperation(scene.binaryOperations[node.index], stack + stackIndex, operands);
+            }
+            pushValue(scene, nodes, stack, stackParent, stackIndex, d * node.sign, node.parent);
+        }
+
+        values[k] = stack[0];
+    }
+}
+
+/**
+ * @brief SDF values of a batch of columns.
+ *
+ * The profiles are computed once per entry of xy, so the caller must group the points of
+ * equal x and y into one column beforehand: scattered points passed as columns of one
+ * sample each pay the profiles and the extrusions and gain nothing over sdf().
+ *
+ * @param [in] xy Position of each column.
+ * @param [in] columns Number of columns.
+ * @param [in] z Z coordinate of the samples, the same for every column.
+ * @param [in] count Number of samples per column.
+ * @param [in] scene Scene with primitives and binary operations.
+ * @param [in] nodes Post-order node array.
+ * @param [in] size Number of nodes.
+ * @param [in] plan Factored subtrees (see compileProfilePlan).
+ * @param [in,out] profiles Scratch buffer, resized to size and kept by the caller between calls.
+ * @param [out] values SDF values, count per column (column major).
+ */
+void sdfColumns(const vec2* xy, int columns, const float* z, int count, const Scene& scene, const Node* nodes,
+                int size, const ProfilePlan& plan, std::vector<float>& profiles, float* values){
+    if ((int)profiles.size() < size) profiles.resize(size);
+    for (int c = 0; c < columns; c++) {
+        sdfColumn(xy[c], z, count, scene, nodes, size, plan, profiles.data(), values + (size_t)c * count);
+    }
+}
+
+#endif
@@ -0,0 +1,572 @@
+/**
+ * @file pruning.hpp
+ * @brief CPU port of the Lipschitz pruning compute shaders.
+ *
+ * Same algorithm as lipschitzPruning/compute/pruningFarFields.comp.glsl (and pruning.comp.glsl
+ * when far-fields are disabled): each level splits the parent cell in 4x4x4 cells, evaluates the
+ * parent tree at the cell center and drops the nodes that cannot change the result inside the
+ * cell. The interval mode bounds each node over the whole cell box with interval.hpp
+ * instead of widening the center value by the cell radius.
+ *
+ * @author Edson Martinelli
+ * @date 2026
+ */
+
+#ifndef PRUNING_HPP
+#define PRUNING_HPP
+
+#include <cmath>
+#include <chrono>
+#include <vector>
+#include <algorithm>
+#include "shape.hpp"
+#include "vector.hpp"
+#include "evaluator.hpp"
+#include "interval.hpp"
+#include "stats.hpp"
+
+#define NODESTATE_ACTIVE 0 /**< Define node state as active.*/
+#define NODESTATE_SKIPPED 1 /**< Define node state as skipped.*/
+#define NODESTATE_INACTIVE 2 /**< Define node state as innactive.*/
+
+/**
+ * @brief Pruning output: one reduced tree (or far-field value) per cell.
+ */
+struct PruningGrid{
+    AABB aabb; /**< Grid extent. */
+    int subdivisions; /**< Cells per axis. */
+    std::vector<CellInfo> cells; /**< Tree of each cell in the nodes array. */
+    std::vector<Node> nodes; /**< Reduced trees of all cells. */
+    std::vector<float> farFieldValues; /**< Distance bound of cells without tree. */
+    std::vector<float> farFieldCorners; /**< Distance bound at the 8 corners of the cells without tree (see getCornerFarField), empty when not built. */
+};
+
+/**
+ * @brief Post order evaluation stack item.
+ */
+struct PruningStack{
+    float value; /**< Node value.*/
+    int index; /**< Node index in cell (global index - offset).*/
+};
+
+/**
+ * @brief Post order interval evaluation stack item.
+ */
+struct IntervalStack{
+    interval value; /**< Node value bounds in the cell.*/
+    int index; /**< Node index in cell (global index - offset).*/
+};
+
+/**
+ * @brief Pruning state of a node.
+ */
+struct NodeState{
+    int state; /**< Node current state.*/
+    bool inactiveAncestors; /**< Innactive parent mark.*/
+    int sign; /**< Current signal used by the parent in the node calculation.*/
+    int parent; /**< Current parent node. */
+};
+
+/**
+ * @brief Get cell index from cell coordinates.
+ *
+ * @param [in] x Cell coordinate in X axis.
+ * @param [in] y Cell coordinate in Y axis.
+ * @param [in] z Cell coordinate in Z axis.
+ * @param [in] size Subdivisions per axis.
+ * @return The index of the cell.
+ */
+int getCellIndex(int x, int y, int z, int size){
+    return (z * size * size) + (y * size) + x;
+}
+
+/**
+ * @brief Write the active nodes of a cell.
+ *
+ * Mark the nodes below inactive ones, move the children of skipped nodes to the next
+ * active ancestor and append the remaining nodes to the output array.
+ *
+ * @param [in] parentNodes Tree of the parent cell.
+ * @param [in] parentSize Number of nodes of the parent tree.
+ * @param [in,out] states Pruning state of each node.
+ * @param [out] nodesOutput Array where the reduced tree is appended.
+ * @return Reduced tree of the cell.
+ */
+CellInfo compactCell(const Node* parentNodes, int parentSize, std::vector<NodeState>& states, std::vector<Node>& nodesOutput){
+    int numGlobalActives = 0;
+    for (int i = parentSize - 1; i >= 0; i--) {
+        if (states[i].state == NODESTATE_INACTIVE) {
+            states[i].inactiveAncestors = true;
+        } else {
+            int parentIndex = states[i].parent;
+            bool hasInactiveAncestors = parentIndex >= 0 ? states[parentIndex].inactiveAncestors : false;
+            states[i].inactiveAncestors = hasInactiveAncestors;
+            bool isGlobalActive = states[i].state == NODESTATE_ACTIVE && !hasInactiveAncestors;
+
+            if (parentIndex >= 0 && states[parentIndex].state == NODESTATE_SKIPPED) {
+                states[i].parent = states[parentIndex].parent;
+                states[i].sign *= states[parentIndex].sign;
+            }
+
+            if (isGlobalActive) {
+                numGlobalActives++;
+            }
+        }
+    }
+
+    CellInfo newCell = {(int)nodesOutput.size(), numGlobalActives};
+
+    std::vector<int> oldToNewIndex(parentSize, -1);
+    int currentIdx = 0;
+    for (int i = 0; i < parentSize; i++) {
+        if (states[i].state == NODESTATE_ACTIVE && !states[i].inactiveAncestors) {
+            oldToNewIndex[i] = currentIdx++;
+        }
+    }
+
+    for (int i = 0; i < parentSize; i++) {
+        if (states[i].state == NODESTATE_ACTIVE && !states[i].inactiveAncestors) {
+            Node node = parentNodes[i];
+            node.parent = states[i].parent >= 0 ? oldToNewIndex[states[i].parent] : -1;
+            node.sign = states[i].sign;
+            nodesOutput.push_back(node);
+        }
+    }
+
+    return newCell;
+}
+
+/**
+ * @brief Prune one cell.
+ *
+ * Body of the compute shader main() for one invocation. The operands of an n-ary node are
+ * dropped one by one, and the node is skipped when only one of them is left.
+ *
+ * @param [in] scene Scene with primitives and binary operations.
+ * @param [in] parentNodes Tree of the parent cell.
+ * @param [in] parentSize Number of nodes of the parent tree.
+ * @param [in] cellCenter Center of the cell.
+ * @param [in] R Half diagonal of the cell.
+ * @param [in] farFields Empty the cell when the surface is farther than the cell (far-fields).
+ * @param [out] nodesOutput Array where the reduced tree is appended.
+ * @param [out] farFieldValue Distance bound when the cell is emptied.
+ * @return Reduced tree of the cell.
+ */
+CellInfo pruneCell(const Scene& scene, const Node* parentNodes, int parentSize, vec3 cellCenter, float R,
+                   bool farFields, std::vector<Node>& nodesOutput, float& farFieldValue){
+    std::vector<NodeState> states(parentSize);
+    std::vector<PruningStack> stack(parentSize);
+    int stateIndex = 0;
+    int stackIndex = 0;
+
+    for (int i = 0; i < parentSize; i++) {
+        const Node& node = parentNodes[i];
+        int si = node.sign;
+
+        float d = 0.0f;
+        NodeState newState;
+        if (node.type == NODE_BINARY || node.type == NODE_NARY) {
+            const BinaryOperation& binaryOperation = scene.binaryOperations[node.index];
+            float k = binaryOperation.k;
+            int s = binaryOperation.s;
+
+            int count = 2;
+            if (node.type == NODE_NARY) {
+                count = 0;
+                while (count < stackIndex && parentNodes[stack[stackIndex - 1 - count].index].parent == i) count++;
+            }
+            stackIndex -= count;
+            const PruningStack* operands = &stack[stackIndex];
+
+            d = operands[0].value;
+            for (int j = 1; j < count; j++) {
+                d = s * (std::min(s * d, s * operands[j].value) - smoothFunction(d, operands[j].value, k));
+            }
+
+            // Operando perde na célula toda se fica 2R + k acima dos que vêm antes na dobra
+            // (de qualquer outro quando k = 0)
+            int survivors = count;
+            for (int j = 0; j < count; j++) {
+                int limit = k == 0 ? count : std::max(j, 2);
+                float nearest = INFINITY;
+                for (int o = 0; o < limit; o++) {
+                    if (o != j) nearest = std::min(nearest, s * operands[o].value);
+                }
+                if (s * operands[j].value - nearest > 2 * R + k) {
+                    states[operands[j].index].state = NODESTATE_INACTIVE;
+                    survivors--;
+                }
+            }
+            newState.state = survivors == 1 ? NODESTATE_SKIPPED : NODESTATE_ACTIVE;
+        } else {
+            d = evalPrimitive(cellCenter, scene.primitives[node.index]);
+            newState.state = NODESTATE_ACTIVE;
+        }
+
+        newState.inactiveAncestors = false;
+        newState.parent = node.parent;
+        newState.sign = node.sign;
+        states[stateIndex] = newState;
+
+        stack[stackIndex] = {d * si, stateIndex};
+        stackIndex++;
+        stateIndex++;
+    }
+
+    float d = stack[0].value;
+    if (farFields && std::fabs(d) > 2 * R) {
+        farFieldValue = std::copysign(std::fabs(d) - R, d);
+        return {0, 0};
+    }
+
+    return compactCell(parentNodes, parentSize, states, nodesOutput);
+}
+
+/**
+ * @brief Prune one cell with interval arithmetic.
+ *
+ * Same as pruneCell, but every node is bounded over the cell box. An operand is inactive
+ * when its interval is above the others by more than k (below for a maximum), and the
+ * cell is emptied when the root interval is farther than R from zero, keeping the far-field
+ * guarantee of the Lipschitz mode.
+ *
+ * @param [in] scene Scene with primitives and binary operations.
+ * @param [in] parentNodes Tree of the parent cell.
+ * @param [in] parentSize Number of nodes of the parent tree.
+ * @param [in] cellMinimum Cell minimum point.
+ * @param [in] cellMaximum Cell maximum point.
+ * @param [in] farFields Empty the cell when the surface is farther than the cell (far-fields).
+ * @param [out] nodesOutput Array where the reduced tree is appended.
+ * @param [out] farFieldValue Distance bound when the cell is emptied.
+ * @return Reduced tree of the cell.
+ */
+CellInfo pruneCellInterval(const Scene& scene, const Node* parentNodes, int parentSize, vec3 cellMinimum, vec3 cellMaximum,
+                           bool farFields, std::vector<Node>& nodesOutput, float& farFieldValue){
+    std::vector<NodeState> states(parentSize);
+    std::vector<IntervalStack> stack(parentSize);
+    int stateIndex = 0;
+    int stackIndex = 0;
+
+    for (int i = 0; i < parentSize; i++) {
+        const Node& node = parentNodes[i];
+        int si = node.sign;
+
+        interval d;
+        NodeState newState;
+        if (node.type == NODE_BINARY || node.type == NODE_NARY) {
+            const BinaryOperation& binaryOperation = scene.binaryOperations[node.index];
+            float k = binaryOperation.k;
+            int s = binaryOperation.s;
+
+            int count = 2;
+            if (node.type == NODE_NARY) {
+                count = 0;
+                while (count < stackIndex && parentNodes[stack[stackIndex - 1 - count].index].parent == i) count++;
+            }
+            stackIndex -= count;
+            const IntervalStack* operands = &stack[stackIndex];
+
+            d = operands[0].value;
+            for (int j = 1; j < count; j++) {
+                d = evalBinary(d, operands[j].value, k, s);
+            }
+
+            int survivors = count;
+            for (int j = 0; j < count; j++) {
+                int limit = k == 0 ? count : std::max(j, 2);
+                float nearest = INFINITY;
+                for (int o = 0; o < limit; o++) {
+                    if (o != j) nearest = std::min(nearest, (operands[o].value * (float)s).hi);
+                }
+                if ((operands[j].value * (float)s).lo > nearest + k) {
+                    states[operands[j].index].state = NODESTATE_INACTIVE;
+                    survivors--;
+                }
+            }
+            newState.state = survivors == 1 ? NODESTATE_SKIPPED : NODESTATE_ACTIVE;
+        } else {
+            d = evalPrimitive(cellMinimum, cellMaximum, scene.primitives[node.index]);
+            newState.state = NODESTATE_ACTIVE;
+        }
+
+        newState.inactiveAncestors = false;
+        newState.parent = node.parent;
+        newState.sign = node.sign;
+        states[stateIndex] = newState;
+
+        stack[stackIndex] = {d * (float)si, stateIndex};
+        stackIndex++;
+        stateIndex++;
+    }
+
+    interval d = stack[0].value;
+    float R = length(cellMaximum - cellMinimum) * 0.5f;
+    if (farFields && (d.lo > R || d.hi < -R)) {
+        farFieldValue = d.lo > R ? d.lo : d.hi;
+        return {0, 0};
+    }
+
+    return compactCell(parentNodes, parentSize, states, nodesOutput);
+}
+
+/**
+ * @brief Interpolation error of a cell corner field.
+ *
+ * Bound of the difference between a 1-Lipschitz function and the trilinear interpolation of
+ * its corner values: the weighted distance to the corners, at most sqrt(sum of t(1 - t)h^2
+ * over the axes). Zero at the corners and R at the cell center.
+ *
+ * @param [in] t Position in the cell, [0, 1] per axis.
+ * @param [in] cellSize Cell size.
+ * @return The error bound at the position.
+ */
+float getCornerError(vec3 t, vec3 cellSize){
+    vec3 h = cellSize * cellSize;
+    return std::sqrt(t.x * (1.0f - t.x) * h.x + t.y * (1.0f - t.y) * h.y + t.z * (1.0f - t.z) * h.z);
+}
+
+/**
+ * @brief Lower bound of the distance from the corner values of a cell.
+ *
+ * Corner k is at (k & 1, k >> 1 & 1, k >> 2) in the cell. Each corner value is a lower bound
+ * of the SDF at the corner, so the interpolation minus getCornerError() is a lower bound at
+ * the position.
+ *
+ * @param [in] corners The 8 corner values.
+ * @param [in] t Position in the cell, [0, 1] per axis.
+ * @param [in] cellSize Cell size.
+ * @return The distance bound at the position.
+ */
+float interpolateCorners(const float* corners, vec3 t, vec3 cellSize){
+    float x00 = corners[0] + (corners[1] - corners[0]) * t.x;
+    float x10 = corners[2] + (corners[3] - corners[2]) * t.x;
+    float x01 = corners[4] + (corners[5] - corners[4]) * t.x;
+    float x11 = corners[6] + (corners[7] - corners[6]) * t.x;
+    float y0 = x00 + (x10 - x00) * t.y;
+    float y1 = x01 + (x11 - x01) * t.y;
+    return y0 + (y1 - y0) * t.z - getCornerError(t, cellSize);
+}
+
+/**
+ * @brief Statistics of the cells of a pruning level.
+ *
+ * Shared by buildPruningGrid() and the readback of the compute shader levels in main.cpp.
+ *
+ * @param [in] cells Cells of the level.
+ * @param [in] cellCount Number of cells.
+ * @param [in] nodes Nodes written by the level (numNodes of the compute shader).
+ * @param [in] level Level index.
+ * @param [out] stats Level statistics (the time is kept).
+ */
+void getPruningLevelStats(const CellInfo* cells, int cellCount, long nodes, int level, PruningLevelStats& stats){
+    stats.level = level;
+    stats.subdivisions = 1 << ((level + 1) * 2);
+    stats.cells = cellCount;
+    stats.activeCells = 0;
+    stats.nodes = nodes;
+    stats.maxNodes = 0;
+    long cellNodes = 0;
+    for (int i = 0; i < cellCount; i++) {
+        if (cells[i].size == 0) continue;
+        stats.activeCells++;
+        cellNodes += cells[i].size;
+        stats.maxNodes = std::max(stats.maxNodes, cells[i].size);
+    }
+    stats.meanNodes = stats.activeCells > 0 ? (double)cellNodes / stats.activeCells : 0.0;
+    stats.farFieldFraction = cellCount > 0 ? (double)(cellCount - stats.activeCells) / cellCount : 0.0;
+}
+
+/**
+ * @brief Build the pruning grid.
+ *
+ * Run the GRID_LEVEL loop of main.cpp: level i has 4^(i+1) cells per axis and reads the
+ * cells of level i - 1.
+ *
+ * @param [in] scene Scene with the full tree in scene.nodes.
+ * @param [in] aabb Grid extent.
+ * @param [in] gridLevel Number of pruning levels.
+ * @param [in] farFields Use the far-fields procedure.
+ * @param [out] grid Pruning output of the last level.
+ * @param [in] intervals Bound the nodes over the cell box (pruneCellInterval) instead of the center.
+ * @param [in] corners Also bound the far-field cells at their corners (farFieldCorners).
+ * @param [out] levels Statistics and time of each level, when not null.
+ */
+void buildPruningGrid(const Scene& scene, const AABB& aabb, int gridLevel, bool farFields, PruningGrid& grid,
+                      bool intervals = false, bool corners = false, std::vector<PruningLevelStats>* levels = nullptr){
+    if (levels != nullptr) levels->assign(gridLevel, PruningLevelStats());
+
+    std::vector<CellInfo> cells = {{0, (int)scene.nodes.size()}};
+    std::vector<Node> nodes = scene.nodes;
+    std::vector<float> farFieldValues = {0.0f};
+    std::vector<float> farFieldCorners(corners ? 8 : 0, 0.0f);
+
+    vec3 minimum = {aabb.minimum.x, aabb.minimum.y, aabb.minimum.z};
+    vec3 maximum = {aabb.maximum.x, aabb.maximum.y, aabb.maximum.z};
+
+    for (int level = 0; level < gridLevel; level++) {
+        auto start = std::chrono::steady_clock::now();
+        int subdivisions = 1 << ((level + 1) * 2);
+        int parentSubdivisions = subdivisions / 4;
+        int cellCount = subdivisions * subdivisions * subdivisions;
+
+        std::vector<CellInfo> cellsOutput(cellCount);
+        std::vector<Node> nodesOutput;
+        std::vector<float> farFieldValuesOutput(cellCount, 0.0f);
+        std::vector<float> farFieldCornersOutput(corners ? cellCount * 8 : 0, 0.0f);
+
+        vec3 cellSize = (maximum - minimum) / (float)subdivisions;
+        vec3 parentCellSize = cellSize * 4.0f;
+        float R = length(cellSize) * 0.5f;
+
+        for (int z = 0; z < subdivisions; z++)
+        for (int y = 0; y < subdivisions; y++)
+        for (int x = 0; x < subdivisions; x++) {
+            int cellIndex = getCellIndex(x, y, z, subdivisions);
+            int cellParentIndex = getCellIndex(x / 4, y / 4, z / 4, parentSubdivisions);
+            CellInfo cellParentInfo = cells[cellParentIndex];
+
+            if (cellParentInfo.size == 0) {
+                cellsOutput[cellIndex] = {0, 0};
+                farFieldValuesOutput[cellIndex] = farFieldValues[cellParentIndex];
+                // Cantos da célula filha a partir dos cantos da célula pai
+                for (int k = 0; corners && k < 8; k++) {
+                    vec3 t = vec3{(float)(x % 4 + (k & 1)), (float)(y % 4 + (k >> 1 & 1)), (float)(z % 4 + (k >> 2))} / 4.0f;
+                    farFieldCornersOutput[cellIndex * 8 + k] =
+                        interpolateCorners(&farFieldCorners[cellParentIndex * 8], t, parentCellSize);
+                }
+                continue;
+            }
+
+            const Node* parentNodes = nodes.data() + cellParentInfo.offset;
+            vec3 cellMinimum = minimum + cellSize * vec3{(float)x, (float)y, (float)z};
+            if (intervals) {
+                cellsOutput[cellIndex] = pruneCellInterval(scene, parentNodes, cellParentInfo.size, cellMinimum,
+                                                           cellMinimum + cellSize, farFields, nodesOutput,
+                                                           farFieldValuesOutput[cellIndex]);
+            } else {
+                vec3 cellCenter = minimum + cellSize * vec3{x + 0.5f, y + 0.5f, z + 0.5f};
+                cellsOutput[cellIndex] = pruneCell(scene, parentNodes, cellParentInfo.size, cellCenter, R, farFields,
+                                                   nodesOutput, farFieldValuesOutput[cellIndex]);
+            }
+
+            // A árvore da célula pai é exata nos cantos da célula
+            for (int k = 0; corners && cellsOutput[cellIndex].size == 0 && k < 8; k++) {
+                vec3 corner = cellMinimum + cellSize * vec3{(float)(k & 1), (float)(k >> 1 & 1), (float)(k >> 2)};
+                farFieldCornersOutput[cellIndex * 8 + k] = sdf(corner, scene, parentNodes, cellParentInfo.size);
+            }
+        }
+
+        if (levels != nullptr) {
+            PruningLevelStats& stats = (*levels)[level];
+            stats.time = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+            getPruningLevelStats(cellsOutput.data(), cellCount, nodesOutput.size(), level, stats);
+        }
+
+        cells.swap(cellsOutput);
+        nodes.swap(nodesOutput);
+        farFieldValues.swap(farFieldValuesOutput);
+        farFieldCorners.swap(farFieldCornersOutput);
+    }
+
+    grid.aabb = aabb;
+    grid.subdivisions = 1 << (gridLevel * 2);
+    grid.cells.swap(cells);
+    grid.nodes.swap(nodes);
+    grid.farFieldValues.swap(farFieldValues);
+    grid.farFieldCorners.swap(farFieldCorners);
+}
+
+/**
+ * @brief Check if a point is inside the grid.
+ *
+ * @param [in] p 3D space position.
+ * @param [in] grid Pruning grid.
+ * @return True if the point is inside the grid extent.
+ */
+bool insideGrid(vec3 p, const PruningGrid& grid){
+    return p.x >= grid.aabb.minimum.x && p.y >= grid.aabb.minimum.y && p.z >= grid.aabb.minimum.z &&
+           p.x < grid.aabb.maximum.x && p.y < grid.aabb.maximum.y && p.z < grid.aabb.maximum.z;
+}
+
+/**
+ * @brief Get the grid cell of a point.
+ *
+ * Clamped to the grid like the fragment shader.
+ *
+ * @param [in] p 3D space position.
+ * @param [in] grid Pruning grid.
+ * @return The index of the cell.
+ */
+int getGridCellIndex(vec3 p, const PruningGrid& grid){
+    vec3 minimum = {grid.aabb.minimum.x, grid.aabb.minimum.y, grid.aabb.minimum.z};
+    vec3 maximum = {grid.aabb.maximum.x, grid.aabb.maximum.y, grid.aabb.maximum.z};
+    vec3 cellSize = (maximum - minimum) / (float)grid.subdivisions;
+    vec3 c = (p - minimum) / cellSize;
+    int last = grid.subdivisions - 1;
+    int x = std::clamp((int)c.x, 0, last);
+    int y = std::clamp((int)c.y, 0, last);
+    int z = std::clamp((int)c.z, 0, last);
+    return getCellIndex(x, y, z, grid.subdivisions);
+}
+
+/**
+ * @brief SDF evaluation with the pruning grid.
+ *
+ * Same as sdf() of full3DTreePruningFarFields.frag: far-field value for empty cells and
+ * the reduced tree otherwise.
+ *
+ * @param [in] p 3D space position inside the grid.
+ * @param [in] scene Scene with primitives and binary operations.
+ * @param [in] grid Pruning grid.
+ * @return The SDF value at the position.
+ */
+float sdfGrid(vec3 p, const Scene& scene, const PruningGrid& grid){
+    int cellIndex = getGridCellIndex(p, grid);
+    const CellInfo& cell = grid.cells[cellIndex];
+    if (cell.size == 0) {
+        return grid.farFieldValues[cellIndex];
+    }
+    return sdf(p, scene, grid.nodes.data() + cell.offset, cell.size);
+}
+
+/**
+ * @brief Far-field value from the corner bounds.
+ *
+ * Same as farField() of full3DTreePruningCorners.frag: the largest of the interpolated corner
+ * bound and the center bound of the cell.
+ *
+ * @param [in] p 3D space position inside the grid.
+ * @param [in] grid Pruning grid built with corners.
+ * @param [in] cellIndex Far-field cell of the position.
+ * @return A lower bound of the SDF at the position.
+ */
+float getCornerFarField(vec3 p, const PruningGrid& grid, int cellIndex){
+    vec3 minimum = {grid.aabb.minimum.x, grid.aabb.minimum.y, grid.aabb.minimum.z};
+    vec3 maximum = {grid.aabb.maximum.x, grid.aabb.maximum.y, grid.aabb.maximum.z};
+    vec3 cellSize = (maximum - minimum) / (float)grid.subdivisions;
+    int n = grid.subdivisions;
+    vec3 cell = {(float)(cellIndex % n), (float)(cellIndex / n % n), (float)(cellIndex / (n * n))};
+    vec3 t = (p - minimum) / cellSize - cell;
+    t = {std::clamp(t.x, 0.0f, 1.0f), std::clamp(t.y, 0.0f, 1.0f), std::clamp(t.z, 0.0f, 1.0f)};
+    float value = interpolateCorners(&grid.farFieldCorners[cellIndex * 8], t, cellSize);
+    return std::max(value, grid.farFieldValues[cellIndex]);
+}
+
+/**
+ * @brief SDF evaluation with the pruning grid and the corner far-fields.
+ *
+ * @param [in] p 3D space position inside the grid.
+ * @param [in] scene Scene with primitives and binary operations.
+ * @param [in] grid Pruning grid built with corners.
+ * @return The SDF value at the position.
+ */
+float sdfGridCorners(vec3 p, const Scene& scene, const PruningGrid& grid){
+    int cellIndex = getGridCellIndex(p, grid);
+    const CellInfo& cell = grid.cells[cellIndex];
+    if (cell.size == 0) {
+        return getCornerFarField(p, grid, cellIndex);
+    }
+    return sdf(p, scene, grid.nodes.data() + cell.offset, cell.size);
+}
+
+#endif
@@ -0,0 +1,379 @@
+/**
+ * @file query.hpp
+ * @brief Batched distance and gradient queries over the pruning grid.
+ *
+ * The queries are sorted by cell with a counting sort, so each cell tree is read once for
+ * all its points, and split in chunks run by a worker pool. Inside a chunk the points of the
+ * same cell are evaluated in packets of QUERY_PACKET points: the interpreter walks the tree
+ * once per packet and every node runs a plain loop over the packet, which the compiler can
+ * vectorize. The sort buffers are kept in the SdfQuery and only grow, so a call allocates
+ * nothing once they reach the batch size. Sorting only pays when the cells hold several points:
+ * runs shorter than QUERY_SCALAR_RUN use the scalar evaluator, and a batch whose sampled keys
+ * barely repeat a cell (uniform random points over a fine grid) skips the sort and is evaluated
+ * in the input order, like a plain loop of sdfGrid().
+ *
+ * Points in far-field cells return the far-field value, a bound of the distance with the
+ * right sign, like sdfGrid(). A bound has no gradient, so gradients in those cells use the
+ * full tree with the node bounds (far subtrees replaced by their box distance, see
+ * computeNodeBounds), which still points toward the surface. Points outside the grid use the
+ * full tree with the node bounds for both.
+ *
+ * @author Edson Martinelli
+ * @date 2026
+ */
+
+#ifndef QUERY_HPP
+#define QUERY_HPP
+
+#include <span>
+#include <vector>
+#include <algorithm>
+#include "shape.hpp"
+#include "vector.hpp"
+#include "bounds.hpp"
+#include "evaluator.hpp"
+#include "pruning.hpp"
+#include "threads.hpp"
+
+const int QUERY_PACKET = 32; /**< Points evaluated together by sdfPacket(). */
+const int QUERY_SCALAR_RUN = 2; /**< Shorter runs of a cell use the scalar evaluator. */
+const int QUERY_SAMPLE_STRIDE = 16; /**< Stride of the keys sampled to decide the sort. */
+const int QUERY_CHUNK = 1024; /**< Sorted queries per worker job. */
+const float QUERY_GRADIENT_H = 0.0001f; /**< Central difference offset of the gradients. */
+
+/**
+ * @brief Batched query state.
+ */
+struct SdfQuery{
+    const Scene* scene = nullptr; /**< Scene with primitives and binary operations. */
+    const PruningGrid* grid = nullptr; /**< Pruning grid with far-fields. */
+    std::vector<NodeBound> nodeBounds; /**< Bounds of the full tree. */
+    WorkerPool pool; /**< Workers of the chunks. */
+    std::vector<int> cellStart; /**< Counting sort cursor of each bucket (zero between sorts). */
+    std::vector<int> usedKeys; /**< Buckets with queries, in the order they were found. */
+    std::vector<int> keys; /**< Bucket of each query. */
+    std::vector<int> order; /**< Query indices sorted by bucket. */
+    bool sorted = false; /**< False when the last sort was skipped (queries in input order). */
+};
+
+/**
+ * @brief Primitive evaluation over a packet of points.
+ *
+ * The primitive type is switched once, outside the loop of the points.
+ *
+ * @param [in] p Positions.
+ * @param [in] count Number of positions.
+ * @param [in] pr Primitive.
+ * @param [out] d SDF value at each position.
+ */
+void evalPrimitivePacket(const vec3* p, int count, const Primitive& pr, float* d){
+    switch (pr.type) {
+        case PRIMITIVE_CYLINDER:
+            for (int j = 0; j < count; j++) d[j] = sdCircle(p[j], {pr.offsetX, pr.offsetY}, pr.r, pr.depth);
+            break;
+        case PRIMITIVE_BOX:
+            for (int j = 0; j < count; j++) d[j] = sdOBox(p[j], {pr.sideCenterX, pr.sideCenterY}, pr.m, pr.xEnd, pr.th, pr.depth);
+            break;
+        default:
+            for (int j = 0; j < count; j++) d[j] = evalPrimitive(p[j], pr);
+            break;
+    }
+}
+
+/**
+ * @brief Operation over a packet of operand values.
+ *
+ * Same fold as foldOperation(), one point per column.
+ *
+ * @param [in] operation Operation of the node.
+ * @param [in,out] d First operand values, replaced by the result.
+ * @param [in] operands The other operands, one row of QUERY_PACKET values each.
+ * @param [in] operandCount Number of operands after the first.
+ * @param [in] count Number of points.
+ */
+void foldOperationPacket(const BinaryOperation& operation, float* d, const float (*operands)[QUERY_PACKET],
+                         int operandCount, int count){
+    float k = operation.k;
+    int s = operation.s;
+    for (int o = 0; o < operandCount; o++) {
+        const float* b = operands[o];
+        for (int j = 0; j < count; j++) {
+            d[j] = s * (std::min(s * d[j], s * b[j]) - smoothFunction(d[j], b[j], k));
+        }
+    }
+}
+
+/**
+ * @brief Tree evaluation over a packet of points.
+ *
+ * Same interpreter as sdf(), with one stack entry per node for the whole packet.
+ *
+ * @param [in] p Positions (at most QUERY_PACKET).
+ * @param [in] count Number of positions.
+ * @param [in] scene Scene with primitives and binary operations.
+ * @param [in] nodes Post-order node array.
+ * @param [in] size Number of nodes.
+ * @param [out] values SDF value at each position.
+ */
+void sdfPacket(const vec3* p, int count, const Scene& scene, const Node* nodes, int size, float* values){
+    float stack[STACK_MAX][QUERY_PACKET];
+    int stackParent[STACK_MAX];
+    int stackIndex = 0;
+
+    for (int i = 0; i < size; i++) {
+        const Node& node = nodes[i];
+        float* d = stack[stackIndex];
+        if (node.type == NODE_BINARY || node.type == NODE_NARY) {
+            // Os operandos do nó n-ário já estão dobrados em um valor (ver pushValue)
+            int operands = node.type == NODE_NARY ? 1 : 2;
+            stackIndex -= operands;
+            d = stack[stackIndex];
+            foldOperationPacket(scene.binaryOperations[node.index], d, stack + stackIndex + 1, operands - 1, count);
+        } else {
+            evalPrimitivePacket(p, count, scene.primitives[node.index], d);
+        }
+
+        for (int j = 0; j < count; j++) d[j] *= node.sign;
+        int parent = node.parent;
+        if (stackIndex > 0 && stackParent[stackIndex - 1] == parent && parent >= 0 && nodes[parent].type == NODE_NARY) {
+            foldOperationPacket(scene.binaryOperations[nodes[parent].index], stack[stackIndex - 1], stack + stackIndex, 1, count);
+            continue;
+        }
+        stackParent[stackIndex] = parent;
+        stackIndex++;
+    }
+
+    std::copy(stack[0], stack[0] + count, values);
+}
+
+/**
+ * @brief Prepare the batched queries of a grid.
+ *
+ * @param [out] query Query state (not initialized).
+ * @param [in] scene Scene with primitives and binary operations (kept by reference).
+ * @param [in] grid Pruning grid with far-fields (kept by reference).
+ * @param [in] threads Number of threads (0 for the hardware concurrency).
+ * @param [in] capacity Expected batch size, reserved up front.
+ */
+void initSdfQuery(SdfQuery& query, const Scene& scene, const PruningGrid& grid, int threads = 0, int capacity = 0){
+    query.scene = &scene;
+    query.grid = &grid;
+    query.nodeBounds.resize(scene.nodes.size());
+    computeNodeBounds(scene, scene.nodes.data(), scene.nodes.size(), query.nodeBounds.data());
+    query.cellStart.assign(grid.cells.size() + 1, 0);
+    query.keys.reserve(capacity);
+    query.order.reserve(capacity);
+    startWorkerPool(query.pool, threads);
+}
+
+/**
+ * @brief Stop the workers of the batched queries (the destructor of the pool also does it).
+ *
+ * @param [in,out] query Query state.
+ */
+void freeSdfQuery(SdfQuery& query){
+    stopWorkerPool(query.pool);
+}
+
+/**
+ * @brief Counting sort of the queries by bucket.
+ *
+ * Only the used buckets are visited after the counting, so a batch that touches few cells of
+ * a large grid does not pay for the whole grid; the buckets keep the order they were found,
+ * which is enough to group the queries.
+ *
+ * @param [in,out] query Query state (cellStart grows to buckets entries).
+ * @param [in] count Number of queries.
+ * @param [in] buckets Number of buckets.
+ * @param [in] getKey Function returning the bucket of a query index.
+ * @param [in] minRun Mean queries per used bucket of a sample of the keys below which the sort is
+ * skipped (0 always sorts).
+ */
+template <typename F>
+void sortQueryKeys(SdfQuery& query, int count, int buckets, F&& getKey, int minRun = 0){
+    query.keys.resize(count);
+    query.order.resize(count);
+    if ((int)query.cellStart.size() < buckets) query.cellStart.resize(buckets, 0);
+
+    for (int i = 0; i < count; i++) query.keys[i] = getKey(i);
+
+    // Amostra das chaves: se ela quase não repete baldes, a ordenação não paga
+    query.usedKeys.clear();
+    int stride = minRun > 0 ? QUERY_SAMPLE_STRIDE : 1;
+    int sampled = 0;
+    for (int i = 0; i < count; i += stride, sampled++) {
+        if (query.cellStart[query.keys[i]]++ == 0) query.usedKeys.push_back(query.keys[i]);
+    }
+    query.sorted = sampled >= (int)query.usedKeys.size() * minRun;
+    if (query.sorted && stride > 1) {
+        for (int key : query.usedKeys) query.cellStart[key] = 0;
+        query.usedKeys.clear();
+        for (int i = 0; i < count; i++) {
+            if (query.cellStart[query.keys[i]]++ == 0) query.usedKeys.push_back(query.keys[i]);
+        }
+    }
+    if (query.sorted) {
+        // Ordenação por contagem: a contagem de cada balde vira o seu cursor
+        int start = 0;
+        for (int key : query.usedKeys) {
+            int n = query.cellStart[key];
+            query.cellStart[key] = start;
+            start += n;
+        }
+        for (int i = 0; i < count; i++) query.order[query.cellStart[query.keys[i]]++] = i;
+    }
+    for (int key : query.usedKeys) query.cellStart[key] = 0;
+}
+
+/**
+ * @brief Sort the queries by bucket (grid cell, or the last bucket outside the grid).
+ *
+ * @param [in,out] query Query state.
+ * @param [in] points Query positions.
+ */
+void sortSdfQuery(SdfQuery& query, std::span<const vec3> points){
+    const PruningGrid& grid = *query.grid;
+    int outside = grid.cells.size();
+    // Mesma conta de getGridCellIndex, com o tamanho da célula calculado uma vez por lote
+    vec3 minimum = {grid.aabb.minimum.x, grid.aabb.minimum.y, grid.aabb.minimum.z};
+    vec3 maximum = {grid.aabb.maximum.x, grid.aabb.maximum.y, grid.aabb.maximum.z};
+    vec3 cellSize = (maximum - minimum) / (float)grid.subdivisions;
+    int s = grid.subdivisions;
+    sortQueryKeys(query, points.size(), outside + 1, [&](int i){
+        if (!insideGrid(points[i], grid)) return outside;
+        vec3 c = (points[i] - minimum) / cellSize;
+        return getCellIndex(std::min((int)c.x, s - 1), std::min((int)c.y, s - 1), std::min((int)c.z, s - 1), s);
+    }, QUERY_SCALAR_RUN);
+}
+
+/**
+ * @brief Run a packet function over the sorted queries.
+ *
+ * Each chunk of the sorted order is split in runs of the same bucket, and each run in
+ * packets of at most QUERY_PACKET queries. Without the sort each query is its own run.
+ *
+ * @param [in,out] query Sorted query state.
+ * @param [in] f Function called with (bucket, sorted indices, count).
+ */
+template <typename F>
+void runSdfQuery(SdfQuery& query, F&& f){
+    int count = query.order.size();
+    int chunks = (count + QUERY_CHUNK - 1) / QUERY_CHUNK;
+    auto chunk = [&](int c){
+        int end = std::min((c + 1) * QUERY_CHUNK, count);
+        if (!query.sorted) {
+            for (int i = c * QUERY_CHUNK; i < end; i++) f(query.keys[i], &i, 1);
+            return;
+        }
+        for (int i = c * QUERY_CHUNK; i < end;) {
+            int key = query.keys[query.order[i]];
+            int runEnd = i + 1;
+            while (runEnd < end && query.keys[query.order[runEnd]] == key) runEnd++;
+            for (int j = i; j < runEnd; j += QUERY_PACKET) f(key, query.order.data() + j, std::min(QUERY_PACKET, runEnd - j));
+            i = runEnd;
+        }
+    };
+    runWorkerPool(query.pool, chunks, chunk);
+}
+
+/**
+ * @brief SDF with the full tree and its node bounds.
+ *
+ * @param [in] query Query state.
+ * @param [in] p 3D space position.
+ * @return A lower bound of the SDF, exact near the surface.
+ */
+float sdfQueryFull(const SdfQuery& query, vec3 p){
+    const Scene& scene = *query.scene;
+    return sdf(p, scene, scene.nodes.data(), scene.nodes.size(), query.nodeBounds.data());
+}
+
+/**
+ * @brief SDF values of a batch of points.
+ *
+ * @param [in,out] query Query state.
+ * @param [in] points Query positions.
+ * @param [out] values SDF value of each position (same size as points).
+ */
+void distances(SdfQuery& query, std::span<const vec3> points, std::span<float> values){
+    sortSdfQuery(query, points);
+    const Scene& scene = *query.scene;
+    const PruningGrid& grid = *query.grid;
+    runSdfQuery(query, [&](int key, const int* indices, int count){
+        if (key == (int)grid.cells.size()) {
+            for (int j = 0; j < count; j++) values[indices[j]] = sdfQueryFull(query, points[indices[j]]);
+            return;
+        }
+        const CellInfo& cell = grid.cells[key];
+        if (cell.size == 0) {
+            for (int j = 0; j < count; j++) values[indices[j]] = grid.farFieldValues[key];
+            return;
+        }
+        const Node* nodes = grid.nodes.data() + cell.offset;
+        // Corridas curtas (pontos espalhados) não pagam a cópia e o laço do pacote
+        if (count < QUERY_SCALAR_RUN) {
+            for (int j = 0; j < count; j++) values[indices[j]] = sdf(points[indices[j]], scene, nodes, cell.size);
+            return;
+        }
+        vec3 p[QUERY_PACKET] = {};
+        float v[QUERY_PACKET];
+        for (int j = 0; j < count; j++) p[j] = points[indices[j]];
+        sdfPacket(p, count, scene, nodes, cell.size, v);
+        for (int j = 0; j < count; j++) values[indices[j]] = v[j];
+    });
+}
+
+/**
+ * @brief SDF gradients of a batch of points.
+ *
+ * Central differences with the tree of the point cell (see the header note for far-field
+ * cells). The gradient has unit length where the SDF is exact.
+ *
+ * @param [in,out] query Query state.
+ * @param [in] points Query positions.
+ * @param [out] gradients Gradient at each position (same size as points).
+ */
+void gradients(SdfQuery& query, std::span<const vec3> points, std::span<vec3> gradients){
+    sortSdfQuery(query, points);
+    const Scene& scene = *query.scene;
+    const PruningGrid& grid = *query.grid;
+    const float h = QUERY_GRADIENT_H;
+    runSdfQuery(query, [&](int key, const int* indices, int count){
+        if (key == (int)grid.cells.size() || grid.cells[key].size == 0) {
+            for (int j = 0; j < count; j++) {
+                vec3 p = points[indices[j]];
+                gradients[indices[j]] = vec3{sdfQueryFull(query, p + vec3{h, 0.0f, 0.0f}) - sdfQueryFull(query, p - vec3{h, 0.0f, 0.0f}),
+                                             sdfQueryFull(query, p + vec3{0.0f, h, 0.0f}) - sdfQueryFull(query, p - vec3{0.0f, h, 0.0f}),
+                                             sdfQueryFull(query, p + vec3{0.0f, 0.0f, h}) - sdfQueryFull(query, p - vec3{0.0f, 0.0f, h})} /
+                                        (2.0f * h);
+            }
+            return;
+        }
+        const CellInfo& cell = grid.cells[key];
+        const Node* nodes = grid.nodes.data() + cell.offset;
+        if (count < QUERY_SCALAR_RUN) {
+            auto f = [&](vec3 p){ return sdf(p, scene, nodes, cell.size); };
+            for (int j = 0; j < count; j++) {
+                vec3 p = points[indices[j]];
+                gradients[indices[j]] = vec3{f(p + vec3{h, 0.0f, 0.0f}) - f(p - vec3{h, 0.0f, 0.0f}),
+                                             f(p + vec3{0.0f, h, 0.0f}) - f(p - vec3{0.0f, h, 0.0f}),
+                                             f(p + vec3{0.0f, 0.0f, h}) - f(p - vec3{0.0f, 0.0f, h})} / (2.0f * h);
+            }
+            return;
+        }
+        vec3 p[QUERY_PACKET] = {};
+        float plus[QUERY_PACKET], minus[QUERY_PACKET];
+        float g[3][QUERY_PACKET];
+        for (int axis = 0; axis < 3; axis++) {
+            vec3 offset = {axis == 0 ? h : 0.0f, axis == 1 ? h : 0.0f, axis == 2 ? h : 0.0f};
+            for (int j = 0; j < count; j++) p[j] = points[indices[j]] + offset;
+            sdfPacket(p, count, scene, nodes, cell.size, plus);
+            for (int j = 0; j < count; j++) p[j] = points[indices[j]] - offset;
+            sdfPacket(p, count, scene, nodes, cell.size, minus);
+            for (int j = 0; j < count; j++) g[axis][j] = (plus[j] - minus[j]) / (2.0f * h);
+        }
+        for (int j = 0; j < count; j++) gradients[indices[j]] = {g[0][j], g[1][j], g[2][j]};
+    });
+}
+
+#endif
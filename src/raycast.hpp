@@ -0,0 +1,229 @@
+/**
+ * @file raycast.hpp
+ * @brief Batched ray casts over the pruning grid.
+ *
+ * The rays are clipped to the grid box and sorted by the cell of their entry point in the
+ * previous pruning level (4^3 cells of the grid) and the octant of their direction (the
+ * counting sort of query.hpp), so the rays of a packet start close together and move the
+ * same way. Each packet is marched together: at each step the live rays are grouped by cell
+ * and the rays of a cell with a tree are evaluated together with sdfPacket(). Finished rays
+ * leave the packet.
+ *
+ * The march is the loop of full3DTreePruningFarFields.frag: a ray leaving the grid misses,
+ * a step below RAY_EPSILON hits, and the normal is the central difference of the cell tree.
+ *
+ * @author Edson Martinelli
+ * @date 2026
+ */
+
+#ifndef RAYCAST_HPP
+#define RAYCAST_HPP
+
+#include <cmath>
+#include <span>
+#include <algorithm>
+#include "shape.hpp"
+#include "vector.hpp"
+#include "evaluator.hpp"
+#include "pruning.hpp"
+#include "query.hpp"
+
+/**
+ * @brief Ray of a cast.
+ */
+struct Ray{
+    vec3 origin; /**< Ray origin. */
+    vec3 direction; /**< Normalized ray direction. */
+};
+
+/**
+ * @brief Result of a ray cast.
+ */
+struct Hit{
+    bool hit; /**< The ray reached the surface. */
+    float distance; /**< Distance from the origin to the hit (or where the march stopped). */
+    int steps; /**< SDF evaluations. */
+    vec3 normal; /**< Surface normal at the hit (zero on a miss). */
+};
+
+/**
+ * @brief Clip a ray to the grid box.
+ *
+ * @param [in] ray Ray to clip.
+ * @param [in] grid Pruning grid.
+ * @param [out] tNear Distance where the ray enters the box (0 if the origin is inside).
+ * @param [out] tFar Distance where the ray leaves the box.
+ * @return False if the ray misses the box.
+ */
+bool clipRayGrid(const Ray& ray, const PruningGrid& grid, float& tNear, float& tFar){
+    float origin[3] = {ray.origin.x, ray.origin.y, ray.origin.z};
+    float direction[3] = {ray.direction.x, ray.direction.y, ray.direction.z};
+    float minimum[3] = {grid.aabb.minimum.x, grid.aabb.minimum.y, grid.aabb.minimum.z};
+    float maximum[3] = {grid.aabb.maximum.x, grid.aabb.maximum.y, grid.aabb.maximum.z};
+    tNear = 0.0f;
+    tFar = 1e20f;
+    for (int a = 0; a < 3; a++) {
+        if (direction[a] == 0.0f) {
+            if (origin[a] < minimum[a] || origin[a] >= maximum[a]) return false;
+            continue;
+        }
+        float t0 = (minimum[a] - origin[a]) / direction[a];
+        float t1 = (maximum[a] - origin[a]) / direction[a];
+        tNear = std::max(tNear, std::min(t0, t1));
+        tFar = std::min(tFar, std::max(t0, t1));
+    }
+    return tNear < tFar;
+}
+
+/**
+ * @brief Normal at a hit with the tree of its cell.
+ *
+ * Same central difference as getNormal() of the shaders, normalized.
+ *
+ * @param [in] p Hit position.
+ * @param [in] scene Scene with primitives and binary operations.
+ * @param [in] grid Pruning grid.
+ * @return The normal (zero in a far-field cell).
+ */
+vec3 getGridNormal(vec3 p, const Scene& scene, const PruningGrid& grid){
+    const CellInfo& cell = grid.cells[getGridCellIndex(p, grid)];
+    if (cell.size == 0) return {0.0f, 0.0f, 0.0f};
+    const Node* nodes = grid.nodes.data() + cell.offset;
+    float h = QUERY_GRADIENT_H;
+    vec3 n = {sdf(p + vec3{h, 0.0f, 0.0f}, scene, nodes, cell.size) - sdf(p - vec3{h, 0.0f, 0.0f}, scene, nodes, cell.size),
+              sdf(p + vec3{0.0f, h, 0.0f}, scene, nodes, cell.size) - sdf(p - vec3{0.0f, h, 0.0f}, scene, nodes, cell.size),
+              sdf(p + vec3{0.0f, 0.0f, h}, scene, nodes, cell.size) - sdf(p - vec3{0.0f, 0.0f, h}, scene, nodes, cell.size)};
+    float l = length(n);
+    return l > 0.0f ? n / l : vec3{0.0f, 0.0f, 0.0f};
+}
+
+/**
+ * @brief Cast one ray.
+ *
+ * @param [in] ray Ray to cast.
+ * @param [in] scene Scene with primitives and binary operations.
+ * @param [in] grid Pruning grid with far-fields.
+ * @param [in] maxDistance Maximum hit distance.
+ * @param [in] maxSteps Maximum SDF evaluations.
+ * @return The ray hit.
+ */
+Hit raycastRay(const Ray& ray, const Scene& scene, const PruningGrid& grid, float maxDistance, int maxSteps){
+    Hit hit = {false, maxDistance, 0, {0.0f, 0.0f, 0.0f}};
+    float t, tFar;
+    if (!clipRayGrid(ray, grid, t, tFar)) return hit;
+    tFar = std::min(tFar, maxDistance);
+    while (t < tFar && hit.steps < maxSteps) {
+        vec3 p = ray.origin + ray.direction * t;
+        float r = sdfGrid(p, scene, grid);
+        hit.steps++;
+        if (r < RAY_EPSILON) {
+            hit = {true, t, hit.steps, getGridNormal(p, scene, grid)};
+            break;
+        }
+        t += r;
+    }
+    hit.distance = std::min(t, maxDistance);
+    return hit;
+}
+
+/**
+ * @brief Cast a batch of rays.
+ *
+ * @param [in,out] query Query state of the grid (see initSdfQuery).
+ * @param [in] rays Rays to cast.
+ * @param [out] hits Hit of each ray (same size as rays).
+ * @param [in] maxDistance Maximum hit distance.
+ * @param [in] maxSteps Maximum SDF evaluations per ray.
+ */
+void raycast(SdfQuery& query, std::span<const Ray> rays, std::span<Hit> hits, float maxDistance = 32.0f,
+             int maxSteps = 256){
+    const Scene& scene = *query.scene;
+    const PruningGrid& grid = *query.grid;
+
+    // Agrupa pela célula do nível anterior na entrada e pelo octante da direção
+    int n = std::max(grid.subdivisions / 4, 1);
+    int outside = n * n * n * 8;
+    sortQueryKeys(query, rays.size(), outside + 1, [&](int i){
+        const Ray& ray = rays[i];
+        float tNear, tFar;
+        if (!clipRayGrid(ray, grid, tNear, tFar) || tNear >= maxDistance) return outside;
+        int octant = (ray.direction.x < 0.0f) | (ray.direction.y < 0.0f) << 1 | (ray.direction.z < 0.0f) << 2;
+        int cellIndex = getGridCellIndex(ray.origin + ray.direction * tNear, grid);
+        int s = grid.subdivisions;
+        int coarse = getCellIndex(cellIndex % s * n / s, cellIndex / s % s * n / s, cellIndex / (s * s) * n / s, n);
+        return coarse * 8 + octant;
+    });
+
+    runSdfQuery(query, [&](int key, const int* indices, int count){
+        float t[QUERY_PACKET], tFar[QUERY_PACKET], r[QUERY_PACKET];
+        int steps[QUERY_PACKET], live[QUERY_PACKET];
+        vec3 p[QUERY_PACKET];
+        int liveCount = 0;
+
+        for (int j = 0; j < count; j++) {
+            hits[indices[j]] = {false, maxDistance, 0, {0.0f, 0.0f, 0.0f}};
+            if (key == outside) continue;
+            clipRayGrid(rays[indices[j]], grid, t[j], tFar[j]);
+            tFar[j] = std::min(tFar[j], maxDistance);
+            steps[j] = 0;
+            live[liveCount++] = j;
+        }
+
+        while (liveCount > 0) {
+            int cells[QUERY_PACKET];
+            for (int l = 0; l < liveCount; l++) {
+                int j = live[l];
+                p[l] = rays[indices[j]].origin + rays[indices[j]].direction * t[j];
+                cells[l] = getGridCellIndex(p[l], grid);
+            }
+
+            // Cada célula avalia os seus raios juntos em um pacote
+            bool done[QUERY_PACKET] = {};
+            for (int l = 0; l < liveCount; l++) {
+                if (done[l]) continue;
+                const CellInfo& cell = grid.cells[cells[l]];
+                int group[QUERY_PACKET];
+                vec3 groupP[QUERY_PACKET];
+                float groupR[QUERY_PACKET];
+                int groupCount = 0;
+                for (int m = l; m < liveCount; m++) {
+                    if (done[m] || cells[m] != cells[l]) continue;
+                    done[m] = true;
+                    group[groupCount] = m;
+                    groupP[groupCount++] = p[m];
+                }
+                if (cell.size == 0) {
+                    for (int g = 0; g < groupCount; g++) r[group[g]] = grid.farFieldValues[cells[l]];
+                    continue;
+                }
+                const Node* nodes = grid.nodes.data() + cell.offset;
+                if (groupCount == 1) {
+                    r[l] = sdf(p[l], scene, nodes, cell.size);
+                    continue;
+                }
+                sdfPacket(groupP, groupCount, scene, nodes, cell.size, groupR);
+                for (int g = 0; g < groupCount; g++) r[group[g]] = groupR[g];
+            }
+
+            int next = 0;
+            for (int l = 0; l < liveCount; l++) {
+                int j = live[l];
+                Hit& hit = hits[indices[j]];
+                steps[j]++;
+                if (r[l] < RAY_EPSILON) {
+                    hit = {true, t[j], steps[j], getGridNormal(p[l], scene, grid)};
+                    continue;
+                }
+                t[j] += r[l];
+                if (t[j] >= tFar[j] || steps[j] >= maxSteps) {
+                    hit = {false, std::min(t[j], maxDistance), steps[j], {0.0f, 0.0f, 0.0f}};
+                    continue;
+                }
+                live[next++] = j;
+            }
+            liveCount = next;
+        }
+    });
+}
+
+#endif
@@ -0,0 +1,269 @@
+/**
+ * @file render.hpp
+ * @brief CPU renderer of the pruning grid.
+ *
+ * Same image as full3DTreePruningFarFields.frag: one ray per pixel center from the camera
+ * of the shader, marched over the pruning grid (a ray leaving the grid misses, a step below
+ * RAY_EPSILON hits), colored by the central difference normal of the cell tree over the
+ * vertical background gradient, with gamma correction. A camera outside the grid starts its
+ * rays where they enter it. An unbounded renderer marches on outside the grid with the whole
+ * tree instead, the image of full3DTree.frag. Rows are stored bottom to top like
+ * gl_FragCoord and glReadPixels. The image is split in tiles run by a WorkerPool, and each
+ * pixel can also write its PixelCounters (counters.hpp). With a trace, each tile is a zone on
+ * the thread that ran it, so the load of the workers shows on the timeline.
+ *
+ * @author Edson Martinelli
+ * @date 2026
+ */
+
+#ifndef RENDER_HPP
+#define RENDER_HPP
+
+#include <cmath>
+#include <cstdio>
+#include <vector>
+#include <algorithm>
+#include "shape.hpp"
+#include "vector.hpp"
+#include "evaluator.hpp"
+#include "pruning.hpp"
+#include "raycast.hpp"
+#include "threads.hpp"
+#include "counters.hpp"
+#include "trace.hpp"
+#include "image.hpp"
+
+const int RENDER_TILE = 16; /**< Tile side in pixels. */
+const float RENDER_DISTANCE = 32.0f; /**< Maximun ray distance (D of the shader). */
+const int RENDER_MAX_STEP = 256; /**< Maximun ray steps (MAX_STEP of the shader). */
+const float RENDER_NORMAL_H = 1e-4f; /**< Normal central difference offset. */
+
+/**
+ * @brief Camera of the shaders.
+ */
+struct Camera{
+    vec3 origin; /**< Rays origin. */
+    vec3 lookAt; /**< Rays target position. */
+};
+
+/**
+ * @brief Renderer state.
+ */
+struct Renderer{
+    const Scene* scene = nullptr; /**< Scene with primitives and operations. */
+    const PruningGrid* grid = nullptr; /**< Pruning grid. */
+    std::vector<int> cellPrimitives; /**< Primitives in the tree of each cell. */
+    WorkerPool pool; /**< Workers of the tiles. */
+    Trace* trace = nullptr; /**< Timeline of the images and tiles, null when not tracing. */
+    bool bounded = true; /**< Rays leaving the grid miss (pruning shaders) or march on with the whole tree (full3DTree.frag). */
+};
+
+/**
+ * @brief Start a renderer.
+ *
+ * @param [out] renderer Renderer (not started).
+ * @param [in] scene Scene, kept by pointer.
+ * @param [in] grid Pruning grid, kept by pointer.
+ * @param [in] threads Total threads (0 for the hardware concurrency).
+ */
+void initRenderer(Renderer& renderer, const Scene& scene, const PruningGrid& grid, int threads = 0){
+    renderer.scene = &scene;
+    renderer.grid = &grid;
+    renderer.cellPrimitives.assign(grid.cells.size(), 0);
+    for (size_t i = 0; i < grid.cells.size(); i++) {
+        const CellInfo& cell = grid.cells[i];
+        for (int j = 0; j < cell.size; j++) {
+            renderer.cellPrimitives[i] += grid.nodes[cell.offset + j].type == NODE_PRIMITIVE;
+        }
+    }
+    startWorkerPool(renderer.pool, threads);
+}
+
+/**
+ * @brief Stop the renderer workers.
+ *
+ * @param [in,out] renderer Renderer.
+ */
+void freeRenderer(Renderer& renderer){
+    stopWorkerPool(renderer.pool);
+}
+
+/**
+ * @brief Ray direction of a pixel.
+ *
+ * Same as getDirection() of the shaders at the pixel center.
+ *
+ * @param [in] x Pixel column.
+ * @param [in] y Pixel row, from the bottom.
+ * @param [in] width Image width.
+ * @param [in] height Image height.
+ * @param [in] camera Camera.
+ * @return Normalized ray direction.
+ */
+vec3 getCameraDirection(int x, int y, int width, int height, const Camera& camera){
+    vec3 viewDir = normalize(camera.lookAt - camera.origin);
+    vec3 hViewport = cross(viewDir, vec3{0.0f, 1.0f, 0.0f});
+    vec3 vViewport = cross(hViewport, viewDir);
+    float u = ((x + 0.5f) * 2.0f - width) / height;
+    float v = ((y + 0.5f) * 2.0f - height) / height;
+    return normalize(hViewport * u + vViewport * v + viewDir);
+}
+
+/**
+ * @brief SDF of a cell with counters.
+ *
+ * Same as sdf() of full3DTreePruningFarFields.frag.
+ *
+ * @param [in] p 3D space position.
+ * @param [in] renderer Renderer.
+ * @param [in] cellIndex Cell of the tree, -1 for the whole tree.
+ * @param [in,out] counters Counters of the pixel.
+ * @return The SDF value at the position.
+ */
+float sdfRender(vec3 p, const Renderer& renderer, int cellIndex, PixelCounters& counters){
+    const PruningGrid& grid = *renderer.grid;
+    counters.sdfCalls++;
+    // Fora da grade (só sem limite): a árvore inteira
+    if (cellIndex < 0) {
+        counters.nodes += renderer.scene->nodes.size();
+        counters.primitives += renderer.scene->primitives.size();
+        return sdf(p, *renderer.scene, renderer.scene->nodes.data(), renderer.scene->nodes.size());
+    }
+    const CellInfo& cell = grid.cells[cellIndex];
+    if (cell.size == 0) return grid.farFieldValues[cellIndex];
+    counters.nodes += cell.size;
+    counters.primitives += renderer.cellPrimitives[cellIndex];
+    return sdf(p, *renderer.scene, grid.nodes.data() + cell.offset, cell.size);
+}
+
+/**
+ * @brief Color of a pixel.
+ *
+ * Same as main() of full3DTreePruningFarFields.frag.
+ *
+ * @param [in] renderer Renderer.
+ * @param [in] x Pixel column.
+ * @param [in] y Pixel row, from the bottom.
+ * @param [in] width Image width.
+ * @param [in] height Image height.
+ * @param [in] camera Camera.
+ * @param [out] counters Counters of the pixel.
+ * @return The color with gamma correction (not clamped).
+ */
+vec3 renderPixel(const Renderer& renderer, int x, int y, int width, int height, const Camera& camera,
+                 PixelCounters& counters){
+    const PruningGrid& grid = *renderer.grid;
+    vec3 direction = getCameraDirection(x, y, width, height, camera);
+    counters = PixelCounters();
+
+    float t = 0.0f;
+    int count = 0;
+    // Câmera fora da grade (a dos shaders sem pruning): a marcha começa na entrada do raio
+    if (renderer.bounded && !insideGrid(camera.origin, grid)) {
+        float tFar;
+        t = clipRayGrid({camera.origin, direction}, grid, t, tFar) ? t + RAY_EPSILON : 1e20f;
+    }
+    while (t < RENDER_DISTANCE) {
+        vec3 p = camera.origin + direction * t;
+        bool inside = insideGrid(p, grid);
+        if (!inside && renderer.bounded) {
+            t = 1e20f;
+            break;
+        }
+        float r = sdfRender(p, renderer, inside ? getGridCellIndex(p, grid) : -1, counters);
+        if (r < RAY_EPSILON) break;
+        if (count > RENDER_MAX_STEP) break;
+        t += r;
+        count++;
+    }
+    counters.steps = count;
+
+    float gradient = 1.0f - (y + 0.5f) / height;
+    vec3 color = vec3{0.4f, 0.4f, 1.0f} + vec3{gradient, gradient, gradient};
+    if (t < RENDER_DISTANCE) {
+        vec3 p = camera.origin + direction * t;
+        int cellIndex = insideGrid(p, grid) ? getGridCellIndex(p, grid) : -1;
+        vec3 normal;
+        normal.x = sdfRender(p + vec3{RENDER_NORMAL_H, 0.0f, 0.0f}, renderer, cellIndex, counters) -
+                   sdfRender(p - vec3{RENDER_NORMAL_H, 0.0f, 0.0f}, renderer, cellIndex, counters);
+        normal.y = sdfRender(p + vec3{0.0f, RENDER_NORMAL_H, 0.0f}, renderer, cellIndex, counters) -
+                   sdfRender(p - vec3{0.0f, RENDER_NORMAL_H, 0.0f}, renderer, cellIndex, counters);
+        normal.z = sdfRender(p + vec3{0.0f, 0.0f, RENDER_NORMAL_H}, renderer, cellIndex, counters) -
+                   sdfRender(p - vec3{0.0f, 0.0f, RENDER_NORMAL_H}, renderer, cellIndex, counters);
+        // Normal nula em far-field: fica no meio da escala como normalize(0) * 0.5 + 0.5
+        if (length(normal) > 0.0f) normal = normalize(normal);
+        vec3 c = normal * 0.5f + vec3{0.5f, 0.5f, 0.5f};
+        color = normalize(c * c * 1.2f);
+    }
+    float gamma = 1.0f / 2.2f;
+    return {std::pow(color.x, gamma), std::pow(color.y, gamma), std::pow(color.z, gamma)};
+}
+
+/**
+ * @brief Render an image.
+ *
+ * @param [in,out] renderer Started renderer.
+ * @param [in] camera Camera.
+ * @param [in] width Image width.
+ * @param [in] height Image height.
+ * @param [out] colors Pixel colors, rows from the bottom.
+ * @param [out] counters Counters of each pixel, when not null.
+ */
+void renderImage(Renderer& renderer, const Camera& camera, int width, int height, std::vector<vec3>& colors,
+                 std::vector<PixelCounters>* counters = nullptr){
+    TraceScope imageZone(renderer.trace, "render image", "render");
+    colors.resize(width * height);
+    if (counters != nullptr) counters->resize(width * height);
+
+    int tilesX = (width + RENDER_TILE - 1) / RENDER_TILE;
+    int tilesY = (height + RENDER_TILE - 1) / RENDER_TILE;
+    auto tile = [&](int item){
+        TraceScope tileZone(renderer.trace, "tile", "render", item);
+        int x0 = item % tilesX * RENDER_TILE;
+        int y0 = item / tilesX * RENDER_TILE;
+        PixelCounters pixel;
+        for (int y = y0; y < std::min(y0 + RENDER_TILE, height); y++)
+        for (int x = x0; x < std::min(x0 + RENDER_TILE, width); x++) {
+            colors[y * width + x] = renderPixel(renderer, x, y, width, height, camera, pixel);
+            if (counters != nullptr) (*counters)[y * width + x] = pixel;
+        }
+    };
+    runWorkerPool(renderer.pool, tilesX * tilesY, tile);
+}
+
+/**
+ * @brief Convert rendered colors to an image.
+ *
+ * @param [in] width Image width.
+ * @param [in] height Image height.
+ * @param [in] colors Pixel colors in [0, 1], rows from the bottom.
+ * @param [out] image Image, rows from the bottom.
+ */
+void getImage(int width, int height, const std::vector<vec3>& colors, Image& image){
+    image.width = width;
+    image.height = height;
+    image.pixels.resize((size_t)width * height * 3);
+    for (int i = 0; i < width * height; i++) {
+        const vec3& c = colors[i];
+        image.pixels[i * 3 + 0] = (unsigned char)std::lround(std::clamp(c.x, 0.0f, 1.0f) * 255.0f);
+        image.pixels[i * 3 + 1] = (unsigned char)std::lround(std::clamp(c.y, 0.0f, 1.0f) * 255.0f);
+        image.pixels[i * 3 + 2] = (unsigned char)std::lround(std::clamp(c.z, 0.0f, 1.0f) * 255.0f);
+    }
+}
+
+/**
+ * @brief Write an image as binary PPM.
+ *
+ * @param [in] path File path.
+ * @param [in] width Image width.
+ * @param [in] height Image height.
+ * @param [in] colors Pixel colors in [0, 1], rows from the bottom.
+ * @return False if the file could not be written.
+ */
+bool writePPM(const char* path, int width, int height, const std::vector<vec3>& colors){
+    Image image;
+    getImage(width, height, colors, image);
+    return writeImage(path, image);
+}
+
+#endif
@@ -0,0 +1,238 @@
+/**
+ * @file sampler.hpp
+ * @brief Surface point sampling over the pruned cells.
+ *
+ * Only cells with a tree can hold the surface. The surface area of each one is estimated
+ * from the sign changes of the cell tree on a SAMPLER_LATTICE^3 lattice (a surface crosses
+ * about area * (|nx| + |ny| + |nz|) / h^2 lattice edges, 1.5 area / h^2 on average), and the
+ * points are drawn in a cell chosen with that weight. Each point is projected on the surface
+ * with Newton steps along the normal of its cell tree, and kept if it converges inside the
+ * grid. Near-surface samples are then moved along the normal by a gaussian offset, kept as
+ * the signed distance of the sample (exact while the offset is below the feature size). Cells
+ * whose lattice sees no sign change get no weight, so tiny features inside one lattice
+ * interval can be missed. A sample gives up after SAMPLER_ATTEMPTS rejected points, so a
+ * surface the projection never reaches returns fewer samples instead of looping forever.
+ *
+ * @author Edson Martinelli
+ * @date 2026
+ */
+
+#ifndef SAMPLER_HPP
+#define SAMPLER_HPP
+
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <vector>
+#include <algorithm>
+#include "shape.hpp"
+#include "vector.hpp"
+#include "evaluator.hpp"
+#include "pruning.hpp"
+#include "raycast.hpp"
+#include "threads.hpp"
+
+const int SAMPLER_LATTICE = 4; /**< Lattice intervals per cell axis of the area estimate. */
+const int SAMPLER_CHUNK = 4096; /**< Samples per parallel job (each with its own random seed). */
+const int SAMPLER_ITERATIONS = 8; /**< Newton steps of the projection. */
+const int SAMPLER_ATTEMPTS = 64; /**< Points tried per sample before it is dropped. */
+
+/**
+ * @brief Points sampled on or near the surface.
+ */
+struct SurfaceSamples{
+    std::vector<vec3> points; /**< Sample positions. */
+    std::vector<vec3> normals; /**< Surface normal at each sample. */
+    std::vector<float> distances; /**< Signed distance of each sample (0 on the surface). */
+    long evaluations = 0; /**< SDF evaluations spent, including the rejected points. */
+    long rejected = 0; /**< Points whose projection failed (with all the attempts of the dropped samples). */
+};
+
+/**
+ * @brief Estimated surface area of each cell.
+ *
+ * @param [in] scene Scene with primitives and binary operations.
+ * @param [in] grid Pruning grid.
+ * @param [out] areas Area of each cell (0 for far-field cells).
+ * @return SDF evaluations spent.
+ */
+long getCellAreas(const Scene& scene, const PruningGrid& grid, std::vector<float>& areas){
+    int n = grid.subdivisions;
+    const int s = SAMPLER_LATTICE + 1;
+    vec3 minimum = {grid.aabb.minimum.x, grid.aabb.minimum.y, grid.aabb.minimum.z};
+    vec3 maximum = {grid.aabb.maximum.x, grid.aabb.maximum.y, grid.aabb.maximum.z};
+    vec3 cellSize = (maximum - minimum) / (float)n;
+    vec3 h = cellSize / (float)SAMPLER_LATTICE;
+    float edgeArea = (h.y * h.z + h.x * h.z + h.x * h.y) / 3.0f;
+
+    areas.assign(grid.cells.size(), 0.0f);
+    long evaluations = 0;
+    for (int i = 0; i < (int)grid.cells.size(); i++) {
+        const CellInfo& cell = grid.cells[i];
+        if (cell.size == 0) continue;
+        vec3 cellMinimum = minimum + cellSize * vec3{(float)(i % n), (float)(i / n % n), (float)(i / (n * n))};
+        float v[s][s][s];
+        for (int z = 0; z < s; z++)
+        for (int y = 0; y < s; y++)
+        for (int x = 0; x < s; x++) {
+            vec3 p = cellMinimum + h * vec3{(float)x, (float)y, (float)z};
+            v[z][y][x] = sdf(p, scene, grid.nodes.data() + cell.offset, cell.size);
+        }
+        evaluations += s * s * s;
+
+        int crossings = 0;
+        for (int z = 0; z < s; z++)
+        for (int y = 0; y < s; y++)
+        for (int x = 0; x < s; x++) {
+            bool inside = v[z][y][x] < 0.0f;
+            if (x + 1 < s) crossings += inside != (v[z][y][x + 1] < 0.0f);
+            if (y + 1 < s) crossings += inside != (v[z][y + 1][x] < 0.0f);
+            if (z + 1 < s) crossings += inside != (v[z + 1][y][x] < 0.0f);
+        }
+        areas[i] = crossings * edgeArea / 1.5f;
+    }
+    return evaluations;
+}
+
+/**
+ * @brief Project a point on the surface.
+ *
+ * @param [in,out] p Point to project.
+ * @param [in] scene Scene with primitives and binary operations.
+ * @param [in] grid Pruning grid.
+ * @param [in] tolerance Largest |SDF| accepted on the surface.
+ * @param [out] normal Surface normal at the projected point.
+ * @param [in,out] evaluations Incremented by the SDF evaluations.
+ * @return False if the projection left the grid, reached a far-field cell or did not converge.
+ */
+bool projectToSurface(vec3& p, const Scene& scene, const PruningGrid& grid, float tolerance, vec3& normal,
+                      long& evaluations){
+    for (int i = 0; i < SAMPLER_ITERATIONS; i++) {
+        if (!insideGrid(p, grid)) return false;
+        const CellInfo& cell = grid.cells[getGridCellIndex(p, grid)];
+        if (cell.size == 0) return false;
+        float d = sdf(p, scene, grid.nodes.data() + cell.offset, cell.size);
+        normal = getGridNormal(p, scene, grid);
+        evaluations += 7;
+        if (std::fabs(d) < tolerance) return true;
+        p = p - normal * d;
+    }
+    return false;
+}
+
+/**
+ * @brief Sample points on and near the surface.
+ *
+ * @param [in] scene Scene with primitives and binary operations.
+ * @param [in] grid Pruning grid with far-fields.
+ * @param [in] count Number of samples (fewer are returned if some run out of attempts).
+ * @param [in] sigma Standard deviation of the offset along the normal (0 for surface points).
+ * @param [in] seed Random seed.
+ * @param [out] samples Samples and counters.
+ * @param [in] tolerance Largest |SDF| accepted on the surface.
+ * @param [in] threads Number of threads (0 for the hardware concurrency).
+ */
+void sampleSurface(const Scene& scene, const PruningGrid& grid, int count, float sigma, unsigned int seed,
+                   SurfaceSamples& samples, float tolerance = 1e-4f, int threads = 0){
+    std::vector<float> areas;
+    samples.evaluations = getCellAreas(scene, grid, areas);
+    samples.rejected = 0;
+
+    std::vector<double> cdf(areas.size());
+    double total = 0.0;
+    for (size_t i = 0; i < areas.size(); i++) cdf[i] = total += areas[i];
+
+    samples.points.resize(count);
+    samples.normals.resize(count);
+    samples.distances.resize(count);
+    if (total == 0.0) {
+        samples.points.clear();
+        samples.normals.clear();
+        samples.distances.clear();
+        return;
+    }
+
+    int n = grid.subdivisions;
+    vec3 minimum = {grid.aabb.minimum.x, grid.aabb.minimum.y, grid.aabb.minimum.z};
+    vec3 maximum = {grid.aabb.maximum.x, grid.aabb.maximum.y, grid.aabb.maximum.z};
+    vec3 cellSize = (maximum - minimum) / (float)n;
+
+    int chunks = (count + SAMPLER_CHUNK - 1) / SAMPLER_CHUNK;
+    std::vector<long> evaluations(chunks, 0), rejected(chunks, 0);
+    std::vector<int> filled(chunks, 0);
+    parallelFor(chunks, threads, [&](int c){
+        std::mt19937 rng(seed + c);
+        std::uniform_real_distribution<double> pick(0.0, total);
+        std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+        std::normal_distribution<float> offset(0.0f, sigma > 0.0f ? sigma : 1.0f);
+
+        // Cada amostra tem SAMPLER_ATTEMPTS tentativas; as que falham todas ficam de fora
+        int end = std::min((c + 1) * SAMPLER_CHUNK, count);
+        int i = c * SAMPLER_CHUNK;
+        for (int sample = i; sample < end; sample++) {
+            for (int attempt = 0; attempt < SAMPLER_ATTEMPTS; attempt++) {
+                int cellIndex = std::upper_bound(cdf.begin(), cdf.end(), pick(rng)) - cdf.begin();
+                cellIndex = std::min(cellIndex, (int)cdf.size() - 1);
+                vec3 p = minimum + cellSize * vec3{(float)(cellIndex % n) + unit(rng), (float)(cellIndex / n % n) + unit(rng),
+                                                   (float)(cellIndex / (n * n)) + unit(rng)};
+                vec3 normal;
+                if (!projectToSurface(p, scene, grid, tolerance, normal, evaluations[c])) {
+                    rejected[c]++;
+                    continue;
+                }
+
+                float d = sigma > 0.0f ? offset(rng) : 0.0f;
+                samples.points[i] = p + normal * d;
+                samples.normals[i] = normal;
+                samples.distances[i] = d;
+                i++;
+                break;
+            }
+        }
+        filled[c] = i - c * SAMPLER_CHUNK;
+    });
+
+    // Junta as amostras dos blocos que perderam alguma
+    int kept = 0;
+    for (int c = 0; c < chunks; c++) {
+        samples.evaluations += evaluations[c];
+        samples.rejected += rejected[c];
+        int first = c * SAMPLER_CHUNK;
+        std::copy(samples.points.begin() + first, samples.points.begin() + first + filled[c], samples.points.begin() + kept);
+        std::copy(samples.normals.begin() + first, samples.normals.begin() + first + filled[c], samples.normals.begin() + kept);
+        std::copy(samples.distances.begin() + first, samples.distances.begin() + first + filled[c],
+                  samples.distances.begin() + kept);
+        kept += filled[c];
+    }
+    samples.points.resize(kept);
+    samples.normals.resize(kept);
+    samples.distances.resize(kept);
+}
+
+/**
+ * @brief Write samples as a binary little-endian PLY point cloud.
+ *
+ * @param [in] path File path.
+ * @param [in] samples Samples to write.
+ * @return False if the file could not be written.
+ */
+bool writeSamplesPLY(const char* path, const SurfaceSamples& samples){
+    FILE* file = std::fopen(path, "wb");
+    if (file == nullptr) return false;
+
+    std::fprintf(file, "ply\nformat binary_little_endian 1.0\n");
+    std::fprintf(file, "element vertex %zu\n", samples.points.size());
+    std::fprintf(file, "property float x\nproperty float y\nproperty float z\n");
+    std::fprintf(file, "property float nx\nproperty float ny\nproperty float nz\n");
+    std::fprintf(file, "property float distance\nend_header\n");
+
+    for (size_t i = 0; i < samples.points.size(); i++) {
+        float v[7] = {samples.points[i].x, samples.points[i].y, samples.points[i].z,
+                      samples.normals[i].x, samples.normals[i].y, samples.normals[i].z, samples.distances[i]};
+        std::fwrite(v, sizeof(float), 7, file);
+    }
+
+    return std::fclose(file) == 0;
+}
+
+#endif
@@ -37,6 +37,7 @@
 
 #define NODETYPE_PRIMITIVE 0 /*< Define node type as a primitive.*/
 #define NODETYPE_BINARY 1 /*< Define node type as a binary operation.*/
+#define NODETYPE_NARY 2 /*< Define node type as an operation over all children (parent == node).*/
 
 #define NODESTATE_ACTIVE 0 /*< Define node state as active.*/
 #define NODESTATE_SKIPPED 1 /*< Define node state as skipped.*/
@@ -402,29 +403,43 @@ void main() {
 
         float d;
         NodeState newState;
-        if (node.type == NODETYPE_BINARY) {
+        if (node.type == NODETYPE_BINARY || node.type == NODETYPE_NARY) {
 
             BinaryOperation binaryOperation = binaryOperations.data[node.index];
-            float leftValue = stack[stackIndex - 2].value;
-            float rightValue = stack[stackIndex - 1].value;
-
             float k = binaryOperation.k;
             int s = binaryOperation.s;
 
-            d = s * (min(s * leftValue, s * rightValue) - smoothFunction(leftValue, rightValue, k));
+            // Filhos do nó n-ário: valores no topo da pilha com parent == nó
+            int count = 2;
+            if (node.type == NODETYPE_NARY) {
+                count = 0;
+                while (count < stackIndex && nodes.data[cellParentInfo.offset + stack[stackIndex - 1 - count].index].parent == i - cellParentInfo.offset) {
+                    count++;
+                }
+            }
+            stackIndex -= count;
 
-            if (abs(leftValue - rightValue) <= 2 * R + k) {
-               newState.state = NODESTATE_ACTIVE;
-            } else {
-               newState.state = NODESTATE_SKIPPED;
+            d = stack[stackIndex].value;
+            for (int j = 1; j < count; j++) {
+                float value = stack[stackIndex + j].value;
+                d = s * (min(s * d, s * value) - smoothFunction(d, value, k));
+            }
 
-                if (s * leftValue < s * rightValue) {
-                    states[stack[stackIndex - 1].index].state = NODESTATE_INACTIVE;
-                } else {
-                    states[stack[stackIndex - 2].index].state = NODESTATE_INACTIVE;
+            // Operando perde na célula toda se fica 2R + k acima dos que vêm antes na dobra
+            // (de qualquer outro quando k = 0)
+            int survivors = count;
+            for (int j = 0; j < count; j++) {
+                int limit = k == 0.0 ? count : max(j, 2);
+                float nearest = 1e20;
+                for (int o = 0; o < limit; o++) {
+                    if (o != j) nearest = min(nearest, s * stack[stackIndex + o].value);
+                }
+                if (s * stack[stackIndex + j].value - nearest > 2 * R + k) {
+                    states[stack[stackIndex + j].index].state = NODESTATE_INACTIVE;
+                    survivors--;
                 }
             }
-            stackIndex -=2;
+            newState.state = survivors == 1 ? NODESTATE_SKIPPED : NODESTATE_ACTIVE;
         } else if (node.type == NODETYPE_PRIMITIVE) {
             Primitive primitive = primitives.data[node.index];
             d = evalPrimitive(cellCenter, primitive);
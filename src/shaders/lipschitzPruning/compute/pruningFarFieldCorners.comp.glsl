@@ -0,0 +1,670 @@
+/**
+ * @brief Pruning Algorithm
+ *
+ * Pruning algorithm described by Barbier at el. in the paper Lipschitz Pruning  Hierarchical Simplification 
+ * of Primitive‐Based SDFs with far-fields procedure. Far-field cells also keep the SDF bounds
+ * at their 8 corners, interpolated by the fragment shader (see getCornerFarField in pruning.hpp).
+ *
+ * @author Edson Martinelli
+ * @date 2026
+ */
+
+#version 430 core
+
+/**
+ * @defgroup ComputeVariables Compute Variables 
+ * @brief Variables related to compute shader and parallel programing.
+*/
+
+/**
+ * @defgroup SSBOVariables SSBO Variables 
+ * @brief Variables related to configuration and use of SSBOs.
+*/
+
+/**
+ * @defgroup ConfigVariables Configuration Variables 
+ * @brief Variables related to algorithm configuration.
+*/
+
+/**
+ * @defgroup RayVariables Ray Variables
+ * @brief Variables related to Ray Marching.
+*/
+
+#define PRIMITIVE_CYLINDER 0 /*< Define the number for primitive cylinder (extruded circle). */
+#define PRIMITIVE_BOX 1 /*< Define the number for primitive box (extruded retangle). */
+#define PRIMITIVE_PLANE_CUTTER 2 /*< Define the number for primitive plane cutter (extruded plane with sin).*/
+#define PRIMITIVE_FLOOR 3 /*< Define the number for primitive plane. */
+
+#define NODETYPE_PRIMITIVE 0 /*< Define node type as a primitive.*/
+#define NODETYPE_BINARY 1 /*< Define node type as a binary operation.*/
+#define NODETYPE_NARY 2 /*< Define node type as an operation over all children (parent == node).*/
+
+#define NODESTATE_ACTIVE 0 /*< Define node state as active.*/
+#define NODESTATE_SKIPPED 1 /*< Define node state as skipped.*/
+#define NODESTATE_INACTIVE 2 /*< Define node state as innactive.*/
+
+/**
+ * @ingroup ComputeVariables
+ * @brief Size for each work group.
+*/
+layout(local_size_x = 4, local_size_y = 4, local_size_z = 4) in;
+
+/**
+ * @ingroup SSBOVariables
+ * @brief Binary operation node struct.
+*/
+struct BinaryOperation{
+    float k; /**< Smooth radius.*/
+    int s; /**< Operation constraint: max or min.*/
+    int ca; /**< Value for left node.*/
+    int cb; /**< Value for right node.*/
+};
+
+/**
+ * @ingroup SSBOVariables
+ * @brief Primitive node struct.
+*/
+struct Primitive{
+    //box
+    float sideCenterX; /**< Center point of box origin side in X axis.*/
+    float sideCenterY; /**< Center point of box origin side in Y axis.*/
+    float m; /**<  Box slope.*/
+    float xEnd; /**< X coordenate of the center point of box end side.*/
+    float th; /**< Thickness of the box.*/
+
+    //cylinder
+    float offsetX; /**< Cylinder offset in the X axis.*/
+    float offsetY; /**< Cylinder offset in the Y axis.*/
+    float r; /**< Cylinder radius.*/
+
+    float depth; /**< Extrude depth.*/
+    uint type; /**< Type of primitive.*/
+
+    float pad0, pad1; /**< Paddings for alignment.*/
+};
+
+/**
+ * @ingroup SSBOVariables
+ * @brief General node struct.
+*/
+struct Node{
+    int type; /**< Type of node.*/
+    int index; /**< Index of the position in original array (Primitive or Binary Operation) for the node.*/
+    int sign; /**< Signal used by the parent in the node calculation.*/
+    int parent; /**< Node parent in the node array.*/
+};
+
+/**
+ * @ingroup SSBOVariables
+ * @brief Tree information for the cell.
+*/
+struct CellInfo{
+    int offset; /**< Tree start in the node array for the cell.*/
+    int size;  /**< Tree size in the node array for the cell.*/
+};
+
+/**
+ * @ingroup SSBOVariables
+ * @brief Post order evaluation stack.
+*/
+struct Stack{
+    float value; /**< Node value.*/
+    int index; /**< Node index in cell (global index  - offset).*/
+};
+
+/**
+ * @ingroup SSBOVariables
+ * @brief Post order evaluation stack.
+*/
+struct NodeState{
+    int state; /**< Node current state.*/
+    bool inactiveAncestors; /**< Innactive parent mark.*/
+    int sign; /**< Current signal used by the parent in the node calculation.*/
+    int parent; /**< Current parent node. */
+};
+
+/**
+ * @ingroup SSBOVariables
+ * @brief Primitives node array.
+*/
+layout(std430, binding = 0) readonly buffer PrimitivesBuffer {
+    Primitive data[];
+} primitives;
+
+/**
+ * @ingroup SSBOVariables
+ * @brief Binary Operations node array.
+*/
+layout(std430, binding = 1) readonly buffer BinaryOperationsBuffer {
+    BinaryOperation data[];
+} binaryOperations;
+
+/**
+ * @ingroup SSBOVariables
+ * @brief Input node array.
+*/
+layout(std430, binding = 2) readonly buffer NodesBuffer {
+    Node data[];
+} nodes;
+
+/**
+ * @ingroup SSBOVariables
+ * @brief Input cell node array.
+*/
+layout(std430, binding = 3) readonly buffer CellInfoBuffer {
+    CellInfo data[];
+} cellInfo;
+
+/**
+ * @ingroup SSBOVariables
+ * @brief Output node array.
+*/
+layout(std430, binding = 4) buffer NodesOutputBuffer {
+    Node data[];
+} nodesOutput;
+
+/**
+ * @ingroup SSBOVariables
+ * @brief Output cell node array.
+*/
+layout(std430, binding = 5) buffer CellInfoOutputBuffer {
+    CellInfo data[];
+} cellInfoOutput;
+
+
+/**
+ * @ingroup SSBOVariables
+ * @brief Node counter.
+*/
+layout(std430, binding = 6) buffer NodeCounter {
+    uint numNodes;
+};
+
+/**
+ * @ingroup SSBOVariables
+ * @brief Far-fields values input.
+*/
+layout(std430, binding = 7) buffer FarFieldValuesInputBuffer {
+    float data[];
+} farFieldValuesInput;
+
+/**
+ * @ingroup SSBOVariables
+ * @brief Far-fields values output.
+*/
+layout(std430, binding = 8) buffer FarFieldValuesOutputBuffer {
+    float data[];
+} farFieldValuesOutput;
+
+/**
+ * @ingroup SSBOVariables
+ * @brief Far-fields corner bounds input, 8 per cell (corner k at (k & 1, k >> 1 & 1, k >> 2)).
+*/
+layout(std430, binding = 9) buffer FarFieldCornersInputBuffer {
+    float data[];
+} farFieldCornersInput;
+
+/**
+ * @ingroup SSBOVariables
+ * @brief Far-fields corner bounds output, 8 per cell.
+*/
+layout(std430, binding = 10) buffer FarFieldCornersOutputBuffer {
+    float data[];
+} farFieldCornersOutput;
+
+
+/**
+ * @ingroup ConfigVariables
+ * @brief AABB points to pruning algorithm.
+*/
+layout(std140, binding = 0) uniform AABBData {
+    vec4 maximum;
+    vec4 minimum;
+} aabb;
+
+/**
+ * @ingroup ConfigVariables
+ * @brief Number of espace subdivisions per axis to pruning algorithm.
+*/
+layout(location = 0) uniform int subdivisions;
+
+/**
+ * @ingroup ConfigVariables
+ * @brief Maxmimum number of nodes.
+*/
+const int NODES_MAX = 25;
+
+/**
+ * @ingroup RayVariables
+ * @brief Minimun next step to consider the ray hits a surface (maximun error). 
+*/
+float e = 0.0001;
+
+/**
+ * @brief Smooth minimum function.
+ *
+ * A quadractic polynomial smooth mininum function.
+ *
+ * @param [in] a Point value in the first SDF.
+ * @param [in] b Point value in the second SDF.
+ * @param [in] k Smooth value parameter.
+ * @return Smooth value for given values.
+ */
+float smoothFunction( float a, float b, float k ){
+    if(k == 0) return 0;
+    float d = abs(a - b);
+    float h = max(k - d, 0.0);
+    return h * h * (1.0 / (4.0 * k));
+}
+
+/**
+ * @brief Extrusion operation for 2D SDFs.
+ *
+ * Transform a 2D SDF in a 3D SDF using extrusion.
+ *
+ * @param [in] p Normalized 3D pixel position.
+ * @param [in] sdf 2D SDF value for pixel position.
+ * @param [in] h Extrusion size.
+ * @return Correct value of 3D SDF at p point.
+ */
+float opExtrusion( in vec3 p, in float sdf, in float h ){
+    vec2 w = vec2( sdf, abs(p.z) - h );
+  	return min(max(w.x, w.y), 0.0) + length(max(w, 0.0));
+}
+
+/**
+ * @brief Calculate Y coordenate of the linear equation and return the point.
+ *
+ * Calculate Y coordenate given a origin point in 2D, a slope and x coordenate. After that, this
+ * function returns a point with given x e calculate Y.
+ *
+ * @param [in] origin A point in the line.
+ * @param [in] m Equation slope.
+ * @param [in] x Second point X coordenate.
+ * @return A point (2D) with X coordenate and correspondent Y.
+ */
+vec2 calculateLinearPoint(vec2 origin, float m, float x){
+    float c = (m * origin.x) - origin.y;
+    float y = (m * x) - c;
+    return vec2(x,y);
+}
+
+/**
+ * @brief Plane SDF with sin function used to cut. 
+ *
+ * A SDF function that use sin function to divide the entire world in two parts using a wave
+ * shape.
+ *
+ * @param [in] p Normalized 2D pixel position.
+ * @return The correct value of SDF at the position.
+ */
+float sdPlaneCutter(vec3 p3){
+    vec2 p = p3.xy;
+    vec2 offset = vec2(-0.82, 0.245);
+    p = p - offset;
+    float f = p.x + 0.09 * sin(9. * p.y);
+    vec2 df = vec2(1, 0.81 * cos(9. * p.y));
+    float g = max(length(df), e);
+    float v = f / g;
+    return opExtrusion(p3, v, 0.51);
+}
+
+/**
+ * @brief Oriented Box SDF.
+ *
+ * A oriented box function given by center point of its origin side, its slope, thickness and 
+ * x coordenate of end.
+ *
+ * @param [in] p Normalized 2D pixel position.
+ * @param [in] sideOriginCenter Center point of box origin side.
+ * @param [in] m Box slope.
+ * @param [in] xEndCenter X coordenate of the center point of box end side.
+ * @param [in] th Thickness of the box.
+ * @return The correct value of SDF at the position.
+ */
+float sdOBox(vec3 p3, vec2 sideOriginCenter, float m, float xEndCenter, float th, float depth){
+    vec2 p = p3.xy;
+    vec2 sideEndCenter = calculateLinearPoint(sideOriginCenter, m, xEndCenter);
+    float l = length(sideEndCenter-sideOriginCenter);
+    vec2  d = (sideEndCenter-sideOriginCenter)/l;
+    vec2  q = p-(sideOriginCenter+sideEndCenter)*0.5;
+          q = mat2(d.x, -d.y, d.y, d.x) * q;
+          q = abs(q) - vec2(l * 0.5, th);
+    float v = length(max(q, 0.0)) + min(max(q.x, q.y), 0.0);   
+    return opExtrusion(p3, v, depth); 
+}
+
+/**
+ * @brief Circle SDF.
+ *
+ * A simples Circle function representing a circle 2D positioned in space center (0,0,0).
+ *
+ * @param [in] p Normalized 2D pixel position.
+ * @param [in] r Circle radius.
+ * @return The correct value of SDF at the position.
+ */
+float sdCircle(vec3 p3, vec2 offset, float r, float depth){
+    vec2 p = p3.xy - offset;
+    float v = length(p) - r;
+    return opExtrusion(p3, v, depth);
+}
+
+/**
+ * @brief Plane SDF.
+ *
+ * A simples SDF function that divide the entire world in two parts: positive, if 
+ * position is greatem than -1.0; negative, if position is less than -1.0.
+ *
+ * @param [in] p Normalized 3D space position.
+ * @return The struct ObjectHit with the object color and the correct value of SDF at the position.
+ */
+float sdFloor(vec3 p){
+    return p.y + 1.0;
+}
+
+/**
+ * @brief Primitive Evaluation.
+ *
+ * Primitive type evaluation from node.
+ *
+ * @param [in] p Normalized 3D space position.
+ * @param [in] pr Primitive type.
+ * @return  The correct value of SDF at the position.
+ */
+float evalPrimitive(vec3 p, Primitive pr){
+    float d;
+
+    switch (pr.type) {
+        case PRIMITIVE_CYLINDER: 
+            d = sdCircle(p, vec2(pr.offsetX, pr.offsetY), pr.r, pr.depth);  
+            break;
+        case PRIMITIVE_BOX: 
+            d = sdOBox(p, vec2(pr.sideCenterX, pr.sideCenterY), pr.m, pr.xEnd, pr.th, pr.depth);  
+            break;
+        case PRIMITIVE_PLANE_CUTTER:
+            d = sdPlaneCutter(p);
+            break;
+        case PRIMITIVE_FLOOR:
+            d = sdFloor(p);
+            break;
+        default:
+            d = 1e20;
+            break;
+    }
+
+    return d;
+}
+
+/**
+ * @brief Tree evaluation.
+ *
+ * Post-order evaluation of the tree of a cell.
+ *
+ * @param [in] p Normalized 3D space position.
+ * @param [in] cell Tree of the cell in the node array.
+ * @return The correct value of SDF at the position.
+ */
+float sdf(vec3 p, CellInfo cell){
+    float stack[NODES_MAX];
+    int stackParent[NODES_MAX];
+    int stackIndex = 0;
+
+    for (int i = cell.offset; i < (cell.size + cell.offset); i++) {
+        Node node = nodes.data[i];
+        float d;
+        if (node.type == NODETYPE_BINARY || node.type == NODETYPE_NARY) {
+            BinaryOperation binaryOperation = binaryOperations.data[node.index];
+            float k = binaryOperation.k;
+            int s = binaryOperation.s;
+
+            // Operandos do nó n-ário: já dobrados em um valor no topo da pilha
+            int count = node.type == NODETYPE_NARY ? 1 : 2;
+            stackIndex -= count;
+
+            d = stack[stackIndex];
+            for (int j = 1; j < count; j++) {
+                float value = stack[stackIndex + j];
+                d = s * (min(s * d, s * value) - smoothFunction(d, value, k));
+            }
+        } else {
+            d = evalPrimitive(p, primitives.data[node.index]);
+        }
+
+        float nodeValue = d * node.sign;
+        // Operando de nó n-ário: dobra no acumulador do irmão à esquerda
+        int parent = node.parent;
+        if (stackIndex > 0 && parent >= 0 && stackParent[stackIndex - 1] == parent &&
+            nodes.data[cell.offset + parent].type == NODETYPE_NARY) {
+            BinaryOperation parentOperation = binaryOperations.data[nodes.data[cell.offset + parent].index];
+            float accumulator = stack[stackIndex - 1];
+            int ps = parentOperation.s;
+            stack[stackIndex - 1] = ps * (min(ps * accumulator, ps * nodeValue) - smoothFunction(accumulator, nodeValue, parentOperation.k));
+        } else {
+            stack[stackIndex] = nodeValue;
+            stackParent[stackIndex] = parent;
+            stackIndex++;
+        }
+    }
+
+    return stack[0];
+}
+
+/**
+ * @brief Lower bound of the distance from the corner values of a cell.
+ *
+ * Trilinear interpolation minus the weighted distance to the corners.
+ *
+ * @param [in] cornerOffset First corner value in the corner input.
+ * @param [in] t Position in the cell, [0, 1] per axis.
+ * @param [in] cellSize Cell size.
+ * @return The distance bound at the position.
+ */
+float interpolateCorners(uint cornerOffset, vec3 t, vec3 cellSize){
+    float x00 = mix(farFieldCornersInput.data[cornerOffset + 0], farFieldCornersInput.data[cornerOffset + 1], t.x);
+    float x10 = mix(farFieldCornersInput.data[cornerOffset + 2], farFieldCornersInput.data[cornerOffset + 3], t.x);
+    float x01 = mix(farFieldCornersInput.data[cornerOffset + 4], farFieldCornersInput.data[cornerOffset + 5], t.x);
+    float x11 = mix(farFieldCornersInput.data[cornerOffset + 6], farFieldCornersInput.data[cornerOffset + 7], t.x);
+    float value = mix(mix(x00, x10, t.y), mix(x01, x11, t.y), t.z);
+    return value - sqrt(dot(t * (1.0 - t), cellSize * cellSize));
+}
+
+/**
+ * @brief Get index by Global Identificator.
+ *
+ * Use size of subdivisions and Global Identificator to determine cell index.
+ *
+ * @param [in] globalID Global thread identificator .
+ * @param [in] pr Subdivision size.
+ * @return The correct value of index for the cell.
+ */
+uint getCellIndex(uvec3 globalID, uint size){
+    return (globalID.z * size * size) + (globalID.y * size) + globalID.x;
+}
+
+
+void main() {
+
+    uint cellIndex = getCellIndex(gl_GlobalInvocationID, subdivisions);
+
+    uvec3 parentIndex = gl_GlobalInvocationID.xyz / 4;
+    uint parentSubdivisions = subdivisions / 4;
+
+    uint cellParentIndex = getCellIndex( parentIndex,  parentSubdivisions);
+
+    CellInfo cellParentInfo = cellInfo.data[cellParentIndex];
+
+
+
+
+    if(cellParentInfo.size == 0){
+        CellInfo newCell;
+        newCell.offset = 0;
+        newCell.size = 0;
+        cellInfoOutput.data[cellIndex] = newCell;
+        farFieldValuesOutput.data[cellIndex] = farFieldValuesInput.data[cellParentIndex];
+
+        // Cantos da célula filha a partir dos cantos da célula pai
+        vec3 parentCellSize = (aabb.maximum.xyz - aabb.minimum.xyz) / parentSubdivisions;
+        for (uint k = 0; k < 8; k++) {
+            uvec3 corner = gl_GlobalInvocationID.xyz % 4 + uvec3(k & 1, (k >> 1) & 1, k >> 2);
+            farFieldCornersOutput.data[cellIndex * 8 + k] = interpolateCorners(cellParentIndex * 8, vec3(corner) / 4.0, parentCellSize);
+        }
+        return;
+    }
+
+
+
+
+
+    vec3 cellSize = (aabb.maximum.xyz - aabb.minimum.xyz) / subdivisions;
+    vec3 cellCenter = aabb.minimum.xyz + cellSize * (vec3(gl_GlobalInvocationID.xyz) + 0.5);    
+
+    float R = length(cellSize) * 0.5;
+
+    NodeState states[NODES_MAX];
+    Stack stack[NODES_MAX];
+    int stateIndex = 0;
+    int stackIndex = 0;
+    
+    for (int i = cellParentInfo.offset; i < (cellParentInfo.size + cellParentInfo.offset); i++) {
+        Node node = nodes.data[i];
+        int si = node.sign;
+
+        float d;
+        NodeState newState;
+        if (node.type == NODETYPE_BINARY || node.type == NODETYPE_NARY) {
+
+            BinaryOperation binaryOperation = binaryOperations.data[node.index];
+            float k = binaryOperation.k;
+            int s = binaryOperation.s;
+
+            // Filhos do nó n-ário: valores no topo da pilha com parent == nó
+            int count = 2;
+            if (node.type == NODETYPE_NARY) {
+                count = 0;
+                while (count < stackIndex && nodes.data[cellParentInfo.offset + stack[stackIndex - 1 - count].index].parent == i - cellParentInfo.offset) {
+                    count++;
+                }
+            }
+            stackIndex -= count;
+
+            d = stack[stackIndex].value;
+            for (int j = 1; j < count; j++) {
+                float value = stack[stackIndex + j].value;
+                d = s * (min(s * d, s * value) - smoothFunction(d, value, k));
+            }
+
+            // Operando perde na célula toda se fica 2R + k acima dos que vêm antes na dobra
+            // (de qualquer outro quando k = 0)
+            int survivors = count;
+            for (int j = 0; j < count; j++) {
+                int limit = k == 0.0 ? count : max(j, 2);
+                float nearest = 1e20;
+                for (int o = 0; o < limit; o++) {
+                    if (o != j) nearest = min(nearest, s * stack[stackIndex + o].value);
+                }
+                if (s * stack[stackIndex + j].value - nearest > 2 * R + k) {
+                    states[stack[stackIndex + j].index].state = NODESTATE_INACTIVE;
+                    survivors--;
+                }
+            }
+            newState.state = survivors == 1 ? NODESTATE_SKIPPED : NODESTATE_ACTIVE;
+        } else if (node.type == NODETYPE_PRIMITIVE) {
+            Primitive primitive = primitives.data[node.index];
+            d = evalPrimitive(cellCenter, primitive);
+            newState.state = NODESTATE_ACTIVE;
+        }
+
+        newState.inactiveAncestors = false;
+        newState.parent = node.parent;
+        newState.sign = node.sign;
+        states[stateIndex] = newState;
+
+        Stack newItem;
+        newItem.value = d * si;
+        newItem.index = stateIndex;
+        stack[stackIndex] = newItem;
+        stackIndex++;
+        stateIndex++;
+    }
+
+
+
+
+    float d = stack[0].value;
+    if (abs(d) > 2 * R) {
+        CellInfo newCell;
+        newCell.offset = 0;
+        newCell.size = 0;
+        cellInfoOutput.data[cellIndex] = newCell;
+        farFieldValuesOutput.data[cellIndex] = sign(d) * (abs(d) - R);
+
+        // A árvore da célula pai é exata nos cantos da célula
+        vec3 cellMinimum = aabb.minimum.xyz + cellSize * vec3(gl_GlobalInvocationID.xyz);
+        for (uint k = 0; k < 8; k++) {
+            vec3 corner = cellMinimum + cellSize * vec3(k & 1, (k >> 1) & 1, k >> 2);
+            farFieldCornersOutput.data[cellIndex * 8 + k] = sdf(corner, cellParentInfo);
+        }
+        return;
+    }
+
+
+
+
+
+
+
+    int numGlobalActives = 0;
+    for (int i = cellParentInfo.size - 1; i >= 0; i--) {
+
+        bool isGlobalActive = false;
+         if (states[i].state == NODESTATE_INACTIVE) {
+            states[i].inactiveAncestors = true;
+         }else {
+            int parentIndex = states[i].parent;
+            bool hasInactiveAncestors = parentIndex >= 0 ? states[parentIndex].inactiveAncestors : false;
+            states[i].inactiveAncestors = hasInactiveAncestors;
+            isGlobalActive = states[i].state == NODESTATE_ACTIVE && !hasInactiveAncestors;
+
+            if(parentIndex >= 0){
+                if( states[parentIndex].state == NODESTATE_SKIPPED){
+                    states[i].parent = states[parentIndex].parent;
+                    states[i].sign *= states[parentIndex].sign;
+                }
+            }
+
+            if(isGlobalActive){
+                numGlobalActives++;
+            }
+        }
+    }
+
+    uint cellOffset = atomicAdd(numNodes, numGlobalActives);
+   
+    CellInfo newCell;
+    newCell.offset = int(cellOffset);
+    newCell.size = numGlobalActives;
+    cellInfoOutput.data[cellIndex] = newCell;
+
+    int oldToNewIndex[NODES_MAX];
+    for(int i=0; i<NODES_MAX; i++) oldToNewIndex[i] = -1;
+
+    int currentIdx = 0;
+    for (int i = 0; i < cellParentInfo.size; i++) {
+        if (states[i].state == NODESTATE_ACTIVE && !states[i].inactiveAncestors) {
+            oldToNewIndex[i] = currentIdx++;
+        }
+    }
+
+    int nodeIndex = 0;
+    for (int i = 0; i < cellParentInfo.size; i++) {
+        NodeState nodeState = states[i];
+        if (nodeState.state == NODESTATE_ACTIVE && !nodeState.inactiveAncestors) {
+            nodesOutput.data[cellOffset + nodeIndex] = nodes.data[cellParentInfo.offset + i];
+            nodesOutput.data[cellOffset + nodeIndex].parent = states[i].parent >= 0 ? oldToNewIndex[states[i].parent] : -1;
+            nodesOutput.data[cellOffset + nodeIndex].sign = states[i].sign;
+            nodeIndex++;
+        }
+    }
+}
\ No newline at end of file
@@ -0,0 +1,643 @@
+/**
+ * @brief Pruning Algorithm
+ *
+ * Pruning algorithm described by Barbier at el. in the paper Lipschitz Pruning  Hierarchical Simplification 
+ * of Primitive‐Based SDFs with far-fields procedure, using interval arithmetic: each node is bounded
+ * over the whole cell box (vec2 with x = lower and y = upper bound) instead of evaluated at the
+ * cell center and widened by the cell radius.
+ *
+ * @author Edson Martinelli
+ * @date 2026
+ */
+
+#version 430 core
+
+/**
+ * @defgroup ComputeVariables Compute Variables 
+ * @brief Variables related to compute shader and parallel programing.
+*/
+
+/**
+ * @defgroup SSBOVariables SSBO Variables 
+ * @brief Variables related to configuration and use of SSBOs.
+*/
+
+/**
+ * @defgroup ConfigVariables Configuration Variables 
+ * @brief Variables related to algorithm configuration.
+*/
+
+/**
+ * @defgroup RayVariables Ray Variables
+ * @brief Variables related to Ray Marching.
+*/
+
+#define PRIMITIVE_CYLINDER 0 /*< Define the number for primitive cylinder (extruded circle). */
+#define PRIMITIVE_BOX 1 /*< Define the number for primitive box (extruded retangle). */
+#define PRIMITIVE_PLANE_CUTTER 2 /*< Define the number for primitive plane cutter (extruded plane with sin).*/
+#define PRIMITIVE_FLOOR 3 /*< Define the number for primitive plane. */
+
+#define NODETYPE_PRIMITIVE 0 /*< Define node type as a primitive.*/
+#define NODETYPE_BINARY 1 /*< Define node type as a binary operation.*/
+#define NODETYPE_NARY 2 /*< Define node type as an operation over all children (parent == node).*/
+
+#define NODESTATE_ACTIVE 0 /*< Define node state as active.*/
+#define NODESTATE_SKIPPED 1 /*< Define node state as skipped.*/
+#define NODESTATE_INACTIVE 2 /*< Define node state as innactive.*/
+
+/**
+ * @ingroup ComputeVariables
+ * @brief Size for each work group.
+*/
+layout(local_size_x = 4, local_size_y = 4, local_size_z = 4) in;
+
+/**
+ * @ingroup SSBOVariables
+ * @brief Binary operation node struct.
+*/
+struct BinaryOperation{
+    float k; /**< Smooth radius.*/
+    int s; /**< Operation constraint: max or min.*/
+    int ca; /**< Value for left node.*/
+    int cb; /**< Value for right node.*/
+};
+
+/**
+ * @ingroup SSBOVariables
+ * @brief Primitive node struct.
+*/
+struct Primitive{
+    //box
+    float sideCenterX; /**< Center point of box origin side in X axis.*/
+    float sideCenterY; /**< Center point of box origin side in Y axis.*/
+    float m; /**<  Box slope.*/
+    float xEnd; /**< X coordenate of the center point of box end side.*/
+    float th; /**< Thickness of the box.*/
+
+    //cylinder
+    float offsetX; /**< Cylinder offset in the X axis.*/
+    float offsetY; /**< Cylinder offset in the Y axis.*/
+    float r; /**< Cylinder radius.*/
+
+    float depth; /**< Extrude depth.*/
+    uint type; /**< Type of primitive.*/
+
+    float pad0, pad1; /**< Paddings for alignment.*/
+};
+
+/**
+ * @ingroup SSBOVariables
+ * @brief General node struct.
+*/
+struct Node{
+    int type; /**< Type of node.*/
+    int index; /**< Index of the position in original array (Primitive or Binary Operation) for the node.*/
+    int sign; /**< Signal used by the parent in the node calculation.*/
+    int parent; /**< Node parent in the node array.*/
+};
+
+/**
+ * @ingroup SSBOVariables
+ * @brief Tree information for the cell.
+*/
+struct CellInfo{
+    int offset; /**< Tree start in the node array for the cell.*/
+    int size;  /**< Tree size in the node array for the cell.*/
+};
+
+/**
+ * @ingroup SSBOVariables
+ * @brief Post order evaluation stack.
+*/
+struct Stack{
+    vec2 value; /**< Node value bounds in the cell (x = lower, y = upper).*/
+    int index; /**< Node index in cell (global index  - offset).*/
+};
+
+/**
+ * @ingroup SSBOVariables
+ * @brief Post order evaluation stack.
+*/
+struct NodeState{
+    int state; /**< Node current state.*/
+    bool inactiveAncestors; /**< Innactive parent mark.*/
+    int sign; /**< Current signal used by the parent in the node calculation.*/
+    int parent; /**< Current parent node. */
+};
+
+/**
+ * @ingroup SSBOVariables
+ * @brief Primitives node array.
+*/
+layout(std430, binding = 0) readonly buffer PrimitivesBuffer {
+    Primitive data[];
+} primitives;
+
+/**
+ * @ingroup SSBOVariables
+ * @brief Binary Operations node array.
+*/
+layout(std430, binding = 1) readonly buffer BinaryOperationsBuffer {
+    BinaryOperation data[];
+} binaryOperations;
+
+/**
+ * @ingroup SSBOVariables
+ * @brief Input node array.
+*/
+layout(std430, binding = 2) readonly buffer NodesBuffer {
+    Node data[];
+} nodes;
+
+/**
+ * @ingroup SSBOVariables
+ * @brief Input cell node array.
+*/
+layout(std430, binding = 3) readonly buffer CellInfoBuffer {
+    CellInfo data[];
+} cellInfo;
+
+/**
+ * @ingroup SSBOVariables
+ * @brief Output node array.
+*/
+layout(std430, binding = 4) buffer NodesOutputBuffer {
+    Node data[];
+} nodesOutput;
+
+/**
+ * @ingroup SSBOVariables
+ * @brief Output cell node array.
+*/
+layout(std430, binding = 5) buffer CellInfoOutputBuffer {
+    CellInfo data[];
+} cellInfoOutput;
+
+
+/**
+ * @ingroup SSBOVariables
+ * @brief Node counter.
+*/
+layout(std430, binding = 6) buffer NodeCounter {
+    uint numNodes;
+};
+
+/**
+ * @ingroup SSBOVariables
+ * @brief Far-fields values input.
+*/
+layout(std430, binding = 7) buffer FarFieldValuesInputBuffer {
+    float data[];
+} farFieldValuesInput;
+
+/**
+ * @ingroup SSBOVariables
+ * @brief Far-fields values output.
+*/
+layout(std430, binding = 8) buffer FarFieldValuesOutputBuffer {
+    float data[];
+} farFieldValuesOutput;
+
+
+/**
+ * @ingroup ConfigVariables
+ * @brief AABB points to pruning algorithm.
+*/
+layout(std140, binding = 0) uniform AABBData {
+    vec4 maximum;
+    vec4 minimum;
+} aabb;
+
+/**
+ * @ingroup ConfigVariables
+ * @brief Number of espace subdivisions per axis to pruning algorithm.
+*/
+layout(location = 0) uniform int subdivisions;
+
+/**
+ * @ingroup ConfigVariables
+ * @brief Maxmimum number of nodes.
+*/
+const int NODES_MAX = 25;
+
+/**
+ * @ingroup RayVariables
+ * @brief Minimun next step to consider the ray hits a surface (maximun error). 
+*/
+float e = 0.0001;
+
+/**
+ * @brief Smooth minimum function.
+ *
+ * A quadractic polynomial smooth mininum function.
+ *
+ * @param [in] a Point value in the first SDF.
+ * @param [in] b Point value in the second SDF.
+ * @param [in] k Smooth value parameter.
+ * @return Smooth value for given values.
+ */
+float smoothFunction( float a, float b, float k ){
+    if(k == 0) return 0;
+    float d = abs(a - b);
+    float h = max(k - d, 0.0);
+    return h * h * (1.0 / (4.0 * k));
+}
+
+/**
+ * @ingroup ConfigVariables
+ * @brief Pi constant.
+*/
+const float PI = 3.14159265358979;
+
+/**
+ * @brief Absolute value of an interval.
+ *
+ * @param [in] a Interval (x = lower, y = upper).
+ * @return Interval of |v| for v in a.
+ */
+vec2 intervalAbs(vec2 a){
+    if (a.x >= 0.0) return a;
+    if (a.y <= 0.0) return vec2(-a.y, -a.x);
+    return vec2(0.0, max(-a.x, a.y));
+}
+
+/**
+ * @brief Length of a 2D vector with interval components.
+ *
+ * @param [in] x Interval of the X component.
+ * @param [in] y Interval of the Y component.
+ * @return Interval of the vector length.
+ */
+vec2 intervalLength(vec2 x, vec2 y){
+    vec2 nearest = vec2(clamp(0.0, x.x, x.y), clamp(0.0, y.x, y.y));
+    vec2 farthest = vec2(max(abs(x.x), abs(x.y)), max(abs(y.x), abs(y.y)));
+    return vec2(length(nearest), length(farthest));
+}
+
+/**
+ * @brief Sine of an interval.
+ *
+ * @param [in] a Interval.
+ * @return Interval of sin(v) for v in a.
+ */
+vec2 intervalSin(vec2 a){
+    if (a.y - a.x >= 2.0 * PI) return vec2(-1.0, 1.0);
+    vec2 r = vec2(min(sin(a.x), sin(a.y)), max(sin(a.x), sin(a.y)));
+    float peak = PI * 0.5 + 2.0 * PI * ceil((a.x - PI * 0.5) / (2.0 * PI));
+    float valley = -PI * 0.5 + 2.0 * PI * ceil((a.x + PI * 0.5) / (2.0 * PI));
+    if (peak <= a.y) r.y = 1.0;
+    if (valley <= a.y) r.x = -1.0;
+    return r;
+}
+
+/**
+ * @brief Extrusion operation over intervals.
+ *
+ * opExtrusion is non-decreasing in the 2D value and in |z| - h, so the bounds come from the
+ * interval ends.
+ *
+ * @param [in] z Interval of the Z coordinate.
+ * @param [in] sdf Interval of the 2D SDF.
+ * @param [in] h Extrusion size.
+ * @return Interval of the 3D SDF.
+ */
+vec2 intervalExtrusion(vec2 z, vec2 sdf, float h){
+    vec2 wy = intervalAbs(z) - h;
+    vec2 wLo = vec2(sdf.x, wy.x);
+    vec2 wHi = vec2(sdf.y, wy.y);
+    return vec2(min(max(wLo.x, wLo.y), 0.0) + length(max(wLo, 0.0)),
+                min(max(wHi.x, wHi.y), 0.0) + length(max(wHi, 0.0)));
+}
+
+/**
+ * @brief Calculate Y coordenate of the linear equation and return the point.
+ *
+ * Calculate Y coordenate given a origin point in 2D, a slope and x coordenate. After that, this
+ * function returns a point with given x e calculate Y.
+ *
+ * @param [in] origin A point in the line.
+ * @param [in] m Equation slope.
+ * @param [in] x Second point X coordenate.
+ * @return A point (2D) with X coordenate and correspondent Y.
+ */
+vec2 calculateLinearPoint(vec2 origin, float m, float x){
+    float c = (m * origin.x) - origin.y;
+    float y = (m * x) - c;
+    return vec2(x,y);
+}
+
+/**
+ * @brief Plane cutter SDF over a cell.
+ *
+ * @param [in] cellMin Cell minimum point.
+ * @param [in] cellMax Cell maximum point.
+ * @return Interval of the SDF in the cell.
+ */
+vec2 intervalPlaneCutter(vec3 cellMin, vec3 cellMax){
+    vec2 offset = vec2(-0.82, 0.245);
+    vec2 px = vec2(cellMin.x, cellMax.x) - offset.x;
+    vec2 py = vec2(cellMin.y, cellMax.y) - offset.y;
+    vec2 f = px + 0.09 * intervalSin(9. * py);
+    vec2 c = intervalAbs(intervalSin(9. * py + PI * 0.5));
+    vec2 g = max(sqrt(1.0 + 0.6561 * c * c), e);
+    vec2 v;
+    if (f.x >= 0.0) {
+        v = vec2(f.x / g.y, f.y / g.x);
+    } else if (f.y <= 0.0) {
+        v = vec2(f.x / g.x, f.y / g.y);
+    } else {
+        v = f / g.x;
+    }
+    return intervalExtrusion(vec2(cellMin.z, cellMax.z), v, 0.51);
+}
+
+/**
+ * @brief Oriented Box SDF over a cell.
+ *
+ * The rotation to the box frame is affine, so the rotated coordinates are bounded exactly by
+ * the cell center and the projected half extents.
+ *
+ * @param [in] cellMin Cell minimum point.
+ * @param [in] cellMax Cell maximum point.
+ * @param [in] sideOriginCenter Center point of box origin side.
+ * @param [in] m Box slope.
+ * @param [in] xEndCenter X coordenate of the center point of box end side.
+ * @param [in] th Thickness of the box.
+ * @param [in] depth Extrude depth.
+ * @return Interval of the SDF in the cell.
+ */
+vec2 intervalOBox(vec3 cellMin, vec3 cellMax, vec2 sideOriginCenter, float m, float xEndCenter, float th, float depth){
+    vec2 sideEndCenter = calculateLinearPoint(sideOriginCenter, m, xEndCenter);
+    float l = length(sideEndCenter-sideOriginCenter);
+    vec2  d = (sideEndCenter-sideOriginCenter)/l;
+    vec2  c = (cellMin.xy + cellMax.xy) * 0.5 - (sideOriginCenter+sideEndCenter)*0.5;
+    vec2  h = (cellMax.xy - cellMin.xy) * 0.5;
+    vec2  q = mat2(d.x, -d.y, d.y, d.x) * c;
+    vec2  r = mat2(abs(d.x), abs(d.y), abs(d.y), abs(d.x)) * h;
+    vec2 qx = intervalAbs(vec2(q.x - r.x, q.x + r.x)) - l * 0.5;
+    vec2 qy = intervalAbs(vec2(q.y - r.y, q.y + r.y)) - th;
+    vec2 qLo = vec2(qx.x, qy.x);
+    vec2 qHi = vec2(qx.y, qy.y);
+    vec2 v = vec2(length(max(qLo, 0.0)) + min(max(qLo.x, qLo.y), 0.0),
+                  length(max(qHi, 0.0)) + min(max(qHi.x, qHi.y), 0.0));
+    return intervalExtrusion(vec2(cellMin.z, cellMax.z), v, depth);
+}
+
+/**
+ * @brief Circle SDF over a cell.
+ *
+ * @param [in] cellMin Cell minimum point.
+ * @param [in] cellMax Cell maximum point.
+ * @param [in] offset Circle center.
+ * @param [in] r Circle radius.
+ * @param [in] depth Extrude depth.
+ * @return Interval of the SDF in the cell.
+ */
+vec2 intervalCircle(vec3 cellMin, vec3 cellMax, vec2 offset, float r, float depth){
+    vec2 v = intervalLength(vec2(cellMin.x, cellMax.x) - offset.x, vec2(cellMin.y, cellMax.y) - offset.y) - r;
+    return intervalExtrusion(vec2(cellMin.z, cellMax.z), v, depth);
+}
+
+/**
+ * @brief Primitive Evaluation over a cell.
+ *
+ * Primitive type evaluation from node.
+ *
+ * @param [in] cellMin Cell minimum point.
+ * @param [in] cellMax Cell maximum point.
+ * @param [in] pr Primitive type.
+ * @return Interval of the SDF in the cell.
+ */
+vec2 evalPrimitive(vec3 cellMin, vec3 cellMax, Primitive pr){
+    vec2 d;
+
+    switch (pr.type) {
+        case PRIMITIVE_CYLINDER: 
+            d = intervalCircle(cellMin, cellMax, vec2(pr.offsetX, pr.offsetY), pr.r, pr.depth);  
+            break;
+        case PRIMITIVE_BOX: 
+            d = intervalOBox(cellMin, cellMax, vec2(pr.sideCenterX, pr.sideCenterY), pr.m, pr.xEnd, pr.th, pr.depth);  
+            break;
+        case PRIMITIVE_PLANE_CUTTER:
+            d = intervalPlaneCutter(cellMin, cellMax);
+            break;
+        case PRIMITIVE_FLOOR:
+            d = vec2(cellMin.y, cellMax.y) + 1.0;
+            break;
+        default:
+            d = vec2(1e20);
+            break;
+    }
+
+    return d;
+}
+
+/**
+ * @brief Binary operation over intervals.
+ *
+ * The smooth term decreases with |a - b|, so its bounds come from the smallest and largest gap
+ * between the intervals.
+ *
+ * @param [in] a Interval of the left value.
+ * @param [in] b Interval of the right value.
+ * @param [in] k Smooth radius.
+ * @param [in] s Operation (1 min, -1 max).
+ * @return Interval of the operation.
+ */
+vec2 evalBinary(vec2 a, vec2 b, float k, int s){
+    float gapMin = max(0.0, max(a.x - b.y, b.x - a.y));
+    float gapMax = max(a.y - b.x, b.y - a.x);
+    float smoothMax = smoothFunction(gapMin, 0.0, k);
+    float smoothMin = smoothFunction(gapMax, 0.0, k);
+
+    vec2 sa = s > 0 ? a : -a.yx;
+    vec2 sb = s > 0 ? b : -b.yx;
+    vec2 d = vec2(min(sa.x, sb.x) - smoothMax, min(sa.y, sb.y) - smoothMin);
+    return s > 0 ? d : -d.yx;
+}
+
+/**
+ * @brief Get index by Global Identificator.
+ *
+ * Use size of subdivisions and Global Identificator to determine cell index.
+ *
+ * @param [in] globalID Global thread identificator .
+ * @param [in] pr Subdivision size.
+ * @return The correct value of index for the cell.
+ */
+uint getCellIndex(uvec3 globalID, uint size){
+    return (globalID.z * size * size) + (globalID.y * size) + globalID.x;
+}
+
+
+void main() {
+
+    uint cellIndex = getCellIndex(gl_GlobalInvocationID, subdivisions);
+
+    uvec3 parentIndex = gl_GlobalInvocationID.xyz / 4;
+    uint parentSubdivisions = subdivisions / 4;
+
+    uint cellParentIndex = getCellIndex( parentIndex,  parentSubdivisions);
+
+    CellInfo cellParentInfo = cellInfo.data[cellParentIndex];
+
+
+
+
+    if(cellParentInfo.size == 0){
+        CellInfo newCell;
+        newCell.offset = 0;
+        newCell.size = 0;
+        cellInfoOutput.data[cellIndex] = newCell;
+        farFieldValuesOutput.data[cellIndex] = farFieldValuesInput.data[cellParentIndex];
+        return;
+    }
+
+
+
+
+
+    vec3 cellSize = (aabb.maximum.xyz - aabb.minimum.xyz) / subdivisions;
+    vec3 cellMin = aabb.minimum.xyz + cellSize * vec3(gl_GlobalInvocationID.xyz);
+    vec3 cellMax = cellMin + cellSize;
+
+    float R = length(cellSize) * 0.5;
+
+    NodeState states[NODES_MAX];
+    Stack stack[NODES_MAX];
+    int stateIndex = 0;
+    int stackIndex = 0;
+    
+    for (int i = cellParentInfo.offset; i < (cellParentInfo.size + cellParentInfo.offset); i++) {
+        Node node = nodes.data[i];
+        int si = node.sign;
+
+        vec2 d;
+        NodeState newState;
+        if (node.type == NODETYPE_BINARY || node.type == NODETYPE_NARY) {
+
+            BinaryOperation binaryOperation = binaryOperations.data[node.index];
+            float k = binaryOperation.k;
+            int s = binaryOperation.s;
+
+            // Filhos do nó n-ário: valores no topo da pilha com parent == nó
+            int count = 2;
+            if (node.type == NODETYPE_NARY) {
+                count = 0;
+                while (count < stackIndex && nodes.data[cellParentInfo.offset + stack[stackIndex - 1 - count].index].parent == i - cellParentInfo.offset) {
+                    count++;
+                }
+            }
+            stackIndex -= count;
+
+            d = stack[stackIndex].value;
+            for (int j = 1; j < count; j++) {
+                d = evalBinary(d, stack[stackIndex + j].value, k, s);
+            }
+
+            int survivors = count;
+            for (int j = 0; j < count; j++) {
+                int limit = k == 0.0 ? count : max(j, 2);
+                float nearest = 1e20;
+                for (int o = 0; o < limit; o++) {
+                    vec2 so = s > 0 ? stack[stackIndex + o].value : -stack[stackIndex + o].value.yx;
+                    if (o != j) nearest = min(nearest, so.y);
+                }
+                vec2 sj = s > 0 ? stack[stackIndex + j].value : -stack[stackIndex + j].value.yx;
+                if (sj.x > nearest + k) {
+                    states[stack[stackIndex + j].index].state = NODESTATE_INACTIVE;
+                    survivors--;
+                }
+            }
+            newState.state = survivors == 1 ? NODESTATE_SKIPPED : NODESTATE_ACTIVE;
+        } else if (node.type == NODETYPE_PRIMITIVE) {
+            Primitive primitive = primitives.data[node.index];
+            d = evalPrimitive(cellMin, cellMax, primitive);
+            newState.state = NODESTATE_ACTIVE;
+        }
+
+        newState.inactiveAncestors = false;
+        newState.parent = node.parent;
+        newState.sign = node.sign;
+        states[stateIndex] = newState;
+
+        Stack newItem;
+        newItem.value = si > 0 ? d : -d.yx;
+        newItem.index = stateIndex;
+        stack[stackIndex] = newItem;
+        stackIndex++;
+        stateIndex++;
+    }
+
+
+
+
+    vec2 d = stack[0].value;
+    if (d.x > R || d.y < -R) {
+        CellInfo newCell;
+        newCell.offset = 0;
+        newCell.size = 0;
+        cellInfoOutput.data[cellIndex] = newCell;
+        farFieldValuesOutput.data[cellIndex] = d.x > R ? d.x : d.y;
+        return;
+    }
+
+
+
+
+
+
+
+    int numGlobalActives = 0;
+    for (int i = cellParentInfo.size - 1; i >= 0; i--) {
+
+        bool isGlobalActive = false;
+         if (states[i].state == NODESTATE_INACTIVE) {
+            states[i].inactiveAncestors = true;
+         }else {
+            int parentIndex = states[i].parent;
+            bool hasInactiveAncestors = parentIndex >= 0 ? states[parentIndex].inactiveAncestors : false;
+            states[i].inactiveAncestors = hasInactiveAncestors;
+            isGlobalActive = states[i].state == NODESTATE_ACTIVE && !hasInactiveAncestors;
+
+            if(parentIndex >= 0){
+                if( states[parentIndex].state == NODESTATE_SKIPPED){
+                    states[i].parent = states[parentIndex].parent;
+                    states[i].sign *= states[parentIndex].sign;
+                }
+            }
+
+            if(isGlobalActive){
+                numGlobalActives++;
+            }
+        }
+    }
+
+    uint cellOffset = atomicAdd(numNodes, numGlobalActives);
+   
+    CellInfo newCell;
+    newCell.offset = int(cellOffset);
+    newCell.size = numGlobalActives;
+    cellInfoOutput.data[cellIndex] = newCell;
+
+    int oldToNewIndex[NODES_MAX];
+    for(int i=0; i<NODES_MAX; i++) oldToNewIndex[i] = -1;
+
+    int currentIdx = 0;
+    for (int i = 0; i < cellParentInfo.size; i++) {
+        if (states[i].state == NODESTATE_ACTIVE && !states[i].inactiveAncestors) {
+            oldToNewIndex[i] = currentIdx++;
+        }
+    }
+
+    int nodeIndex = 0;
+    for (int i = 0; i < cellParentInfo.size; i++) {
+        NodeState nodeState = states[i];
+        if (nodeState.state == NODESTATE_ACTIVE && !nodeState.inactiveAncestors) {
+            nodesOutput.data[cellOffset + nodeIndex] = nodes.data[cellParentInfo.offset + i];
+            nodesOutput.data[cellOffset + nodeIndex].parent = states[i].parent >= 0 ? oldToNewIndex[states[i].parent] : -1;
+            nodesOutput.data[cellOffset + nodeIndex].sign = states[i].sign;
+            nodeIndex++;
+        }
+    }
+}
\ No newline at end of file
@@ -66,6 +66,7 @@ layout (location = 1) uniform float iTimer;
 
 #define NODETYPE_PRIMITIVE 0 /*< Define node type as a primitive.*/
 #define NODETYPE_BINARY 1 /*< Define node type as a binary operation.*/
+#define NODETYPE_NARY 2 /*< Define node type as an operation over all children (parent == node).*/
 
 const int NODES_MAX = 25; /*< Define the maximum number the nodes per tree.*/
 
@@ -222,14 +223,16 @@ vec3 lightColor =  vec3(1.0, 1.0, 1.0);
 float D = 32.0;
 /**
  * @ingroup RayVariables
- * @brief Minimun next step to consider the ray hits a surface (maximun error). 
+ * @brief Minimun next step to consider the ray hits a surface (maximun error).
+ * Uniform so the frame-time governor of main.cpp can raise it (governor.hpp).
 */
-float e = 0.0001;
+layout (location = 6) uniform float e = 0.0001;
 /**
  * @ingroup RayVariables
  * @brief Maximun ray steps.
+ * Uniform so the frame-time governor of main.cpp can lower it (governor.hpp).
 */
-float MAX_STEP = 256.0;
+layout (location = 5) uniform float MAX_STEP = 256.0;
 
 /**
  * @brief Smooth minimum function.
@@ -397,32 +400,49 @@ float evalPrimitive(vec3 p, Primitive pr){
  */
 float sdf(vec3 p){
     float stack[NODES_MAX];
+    int stackParent[NODES_MAX];
     int stackIndex = 0;
 
-    for (int i = 0; i < NODES_MAX; i++) {
+    for (int i = 0; i < nodes.data.length(); i++) {
         Node node = nodes.data[i];
 
         int si = node.sign;
 
         float d;
-        if (node.type == NODETYPE_BINARY) {
+        if (node.type == NODETYPE_BINARY || node.type == NODETYPE_NARY) {
 
             BinaryOperation binaryOperation = binaryOperations.data[node.index];
-            float leftValue = stack[stackIndex - 2];
-            float rightValue = stack[stackIndex - 1];
-
             float k = binaryOperation.k;
             int s = binaryOperation.s;
-            d = s * (min(s * leftValue, s * rightValue) - smoothFunction(leftValue, rightValue, k));
-            
-            stackIndex -=2;
+
+            // Operandos do nó n-ário: já dobrados em um valor no topo da pilha
+            int count = node.type == NODETYPE_NARY ? 1 : 2;
+            stackIndex -= count;
+
+            d = stack[stackIndex];
+            for (int j = 1; j < count; j++) {
+                float value = stack[stackIndex + j];
+                d = s * (min(s * d, s * value) - smoothFunction(d, value, k));
+            }
         } else if (node.type == NODETYPE_PRIMITIVE) {
             Primitive primitive = primitives.data[node.index];
             d = evalPrimitive(p, primitive);
         }
 
-        stack[stackIndex] = d * si;
-        stackIndex++;
+        float nodeValue = d * si;
+        // Operando de nó n-ário: dobra no acumulador do irmão à esquerda
+        int parent = node.parent;
+        if (stackIndex > 0 && parent >= 0 && stackParent[stackIndex - 1] == parent &&
+            nodes.data[parent].type == NODETYPE_NARY) {
+            BinaryOperation parentOperation = binaryOperations.data[nodes.data[parent].index];
+            float accumulator = stack[stackIndex - 1];
+            int ps = parentOperation.s;
+            stack[stackIndex - 1] = ps * (min(ps * accumulator, ps * nodeValue) - smoothFunction(accumulator, nodeValue, parentOperation.k));
+        } else {
+            stack[stackIndex] = nodeValue;
+            stackParent[stackIndex] = parent;
+            stackIndex++;
+        }
     }
 
     return stack[0];
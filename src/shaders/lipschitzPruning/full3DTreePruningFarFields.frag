@@ -61,11 +61,20 @@ layout (location = 1) uniform float iTimer;
 
 layout (location = 2) uniform int subdivisions;
 
-vec4 aabbMax = vec4(2.0, 2.0, 2.0, 0.0);
-vec4 aabbMin = vec4(-2.0, -2.0, -2.0, 0.0);
+/**
+ * @ingroup FragVariables
+ * @brief Write the work counters of the pixel to the counters buffer (1) or not (0).
+*/
+layout (location = 4) uniform int countersEnabled;
 
-// vec4 aabbMax = vec4(32.0, 2.0, 32.0, 0.0);
-// vec4 aabbMin = vec4(-32.0, -2.0, -32.0, 0.0);
+/**
+ * @ingroup FragVariables
+ * @brief Pruning grid extent, computed by the bounds pass.
+*/
+layout(std140, binding = 0) uniform AABBData {
+    vec4 maximum;
+    vec4 minimum;
+} aabb;
 
 
 #define PRIMITIVE_CYLINDER 0 /*< Define the number for primitive cylinder (extruded circle). */
@@ -75,6 +84,7 @@ vec4 aabbMin = vec4(-2.0, -2.0, -2.0, 0.0);
 
 #define NODETYPE_PRIMITIVE 0 /*< Define node type as a primitive.*/
 #define NODETYPE_BINARY 1 /*< Define node type as a binary operation.*/
+#define NODETYPE_NARY 2 /*< Define node type as an operation over all children (parent == node).*/
 
 const int NODES_MAX = 25; /*< Define the maximum number the nodes per tree.*/
 
@@ -193,6 +203,14 @@ layout(std430, binding = 4) buffer FarFieldValuesBuffer {
     float data[];
 } farFieldValues;
 
+/**
+ * @ingroup SSBOVariables
+ * @brief Work counters of each pixel (steps, sdf calls, nodes, primitives), row by row from the bottom.
+*/
+layout(std430, binding = 6) writeonly restrict buffer PixelCountersBuffer {
+    uvec4 data[];
+} pixelCounters;
+
 
 
 
@@ -249,14 +267,32 @@ vec3 lightColor =  vec3(1.0, 1.0, 1.0);
 float D = 32.0;
 /**
  * @ingroup RayVariables
- * @brief Minimun next step to consider the ray hits a surface (maximun error). 
+ * @brief Minimun next step to consider the ray hits a surface (maximun error).
+ * Uniform so the frame-time governor of main.cpp can raise it (governor.hpp).
 */
-float e = 0.0001;
+layout (location = 6) uniform float e = 0.0001;
 /**
  * @ingroup RayVariables
  * @brief Maximun ray steps.
+ * Uniform so the frame-time governor of main.cpp can lower it (governor.hpp).
+*/
+layout (location = 5) uniform float MAX_STEP = 256.0;
+
+/**
+ * @ingroup RayVariables
+ * @brief Calls of sdf() in this pixel.
+*/
+uint sdfCalls = 0u;
+/**
+ * @ingroup RayVariables
+ * @brief Tree nodes evaluated in this pixel.
+*/
+uint nodesEvaluated = 0u;
+/**
+ * @ingroup RayVariables
+ * @brief Primitives evaluated in this pixel.
 */
-float MAX_STEP = 256.0;
+uint primitivesEvaluated = 0u;
 
 /**
  * @brief Get the cell index.
@@ -437,36 +473,56 @@ float evalPrimitive(vec3 p, Primitive pr){
  * @return The struct ObjectHit with the object color and the correct value of SDF at the position.
  */
 float sdf(vec3 p, int offset, int size, uint cellIndex){
+    sdfCalls++;
 
     if(size == 0){
          return farFieldValues.data[cellIndex];
     }
 
     float stack[NODES_MAX];
+    int stackParent[NODES_MAX];
     int stackIndex = 0;
 
     for (int i = offset; i < (size + offset); i++) {
         Node node = nodes.data[i];
         int si = node.sign;
+        nodesEvaluated++;
         float d;
-        if (node.type == NODETYPE_BINARY) {
+        if (node.type == NODETYPE_BINARY || node.type == NODETYPE_NARY) {
 
             BinaryOperation binaryOperation = binaryOperations.data[node.index];
-            float leftValue = stack[stackIndex - 2];
-            float rightValue = stack[stackIndex - 1];
-
             float k = binaryOperation.k;
             int s = binaryOperation.s;
-            d = s * (min(s * leftValue, s * rightValue) - smoothFunction(leftValue, rightValue, k));
-            
-            stackIndex -=2;
+
+            // Operandos do nó n-ário: já dobrados em um valor no topo da pilha
+            int count = node.type == NODETYPE_NARY ? 1 : 2;
+            stackIndex -= count;
+
+            d = stack[stackIndex];
+            for (int j = 1; j < count; j++) {
+                float value = stack[stackIndex + j];
+                d = s * (min(s * d, s * value) - smoothFunction(d, value, k));
+            }
         } else if (node.type == NODETYPE_PRIMITIVE) {
             Primitive primitive = primitives.data[node.index];
             d = evalPrimitive(p, primitive);
+            primitivesEvaluated++;
         }
 
-        stack[stackIndex] = d * si;
-        stackIndex++;
+        float nodeValue = d * si;
+        // Operando de nó n-ário: dobra no acumulador do irmão à esquerda
+        int parent = node.parent;
+        if (stackIndex > 0 && parent >= 0 && stackParent[stackIndex - 1] == parent &&
+            nodes.data[offset + parent].type == NODETYPE_NARY) {
+            BinaryOperation parentOperation = binaryOperations.data[nodes.data[offset + parent].index];
+            float accumulator = stack[stackIndex - 1];
+            int ps = parentOperation.s;
+            stack[stackIndex - 1] = ps * (min(ps * accumulator, ps * nodeValue) - smoothFunction(accumulator, nodeValue, parentOperation.k));
+        } else {
+            stack[stackIndex] = nodeValue;
+            stackParent[stackIndex] = parent;
+            stackIndex++;
+        }
     }
 
     return stack[0];
@@ -538,6 +594,31 @@ vec3 getDirection(vec2 uv){
     return normalize(viewportPoint + viewDir);  
 }
 
+/**
+ * @brief Clip the ray to the grid box.
+ *
+ * Slab test, same as clipRayGrid() of raycast.hpp.
+ *
+ * @param [in] direction Ray direction.
+ * @param [out] tNear Distance where the ray enters the box (0 if the origin is inside).
+ * @return False if the ray misses the box.
+ */
+bool clipRayGrid(vec3 direction, out float tNear){
+    tNear = 0.0;
+    float tFar = 1e20;
+    for (int a = 0; a < 3; a++) {
+        if (direction[a] == 0.0) {
+            if (origin[a] < aabb.minimum[a] || origin[a] >= aabb.maximum[a]) return false;
+            continue;
+        }
+        float t0 = (aabb.minimum[a] - origin[a]) / direction[a];
+        float t1 = (aabb.maximum[a] - origin[a]) / direction[a];
+        tNear = max(tNear, min(t0, t1));
+        tFar = min(tFar, max(t0, t1));
+    }
+    return tNear < tFar;
+}
+
 /**
  * @brief Ray Marching Algorithm.
  *
@@ -552,15 +633,20 @@ RayInfo rayMarching(vec3 direction){
     float count = 0.0;
     float t = 0.0;
     float r = 0.0;
+    // Câmera fora da grade: a marcha começa onde o raio entra na caixa
+    if (any(lessThan(origin, aabb.minimum.xyz)) || any(greaterThanEqual(origin, aabb.maximum.xyz))) {
+        float tNear;
+        t = clipRayGrid(direction, tNear) ? tNear + e : 1e20;
+    }
     while(t < D) {
         vec3 p = origin + direction * t;
-        if (any(lessThan(p, aabbMin.xyz)) || any(greaterThanEqual(p, aabbMax.xyz))) {
+        if (any(lessThan(p, aabb.minimum.xyz)) || any(greaterThanEqual(p, aabb.maximum.xyz))) {
             t = 1e20;
             break;
         }
 
-        vec3 cellSize = (aabbMax.xyz - aabbMin.xyz) / subdivisions;
-        ivec3 cell = ivec3((p - aabbMin.xyz) / cellSize);
+        vec3 cellSize = (aabb.maximum.xyz - aabb.minimum.xyz) / subdivisions;
+        ivec3 cell = ivec3((p - aabb.minimum.xyz) / cellSize);
         cell = clamp(cell, ivec3(0), ivec3(subdivisions - 1));
         int cellIndex = int(getCellIndex(cell, uint(subdivisions)));
 
@@ -589,7 +675,7 @@ void main()
     //origin = vec3(1.999 *sin(iTimer), 0.0, 1.999 *cos(iTimer));
     vec2 uv = normalizeSpace();  
     vec3 direction = getDirection(uv);  
-    vec3 cellSize = (aabbMax.xyz - aabbMin.xyz) / subdivisions;
+    vec3 cellSize = (aabb.maximum.xyz - aabb.minimum.xyz) / subdivisions;
 
     RayInfo ri = rayMarching(direction);
 
@@ -599,7 +685,7 @@ void main()
     if(ri.dist < D) {
         vec3 position = origin + direction * ri.dist;
         
-        ivec3 cell = ivec3((position - aabbMin.xyz) / cellSize);
+        ivec3 cell = ivec3((position - aabb.minimum.xyz) / cellSize);
         cell = clamp(cell, ivec3(0), ivec3(subdivisions - 1));
         int cellIndex = int(getCellIndex(cell, uint(subdivisions)));
 
@@ -608,4 +694,9 @@ void main()
     }
 
     fragColor = vec4(gammaCorrection(color),1.0);
+
+    if(countersEnabled != 0){
+        uint pixel = uint(gl_FragCoord.y) * uint(iResolution.x) + uint(gl_FragCoord.x);
+        pixelCounters.data[pixel] = uvec4(uint(ri.count), sdfCalls, nodesEvaluated, primitivesEvaluated);
+    }
 }
\ No newline at end of file
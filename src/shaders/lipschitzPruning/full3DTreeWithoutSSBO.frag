@@ -229,14 +229,16 @@ vec3 lightColor =  vec3(1.0, 1.0, 1.0);
 float D = 32.0;
 /**
  * @ingroup RayVariables
- * @brief Minimun next step to consider the ray hits a surface (maximun error). 
+ * @brief Minimun next step to consider the ray hits a surface (maximun error).
+ * Uniform so the frame-time governor of main.cpp can raise it (governor.hpp).
 */
-float e = 0.0001;
+layout (location = 6) uniform float e = 0.0001;
 /**
  * @ingroup RayVariables
  * @brief Maximun ray steps.
+ * Uniform so the frame-time governor of main.cpp can lower it (governor.hpp).
 */
-float MAX_STEP = 256.0;
+layout (location = 5) uniform float MAX_STEP = 256.0;
 
 /**
  * @brief Extrusion operation for 2D SDFs.
@@ -0,0 +1,74 @@
+/**
+ * @brief Edge-aware upscale of the scene rendered at a lower resolution.
+ *
+ * Used by the frame-time governor of main.cpp when the scene is rendered below the window
+ * resolution. Each window pixel blends the 2x2 scene texels around it with bilinear weights,
+ * each weight scaled down by the color distance of its texel to the nearest texel: inside a
+ * surface the result is the bilinear filter, across a silhouette only the texels of the side
+ * of the nearest texel count, so the edges stay sharp instead of blurred.
+ *
+ * @author Edson Martinelli
+ * @date 2026
+ */
+
+#version 430 core
+
+/**
+ * @defgroup FragVariables Fragment Variables
+ * @brief Variables related to fragment shader input, output and uniforms.
+*/
+
+/**
+ * @ingroup FragVariables
+ * @brief Fragment final color.
+*/
+layout (location = 0) out vec4 fragColor;
+
+/**
+ * @ingroup FragVariables
+ * @brief Window resolution(x = width, y = height).
+*/
+layout (location = 0) uniform vec2 iResolution;
+
+/**
+ * @ingroup FragVariables
+ * @brief Scene rendered at the lower resolution.
+*/
+layout (binding = 0) uniform sampler2D scene;
+
+/**
+ * @ingroup FragVariables
+ * @brief Falloff of the weight with the squared color distance to the nearest texel.
+*/
+const float EDGE_FALLOFF = 32.0;
+
+/**
+ * @brief Main function.
+ *
+ * Blend the texels around the pixel center, weighted by position and by similarity to the
+ * nearest texel.
+ *
+ */
+void main()
+{
+    ivec2 size = textureSize(scene, 0);
+    vec2 position = gl_FragCoord.xy / iResolution * vec2(size) - 0.5;
+    ivec2 base = ivec2(floor(position));
+    vec2 f = position - vec2(base);
+
+    vec3 nearest = texelFetch(scene, clamp(ivec2(floor(position + 0.5)), ivec2(0), size - 1), 0).rgb;
+    vec3 color = vec3(0.0);
+    float total = 0.0;
+    for (int y = 0; y < 2; y++) {
+        for (int x = 0; x < 2; x++) {
+            vec3 texel = texelFetch(scene, clamp(base + ivec2(x, y), ivec2(0), size - 1), 0).rgb;
+            vec3 difference = texel - nearest;
+            float bilinear = (x == 0 ? 1.0 - f.x : f.x) * (y == 0 ? 1.0 - f.y : f.y);
+            float weight = bilinear * exp(-EDGE_FALLOFF * dot(difference, difference));
+            color += texel * weight;
+            total += weight;
+        }
+    }
+    // O texel mais próximo sempre tem peso de similaridade 1, mas o bilinear pode zerar
+    fragColor = vec4(total > 1e-5 ? color / total : nearest, 1.0);
+}
@@ -1,5 +1,9 @@
+#ifndef SHAPE_HPP
+#define SHAPE_HPP
+
 #include <vector>
 #include <array>
+#include <random>
 
 
 struct vec4{
@@ -30,7 +34,8 @@ enum PrimitiveType {
 
 enum NodeType{
     NODE_PRIMITIVE = 0,
-    NODE_BINARY = 1
+    NODE_BINARY = 1,
+    NODE_NARY = 2 // operação sobre todos os filhos (parent == nó)
 };
 
 struct Primitive{
@@ -64,6 +69,7 @@ struct CellInfo{
     int size;
 };
 
+// limites da cena: a grade de pruning usa a caixa calculada em bounds.hpp recortada por estes limites
 void getAABB(struct AABB& aabb){
     vec4 max = {.x = 2.0f, .y = 2.0f, .z = 2.0f, .w = 0.0f};
     vec4 min = {.x = -2.0f, .y = -2.0f, .z = -2.0f, .w = 0.0f};
@@ -165,3 +171,94 @@ void getNodesPost(std::array<Node, 25>& nodes){
             }};
 }
 
+struct Scene{
+    std::vector<Primitive> primitives;
+    std::vector<BinaryOperation> binaryOperations;
+    std::vector<Node> nodes; // post-order
+};
+
+void getScenePost(Scene& scene){
+    std::array<Primitive,13> primitives;
+    std::array<BinaryOperation,12> binaryOperations;
+    std::array<Node,25> nodes;
+
+    getPrimitivesPost(primitives);
+    getBinaryOperationsPost(binaryOperations);
+    getNodesPost(nodes);
+
+    scene.primitives.assign(primitives.begin(), primitives.end());
+    scene.binaryOperations.assign(binaryOperations.begin(), binaryOperations.end());
+    scene.nodes.assign(nodes.begin(), nodes.end());
+}
+
+// calcula o campo parent de uma árvore em pós-ordem
+void setParentsPost(std::vector<Node>& nodes){
+    std::vector<int> stack;
+    for (int i = 0; i < (int)nodes.size(); i++) {
+        nodes[i].parent = -1;
+        if (nodes[i].type == NODE_BINARY) {
+            nodes[stack.back()].parent = i; stack.pop_back();
+            nodes[stack.back()].parent = i; stack.pop_back();
+        }
+        stack.push_back(i);
+    }
+}
+
+// união balanceada dos objetos [lo, hi) já emitidos em pós-ordem em objects
+void appendUnionPost(Scene& scene, const std::vector<std::vector<Node>>& objects, int lo, int hi){
+    if (hi - lo == 1) {
+        scene.nodes.insert(scene.nodes.end(), objects[lo].begin(), objects[lo].end());
+        return;
+    }
+    int mid = (lo + hi) / 2;
+    appendUnionPost(scene, objects, lo, mid);
+    appendUnionPost(scene, objects, mid, hi);
+    scene.nodes.push_back({.type = NODE_BINARY, .index = 0, .sign = 1, .parent = -1});
+}
+
+// cena procedural: chão + count anéis (alguns cortados por uma barra) em uma parede no plano xy
+void getSceneRings(Scene& scene, int count, unsigned int seed, struct AABB& limits){
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+
+    int side = (int)std::ceil(std::sqrt((float)count));
+    float spacing = 1.2f;
+    float half = side * spacing * 0.5f;
+
+    scene.primitives = {{.type = PRIMITIVE_FLOOR}};
+    scene.binaryOperations = {{.k = 0, .s = 1, .ca = 1, .cb = 1},   // união
+                              {.k = 0, .s = -1, .ca = 1, .cb = -1}}; // subtração
+    scene.nodes.clear();
+
+    std::vector<std::vector<Node>> objects;
+    objects.push_back({{.type = NODE_PRIMITIVE, .index = 0, .sign = 1, .parent = -1}});
+
+    for (int i = 0; i < count; i++) {
+        float x = -half + spacing * ((i % side) + 0.5f) + (unit(rng) - 0.5f) * 0.3f;
+        float y = spacing * (i / side) + (unit(rng) - 0.5f) * 0.3f;
+        float r = 0.3f + 0.2f * unit(rng);
+        float depth = 0.2f + 0.3f * unit(rng);
+
+        int circle = scene.primitives.size();
+        scene.primitives.push_back({.offsetX = x, .offsetY = y, .r = r, .depth = depth, .type = PRIMITIVE_CYLINDER});
+        scene.primitives.push_back({.offsetX = x, .offsetY = y, .r = r * 0.84f, .depth = depth + 0.01f, .type = PRIMITIVE_CYLINDER});
+
+        std::vector<Node> object = {{.type = NODE_PRIMITIVE, .index = circle, .sign = 1, .parent = -1},
+                                    {.type = NODE_PRIMITIVE, .index = circle + 1, .sign = -1, .parent = -1},
+                                    {.type = NODE_BINARY, .index = 1, .sign = 1, .parent = -1}};
+        if (unit(rng) < 0.5f) {
+            float m = std::tan((unit(rng) - 0.5f) * 3.0f);
+            scene.primitives.push_back({.sideCenterX = x - r, .sideCenterY = y, .m = m, .xEnd = x + r, .th = 0.08f, .depth = depth + 0.01f, .type = PRIMITIVE_BOX});
+            object.push_back({.type = NODE_PRIMITIVE, .index = (int)scene.primitives.size() - 1, .sign = -1, .parent = -1});
+            object.push_back({.type = NODE_BINARY, .index = 1, .sign = 1, .parent = -1});
+        }
+        objects.push_back(object);
+    }
+
+    appendUnionPost(scene, objects, 0, objects.size());
+    setParentsPost(scene.nodes);
+
+    limits = {.maximum = {half + 1.0f, 2.0f * half + 1.0f, 2.0f, 0.0f}, .minimum = {-half - 1.0f, -2.0f, -2.0f, 0.0f}};
+}
+
+#endif
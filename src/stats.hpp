@@ -0,0 +1,199 @@
+/**
+ * @file stats.hpp
+ * @brief Sample statistics and benchmark reports.
+ *
+ * Summaries of frame and shader time samples (mean, median, p95, p99 and the 95% confidence
+ * interval of the mean) and the report written by the benchmark mode of main.cpp, as JSON or
+ * as CSV rows (a new file gets the header, an existing one gets one more row, so runs of
+ * different variants can share a table). The per-level statistics of the pruning grid
+ * (PruningLevelStats) are filled by pruning.hpp on the CPU and by the readback of main.cpp.
+ *
+ * @author Edson Martinelli
+ * @date 2026
+ */
+
+#ifndef STATS_HPP
+#define STATS_HPP
+
+#include <cmath>
+#include <cstdio>
+#include <string>
+#include <vector>
+#include <utility>
+#include <algorithm>
+
+/**
+ * @brief Summary of a set of samples.
+ */
+struct SampleStats{
+    int count = 0; /**< Number of samples. */
+    double mean = 0.0; /**< Mean. */
+    double median = 0.0; /**< 50th percentile. */
+    double p95 = 0.0; /**< 95th percentile. */
+    double p99 = 0.0; /**< 99th percentile. */
+    double stddev = 0.0; /**< Sample standard deviation. */
+    double ci95 = 0.0; /**< Half width of the 95% confidence interval of the mean. */
+};
+
+/**
+ * @brief Summarize samples.
+ *
+ * @param [in] samples Samples (copied to sort).
+ * @param [out] stats Summary.
+ */
+void getSampleStats(std::vector<double> samples, SampleStats& stats){
+    stats = SampleStats();
+    stats.count = samples.size();
+    if (samples.empty()) return;
+
+    std::sort(samples.begin(), samples.end());
+    double sum = 0.0;
+    for (double s : samples) sum += s;
+    stats.mean = sum / samples.size();
+
+    double variance = 0.0;
+    for (double s : samples) variance += (s - stats.mean) * (s - stats.mean);
+    if (samples.size() > 1) variance /= samples.size() - 1;
+    stats.stddev = std::sqrt(variance);
+    stats.ci95 = 1.96 * stats.stddev / std::sqrt((double)samples.size());
+
+    auto percentile = [&](double p){
+        return samples[std::min(samples.size() - 1, (size_t)(p / 100.0 * samples.size()))];
+    };
+    stats.median = percentile(50.0);
+    stats.p95 = percentile(95.0);
+    stats.p99 = percentile(99.0);
+}
+
+/**
+ * @brief Check if the mean of the samples is known within a tolerance.
+ *
+ * @param [in] stats Summary of the samples.
+ * @param [in] tolerance Largest confidence interval half width relative to the mean.
+ * @param [in] minimum Minimum number of samples.
+ * @return True when the interval converged.
+ */
+bool isConverged(const SampleStats& stats, double tolerance, int minimum){
+    return stats.count >= minimum && stats.ci95 <= tolerance * stats.mean;
+}
+
+/**
+ * @brief Statistics of one pruning level.
+ */
+struct PruningLevelStats{
+    int level = 0; /**< Level index. */
+    int subdivisions = 0; /**< Cells per axis. */
+    int cells = 0; /**< Number of cells. */
+    int activeCells = 0; /**< Cells with a tree. */
+    long nodes = 0; /**< Nodes of all cells (numNodes of the compute shader). */
+    double meanNodes = 0.0; /**< Mean nodes per active cell. */
+    int maxNodes = 0; /**< Largest cell tree. */
+    double farFieldFraction = 0.0; /**< Fraction of the cells without tree (far-field only). */
+    double time = 0.0; /**< Level time in ms. */
+};
+
+/**
+ * @brief Write the statistics of the pruning levels as a JSON array.
+ *
+ * @param [in] file Output file.
+ * @param [in] name Field name.
+ * @param [in] levels Statistics of each level.
+ */
+void writePruningLevelsJSON(FILE* file, const char* name, const std::vector<PruningLevelStats>& levels){
+    std::fprintf(file, "  \"%s\": [", name);
+    for (size_t i = 0; i < levels.size(); i++) {
+        const PruningLevelStats& l = levels[i];
+        std::fprintf(file, "%s\n    {\"level\": %d, \"subdivisions\": %d, \"cells\": %d, \"active_cells\": %d, "
+                     "\"nodes\": %ld, \"mean_nodes\": %.4f, \"max_nodes\": %d, \"far_field_fraction\": %.6f, "
+                     "\"time_ms\": %.6f}", i > 0 ? "," : "", l.level, l.subdivisions, l.cells, l.activeCells, l.nodes,
+                     l.meanNodes, l.maxNodes, l.farFieldFraction, l.time);
+    }
+    std::fprintf(file, "%s]", levels.empty() ? "" : "\n  ");
+}
+
+/**
+ * @brief Result of a benchmark run.
+ */
+struct BenchmarkReport{
+    std::string variant; /**< Shader variant compiled in the program. */
+    int width = 0; /**< Render width. */
+    int height = 0; /**< Render height. */
+    int gridLevel = 0; /**< Pruning levels. */
+    double warmup = 0.0; /**< Warmup time in seconds. */
+    double duration = 0.0; /**< Measured time in seconds. */
+    bool converged = false; /**< The run stopped because the intervals converged. */
+    double pruningTime = 0.0; /**< Pruning compute time in ms. */
+    SampleStats frameTime; /**< Frame time in ms. */
+    SampleStats shaderTime; /**< Fragment shader time in ms. */
+    std::vector<std::pair<std::string, double>> passes; /**< Mean time of each GPU pass in ms (JSON only). */
+    std::vector<PruningLevelStats> pruningLevels; /**< Statistics of each pruning level (JSON only). */
+};
+
+/**
+ * @brief Write the summary of samples as a JSON object.
+ *
+ * @param [in] file Output file.
+ * @param [in] name Field name.
+ * @param [in] stats Summary.
+ */
+void writeStatsJSON(FILE* file, const char* name, const SampleStats& stats){
+    std::fprintf(file, "  \"%s\": {\"count\": %d, \"mean\": %.6f, \"median\": %.6f, \"p95\": %.6f, \"p99\": %.6f, "
+                 "\"stddev\": %.6f, \"ci95\": %.6f}", name, stats.count, stats.mean, stats.median, stats.p95, stats.p99,
+                 stats.stddev, stats.ci95);
+}
+
+/**
+ * @brief Write a benchmark report.
+ *
+ * A path ending in .csv appends one row (with the header if the file is new), any other path
+ * is written as JSON.
+ *
+ * @param [in] path File path.
+ * @param [in] report Benchmark result.
+ * @return False if the file could not be written.
+ */
+bool writeReport(const char* path, const BenchmarkReport& report){
+    std::string name = path;
+    bool csv = name.size() >= 4 && name.compare(name.size() - 4, 4, ".csv") == 0;
+
+    if (csv) {
+        FILE* existing = std::fopen(path, "r");
+        bool header = existing == nullptr;
+        if (existing != nullptr) std::fclose(existing);
+
+        FILE* file = std::fopen(path, "a");
+        if (file == nullptr) return false;
+        if (header) {
+            std::fprintf(file, "variant,width,height,grid_level,warmup_s,duration_s,converged,pruning_ms,frames,"
+                         "frame_mean_ms,frame_median_ms,frame_p95_ms,frame_p99_ms,frame_ci95_ms,"
+                         "shader_mean_ms,shader_median_ms,shader_p95_ms,shader_p99_ms,shader_ci95_ms\n");
+        }
+        const SampleStats& f = report.frameTime;
+        const SampleStats& s = report.shaderTime;
+        std::fprintf(file, "%s,%d,%d,%d,%.3f,%.3f,%d,%.6f,%d,%.6f,%.6f,%.6f,%.6f,%.6f,%.6f,%.6f,%.6f,%.6f,%.6f\n",
+                     report.variant.c_str(), report.width, report.height, report.gridLevel, report.warmup,
+                     report.duration, report.converged, report.pruningTime, f.count, f.mean, f.median, f.p95, f.p99,
+                     f.ci95, s.mean, s.median, s.p95, s.p99, s.ci95);
+        return std::fclose(file) == 0;
+    }
+
+    FILE* file = std::fopen(path, "w");
+    if (file == nullptr) return false;
+    std::fprintf(file, "{\n  \"variant\": \"%s\",\n  \"width\": %d,\n  \"height\": %d,\n  \"grid_level\": %d,\n"
+                 "  \"warmup_s\": %.3f,\n  \"duration_s\": %.3f,\n  \"converged\": %s,\n  \"pruning_ms\": %.6f,\n",
+                 report.variant.c_str(), report.width, report.height, report.gridLevel, report.warmup,
+                 report.duration, report.converged ? "true" : "false", report.pruningTime);
+    writeStatsJSON(file, "frame_ms", report.frameTime);
+    std::fprintf(file, ",\n");
+    writeStatsJSON(file, "shader_ms", report.shaderTime);
+    std::fprintf(file, ",\n  \"passes_ms\": {");
+    for (size_t i = 0; i < report.passes.size(); i++) {
+        std::fprintf(file, "%s\"%s\": %.6f", i > 0 ? ", " : "", report.passes[i].first.c_str(), report.passes[i].second);
+    }
+    std::fprintf(file, "},\n");
+    writePruningLevelsJSON(file, "pruning_levels", report.pruningLevels);
+    std::fprintf(file, "\n}\n");
+    return std::fclose(file) == 0;
+}
+
+#endif
@@ -0,0 +1,206 @@
+/**
+ * @file tape.hpp
+ * @brief Per-cell instruction tapes compiled from the pruned trees.
+ *
+ * The pruning already drops the operations whose result is decided in a cell. This pass
+ * rewrites what is left of each cell tree into the shortest instruction stream: signs are
+ * pushed down to the primitives (a negated operation becomes the opposite operation over
+ * negated operands, so double negations cancel) and chains of hard unions or intersections
+ * in the same direction are merged into one n-ary min/max instruction.
+ *
+ * @author Edson Martinelli
+ * @date 2026
+ */
+
+#ifndef TAPE_HPP
+#define TAPE_HPP
+
+#include <vector>
+#include <algorithm>
+#include "shape.hpp"
+#include "vector.hpp"
+#include "bounds.hpp"
+#include "evaluator.hpp"
+
+#define TAPE_PRIMITIVE 0 /**< Push sign * primitive value. */
+#define TAPE_BINARY 1 /**< Smooth binary operation over the two top values. */
+#define TAPE_MIN 2 /**< Minimum of the count top values. */
+#define TAPE_MAX 3 /**< Maximum of the count top values. */
+
+const int TAPE_CHAIN_MAX = 16; /**< Maximum operands of one TAPE_MIN/TAPE_MAX, bounds the evaluation stack. */
+
+/**
+ * @brief Tape instruction. Layout matches the std430 Instruction struct of the shaders.
+ */
+struct Instruction{
+    int op; /**< Instruction type (TAPE_*). */
+    int index; /**< Primitive or binary operation index. */
+    int count; /**< Operands of TAPE_MIN/TAPE_MAX, operation direction s of TAPE_BINARY. */
+    int sign; /**< Sign of a TAPE_PRIMITIVE value. */
+};
+
+/**
+ * @brief Emit the instructions of a subtree.
+ *
+ * @param [in] scene Scene with binary operations.
+ * @param [in] nodes Post-order node array.
+ * @param [in] start First node of each subtree (see getSubtreeStarts).
+ * @param [in] root Subtree root.
+ * @param [in] sign Sign applied by the ancestors (1 or -1).
+ * @param [out] tape Tape where the instructions are appended.
+ */
+void emitTape(const Scene& scene, const Node* nodes, const std::vector<int>& start, int root, int sign,
+              std::vector<Instruction>& tape);
+
+/**
+ * @brief Emit the operands of a hard min/max chain.
+ *
+ * Operands that are hard operations in the same direction (after their sign), binary or
+ * n-ary, are opened recursively while the chain has free operand slots.
+ *
+ * @param [in] scene Scene with binary operations.
+ * @param [in] nodes Post-order node array.
+ * @param [in] start First node of each subtree (see getSubtreeStarts).
+ * @param [in] root Operand root.
+ * @param [in] sign Sign applied by the ancestors (1 or -1).
+ * @param [in] s Direction of the chain (1 min, -1 max).
+ * @param [in,out] slots Operand slots left in the chain, an opened operation takes one per extra operand.
+ * @param [out] tape Tape where the instructions are appended.
+ * @return Number of operands pushed.
+ */
+int emitChain(const Scene& scene, const Node* nodes, const std::vector<int>& start, int root, int sign, int s,
+              int& slots, std::vector<Instruction>& tape){
+    const Node& node = nodes[root];
+    int nodeSign = node.sign * sign;
+    if (node.type != NODE_PRIMITIVE) {
+        const BinaryOperation& op = scene.binaryOperations[node.index];
+        std::vector<int> children;
+        getChildren(start, root, children);
+        if (op.k == 0 && op.s * nodeSign == s && slots >= (int)children.size() - 1) {
+            slots -= children.size() - 1;
+            int count = 0;
+            for (int child : children) count += emitChain(scene, nodes, start, child, nodeSign, s, slots, tape);
+            return count;
+        }
+    }
+    emitTape(scene, nodes, start, root, sign, tape);
+    return 1;
+}
+
+void emitTape(const Scene& scene, const Node* nodes, const std::vector<int>& start, int root, int sign,
+              std::vector<Instruction>& tape){
+    const Node& node = nodes[root];
+    int nodeSign = node.sign * sign;
+
+    if (node.type == NODE_PRIMITIVE) {
+        tape.push_back({TAPE_PRIMITIVE, node.index, 0, nodeSign});
+        return;
+    }
+
+    // -op_s(a, b) = op_-s(-a, -b), inclusive com o termo smooth
+    const BinaryOperation& op = scene.binaryOperations[node.index];
+    int s = op.s * nodeSign;
+    std::vector<int> children;
+    getChildren(start, root, children);
+
+    if (op.k == 0) {
+        int slots = std::max(TAPE_CHAIN_MAX - (int)children.size(), 0);
+        int count = 0;
+        for (int child : children) count += emitChain(scene, nodes, start, child, nodeSign, s, slots, tape);
+        tape.push_back({s == 1 ? TAPE_MIN : TAPE_MAX, 0, count, 1});
+        return;
+    }
+
+    // Nó n-ário smooth: dobra da esquerda para a direita
+    emitTape(scene, nodes, start, children[0], nodeSign, tape);
+    for (int j = 1; j < (int)children.size(); j++) {
+        emitTape(scene, nodes, start, children[j], nodeSign, tape);
+        tape.push_back({TAPE_BINARY, node.index, s, 1});
+    }
+}
+
+/**
+ * @brief Compile the tape of one tree.
+ *
+ * @param [in] scene Scene with binary operations.
+ * @param [in] nodes Post-order node array (a cell tree).
+ * @param [in] size Number of nodes.
+ * @param [out] tape Tape where the instructions are appended.
+ * @return Number of instructions appended.
+ */
+int compileTape(const Scene& scene, const Node* nodes, int size, std::vector<Instruction>& tape){
+    if (size == 0) return 0;
+    std::vector<int> start;
+    getSubtreeStarts(nodes, size, start);
+    int before = tape.size();
+    emitTape(scene, nodes, start, size - 1, 1, tape);
+    return tape.size() - before;
+}
+
+/**
+ * @brief Compile the tapes of all cells of a pruning grid.
+ *
+ * @param [in] scene Scene with binary operations.
+ * @param [in] cells Tree of each cell in the nodes array.
+ * @param [in] nodes Reduced trees of all cells.
+ * @param [out] tapeCells Tape of each cell in the tape array (size 0 keeps the far-field).
+ * @param [out] tape Tapes of all cells.
+ */
+void compileGridTapes(const Scene& scene, const std::vector<CellInfo>& cells, const std::vector<Node>& nodes,
+                      std::vector<CellInfo>& tapeCells, std::vector<Instruction>& tape){
+    tapeCells.resize(cells.size());
+    tape.clear();
+    for (int i = 0; i < (int)cells.size(); i++) {
+        int offset = tape.size();
+        int size = compileTape(scene, nodes.data() + cells[i].offset, cells[i].size, tape);
+        tapeCells[i] = {offset, size};
+    }
+}
+
+/**
+ * @brief Tape evaluation.
+ *
+ * @param [in] p 3D space position.
+ * @param [in] scene Scene with primitives and binary operations.
+ * @param [in] tape Instructions.
+ * @param [in] size Number of instructions.
+ * @return The SDF value at the position.
+ */
+float evalTape(vec3 p, const Scene& scene, const Instruction* tape, int size){
+    float stack[STACK_MAX];
+    int stackIndex = 0;
+
+    for (int i = 0; i < size; i++) {
+        const Instruction& instruction = tape[i];
+        switch (instruction.op) {
+            case TAPE_PRIMITIVE:
+                stack[stackIndex++] = instruction.sign * evalPrimitive(p, scene.primitives[instruction.index]);
+                break;
+            case TAPE_BINARY: {
+                float k = scene.binaryOperations[instruction.index].k;
+                int s = instruction.count;
+                float leftValue = stack[stackIndex - 2];
+                float rightValue = stack[stackIndex - 1];
+                stackIndex -= 2;
+                stack[stackIndex++] = s * (std::min(s * leftValue, s * rightValue) - smoothFunction(leftValue, rightValue, k));
+                break;
+            }
+            case TAPE_MIN: {
+                float d = stack[--stackIndex];
+                for (int j = 1; j < instruction.count; j++) d = std::min(d, stack[--stackIndex]);
+                stack[stackIndex++] = d;
+                break;
+            }
+            case TAPE_MAX: {
+                float d = stack[--stackIndex];
+                for (int j = 1; j < instruction.count; j++) d = std::max(d, stack[--stackIndex]);
+                stack[stackIndex++] = d;
+                break;
+            }
+        }
+    }
+
+    return stack[0];
+}
+
+#endif
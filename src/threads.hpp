@@ -0,0 +1,160 @@
+/**
+ * @file threads.hpp
+ * @brief Parallel loops over items.
+ *
+ * parallelFor starts its threads on each call, which is fine for long jobs like the mesh
+ * extraction. Batched queries run many short jobs, so they keep a WorkerPool whose threads
+ * wait between jobs; running a job takes no allocation (the job is a function pointer and a
+ * pointer to the caller function object).
+ *
+ * @author Edson Martinelli
+ * @date 2026
+ */
+
+#ifndef THREADS_HPP
+#define THREADS_HPP
+
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <algorithm>
+
+/**
+ * @brief Number of threads to use.
+ *
+ * @param [in] threads Requested threads (0 for the hardware concurrency).
+ * @return At least one thread.
+ */
+int getThreadCount(int threads){
+    if (threads <= 0) threads = std::thread::hardware_concurrency();
+    return std::max(threads, 1);
+}
+
+/**
+ * @brief Run a function over [0, count) in parallel.
+ *
+ * @param [in] count Number of items.
+ * @param [in] threads Number of threads (0 for the hardware concurrency).
+ * @param [in] f Function called with each item.
+ */
+template <typename F>
+void parallelFor(int count, int threads, F&& f){
+    threads = getThreadCount(threads);
+    std::atomic<int> next(0);
+    auto worker = [&]{
+        for (int i = next++; i < count; i = next++) f(i);
+    };
+    std::vector<std::thread> pool;
+    for (int t = 1; t < threads; t++) pool.emplace_back(worker);
+    worker();
+    for (std::thread& thread : pool) thread.join();
+}
+
+/**
+ * @brief Threads waiting for jobs.
+ */
+struct WorkerPool{
+    std::vector<std::thread> threads; /**< Workers (the caller of runWorkerPool is one more). */
+    std::mutex mutex; /**< Guards the job fields below. */
+    std::condition_variable wake; /**< Signals a new job or the stop. */
+    std::condition_variable finished; /**< Signals the last worker leaving a job. */
+    void (*job)(void* context, int item) = nullptr; /**< Function of the current job. */
+    void* context = nullptr; /**< Argument of the job function. */
+    int count = 0; /**< Items of the current job. */
+    std::atomic<int> next{0}; /**< Next item to take. */
+    int generation = 0; /**< Incremented at each job. */
+    int busy = 0; /**< Workers still in the current job. */
+    bool stop = false; /**< Workers must exit. */
+
+    ~WorkerPool();
+};
+
+/**
+ * @brief Take items of the current job until none is left.
+ *
+ * @param [in,out] pool Worker pool.
+ */
+void workWorkerPool(WorkerPool& pool){
+    for (int i = pool.next++; i < pool.count; i = pool.next++) pool.job(pool.context, i);
+}
+
+/**
+ * @brief Start the workers.
+ *
+ * @param [out] pool Worker pool (not started).
+ * @param [in] threads Total threads including the caller (0 for the hardware concurrency).
+ */
+void startWorkerPool(WorkerPool& pool, int threads){
+    threads = getThreadCount(threads);
+    pool.stop = false;
+    for (int t = 1; t < threads; t++) {
+        pool.threads.emplace_back([&pool]{
+            int generation = 0;
+            while (true) {
+                {
+                    std::unique_lock<std::mutex> lock(pool.mutex);
+                    pool.wake.wait(lock, [&]{ return pool.stop || pool.generation != generation; });
+                    if (pool.stop) return;
+                    generation = pool.generation;
+                }
+                workWorkerPool(pool);
+                std::lock_guard<std::mutex> lock(pool.mutex);
+                if (--pool.busy == 0) pool.finished.notify_one();
+            }
+        });
+    }
+}
+
+/**
+ * @brief Stop and join the workers.
+ *
+ * @param [in,out] pool Worker pool.
+ */
+void stopWorkerPool(WorkerPool& pool){
+    {
+        std::lock_guard<std::mutex> lock(pool.mutex);
+        pool.stop = true;
+    }
+    pool.wake.notify_all();
+    for (std::thread& thread : pool.threads) thread.join();
+    pool.threads.clear();
+}
+
+/**
+ * @brief Stop the workers left running (a joinable thread would call std::terminate).
+ */
+WorkerPool::~WorkerPool(){
+    stopWorkerPool(*this);
+}
+
+/**
+ * @brief Run a function over [0, count) with the pool and the calling thread.
+ *
+ * @param [in,out] pool Started worker pool.
+ * @param [in] count Number of items.
+ * @param [in] f Function called with each item.
+ */
+template <typename F>
+void runWorkerPool(WorkerPool& pool, int count, F& f){
+    if (pool.threads.empty() || count <= 1) {
+        for (int i = 0; i < count; i++) f(i);
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(pool.mutex);
+        pool.job = [](void* context, int item){ (*static_cast<F*>(context))(item); };
+        pool.context = &f;
+        pool.count = count;
+        pool.next = 0;
+        pool.busy = pool.threads.size();
+        pool.generation++;
+    }
+    pool.wake.notify_all();
+    workWorkerPool(pool);
+    std::unique_lock<std::mutex> lock(pool.mutex);
+    pool.finished.wait(lock, [&]{ return pool.busy == 0; });
+}
+
+#endif
@@ -0,0 +1,158 @@
+/**
+ * @file trace.hpp
+ * @brief Timeline of CPU and GPU zones written as Chrome trace JSON.
+ *
+ * A zone is a named interval on one thread of the timeline. CPU zones are scoped (TraceScope
+ * records the interval of its lifetime, or until endTraceScope()), GPU zones come from the
+ * timestamp pairs of gputimer.hpp once they are read, moved to the CPU clock, on their own
+ * "GPU" thread. The file opens in chrome://tracing or ui.perfetto.dev. A null or disabled
+ * trace costs one branch per zone, and the events are kept in memory until writeTrace().
+ *
+ * @author Edson Martinelli
+ * @date 2026
+ */
+
+#ifndef TRACE_HPP
+#define TRACE_HPP
+
+#include <cstdio>
+#include <chrono>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+const int TRACE_GPU_THREAD = 0; /**< Timeline thread of the GPU zones. */
+
+/**
+ * @brief Zone of the timeline.
+ */
+struct TraceEvent{
+    std::string name; /**< Zone name. */
+    const char* category; /**< Zone category (startup, pruning, frame, gpu, render). */
+    double start; /**< Start in microseconds since the trace start. */
+    double duration; /**< Duration in microseconds. */
+    int thread; /**< Timeline thread (TRACE_GPU_THREAD or a CPU thread from 1). */
+    int item; /**< Task item shown in the arguments, -1 for none. */
+};
+
+/**
+ * @brief Zones recorded by all threads.
+ */
+struct Trace{
+    bool enabled = false; /**< Zones are recorded. */
+    std::chrono::steady_clock::time_point origin; /**< Trace start. */
+    std::mutex mutex; /**< Guards events and threads. */
+    std::vector<TraceEvent> events; /**< Recorded zones. */
+    std::vector<std::thread::id> threads; /**< CPU thread of each timeline thread from 1. */
+};
+
+/**
+ * @brief Start recording.
+ *
+ * @param [out] trace Trace.
+ */
+void startTrace(Trace& trace){
+    trace.origin = std::chrono::steady_clock::now();
+    trace.events.clear();
+    trace.threads.clear();
+    trace.enabled = true;
+}
+
+/**
+ * @brief Time since the trace start.
+ *
+ * @param [in] trace Trace.
+ * @return Microseconds since startTrace().
+ */
+double getTraceTime(const Trace& trace){
+    return std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - trace.origin).count();
+}
+
+/**
+ * @brief Record a zone.
+ *
+ * @param [in,out] trace Started trace.
+ * @param [in] name Zone name.
+ * @param [in] category Zone category (a string literal).
+ * @param [in] start Start in microseconds since the trace start.
+ * @param [in] duration Duration in microseconds.
+ * @param [in] thread Timeline thread, -1 for the calling CPU thread.
+ * @param [in] item Task item, -1 for none.
+ */
+void addTraceEvent(Trace& trace, const std::string& name, const char* category, double start, double duration,
+                   int thread = -1, int item = -1){
+    std::lock_guard<std::mutex> lock(trace.mutex);
+    if (thread < 0) {
+        std::thread::id id = std::this_thread::get_id();
+        thread = 0;
+        while (thread < (int)trace.threads.size() && trace.threads[thread] != id) thread++;
+        if (thread == (int)trace.threads.size()) trace.threads.push_back(id);
+        thread++;
+    }
+    trace.events.push_back({name, category, start, duration, thread, item});
+}
+
+/**
+ * @brief CPU zone of a scope.
+ */
+struct TraceScope{
+    Trace* trace; /**< Trace, null when not tracing. */
+    const char* name; /**< Zone name (a string literal or a string living as long as the scope). */
+    const char* category; /**< Zone category. */
+    int item; /**< Task item, -1 for none. */
+    double start; /**< Start in microseconds. */
+
+    TraceScope(Trace* trace, const char* name, const char* category, int item = -1)
+        : trace(trace != nullptr && trace->enabled ? trace : nullptr), name(name), category(category), item(item),
+          start(this->trace != nullptr ? getTraceTime(*this->trace) : 0.0){}
+
+    ~TraceScope(){
+        if (trace != nullptr) addTraceEvent(*trace, name, category, start, getTraceTime(*trace) - start, -1, item);
+    }
+};
+
+/**
+ * @brief End a zone before its scope ends.
+ *
+ * For zones around code that declares variables used after it.
+ *
+ * @param [in,out] scope Zone, recorded once.
+ */
+void endTraceScope(TraceScope& scope){
+    if (scope.trace != nullptr) {
+        addTraceEvent(*scope.trace, scope.name, scope.category, scope.start, getTraceTime(*scope.trace) - scope.start,
+                      -1, scope.item);
+    }
+    scope.trace = nullptr;
+}
+
+/**
+ * @brief Write the zones as Chrome trace JSON.
+ *
+ * @param [in] path File path.
+ * @param [in,out] trace Trace (locked while writing).
+ * @return False if the file could not be written.
+ */
+bool writeTrace(const char* path, Trace& trace){
+    std::lock_guard<std::mutex> lock(trace.mutex);
+    FILE* file = std::fopen(path, "w");
+    if (file == nullptr) return false;
+    std::fprintf(file, "{\"displayTimeUnit\": \"ms\", \"traceEvents\": [\n");
+    std::fprintf(file, "{\"name\": \"thread_name\", \"ph\": \"M\", \"pid\": 1, \"tid\": %d, \"args\": {\"name\": \"GPU\"}}",
+                 TRACE_GPU_THREAD);
+    for (int t = 1; t <= (int)trace.threads.size(); t++) {
+        std::fprintf(file, ",\n{\"name\": \"thread_name\", \"ph\": \"M\", \"pid\": 1, \"tid\": %d, \"args\": {\"name\": \"%s %d\"}}",
+                     t, t == 1 ? "main" : "worker", t);
+    }
+    for (const TraceEvent& event : trace.events) {
+        std::fprintf(file, ",\n{\"name\": \"%s\", \"cat\": \"%s\", \"ph\": \"X\", \"ts\": %.3f, \"dur\": %.3f, \"pid\": 1, \"tid\": %d",
+                     event.name.c_str(), event.category, event.start, event.duration, event.thread);
+        if (event.item >= 0) std::fprintf(file, ", \"args\": {\"item\": %d}", event.item);
+        std::fprintf(file, "}");
+    }
+    std::fprintf(file, "\n]}\n");
+    return std::fclose(file) == 0;
+}
+
+#endif
@@ -0,0 +1,97 @@
+/**
+ * @file upscale.hpp
+ * @brief Scene render target below the window resolution and its edge-aware upscale.
+ *
+ * With the frame-time governor (governor.hpp) the marcher renders into an RGBA8 texture of
+ * the governed size, and the upscale pass (shaders/upscale.frag) draws it over the output
+ * framebuffer at the window size, blending the texels around each pixel with bilinear weights
+ * lowered across color edges. The texture is reallocated only when the render size changes.
+ *
+ * @author Edson Martinelli
+ * @date 2026
+ */
+
+#ifndef UPSCALE_HPP
+#define UPSCALE_HPP
+
+#include <glad/glad.h>
+#include <commun/shader.hpp>
+
+/**
+ * @brief Scene texture and upscale program.
+ */
+struct ScaledTarget{
+    GLuint framebuffer = 0; /**< Framebuffer of the scene texture. */
+    GLuint texture = 0; /**< RGBA8 scene texture. */
+    int width = 0; /**< Texture width. */
+    int height = 0; /**< Texture height. */
+    GLuint program = 0; /**< Upscale program. */
+};
+
+/**
+ * @brief Compile the upscale program and create the framebuffer.
+ *
+ * @param [out] target Render target, without storage until resizeScaledTarget().
+ */
+void createScaledTarget(ScaledTarget& target){
+    unsigned int vertexShader = createShader(GL_VERTEX_SHADER, "src/shaders/vertexshader.vert");
+    unsigned int fragmentShader = createShader(GL_FRAGMENT_SHADER, "src/shaders/upscale.frag");
+    target.program = createShaderProgram(vertexShader, fragmentShader);
+    glGenFramebuffers(1, &target.framebuffer);
+    glGenTextures(1, &target.texture);
+}
+
+/**
+ * @brief Give the scene texture a size.
+ *
+ * @param [in,out] target Render target.
+ * @param [in] width Render width.
+ * @param [in] height Render height.
+ */
+void resizeScaledTarget(ScaledTarget& target, int width, int height){
+    if (target.width == width && target.height == height) return;
+    target.width = width;
+    target.height = height;
+    glBindTexture(GL_TEXTURE_2D, target.texture);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    glBindFramebuffer(GL_FRAMEBUFFER, target.framebuffer);
+    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, target.texture, 0);
+}
+
+/**
+ * @brief Draw the scene texture over the output at the window size.
+ *
+ * Leaves the output framebuffer bound and the upscale program in use.
+ *
+ * @param [in] target Render target with the scene.
+ * @param [in] output Output framebuffer.
+ * @param [in] width Window width.
+ * @param [in] height Window height.
+ * @param [in] vao Vertex array of the viewport square.
+ */
+void upscaleScaledTarget(const ScaledTarget& target, GLuint output, int width, int height, GLuint vao){
+    glBindFramebuffer(GL_FRAMEBUFFER, output);
+    glViewport(0, 0, width, height);
+    glUseProgram(target.program);
+    glUniform2f(0, (float)width, (float)height);
+    glActiveTexture(GL_TEXTURE0);
+    glBindTexture(GL_TEXTURE_2D, target.texture);
+    glBindVertexArray(vao);
+    glDrawElements(GL_TRIANGLES, 6, GL_UNSIGNED_INT, 0);
+    glBindVertexArray(0);
+}
+
+/**
+ * @brief Delete the texture, framebuffer and program.
+ *
+ * @param [in,out] target Render target.
+ */
+void freeScaledTarget(ScaledTarget& target){
+    glDeleteFramebuffers(1, &target.framebuffer);
+    glDeleteTextures(1, &target.texture);
+    glDeleteProgram(target.program);
+}
+
+#endif
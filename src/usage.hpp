@@ -0,0 +1,128 @@
+/**
+ * @file usage.hpp
+ * @brief CPU time and energy of the process while it waits for events.
+ *
+ * A sample holds the wall clock, the CPU time of the process (all its threads, the driver
+ * threads included) and, on Linux with a readable RAPL counter, the energy of the CPU
+ * package 0 (/sys/class/powercap/intel-rapl:0, usually readable by root only). The idle
+ * usage sums the differences between the samples taken around each wait of the
+ * render-on-demand loop, so it shows how much CPU and power the program costs while it
+ * shows the same image.
+ *
+ * @author Edson Martinelli
+ * @date 2026
+ */
+
+#ifndef USAGE_HPP
+#define USAGE_HPP
+
+#include <chrono>
+#include <cstdio>
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <ctime>
+#endif
+
+const char* RAPL_ENERGY_PATH = "/sys/class/powercap/intel-rapl:0/energy_uj"; /**< Energy counter of the package 0 in uJ. */
+const char* RAPL_RANGE_PATH = "/sys/class/powercap/intel-rapl:0/max_energy_range_uj"; /**< Value where the counter wraps. */
+
+/**
+ * @brief Usage counters at one moment.
+ */
+struct UsageSample{
+    double wallTime = 0.0; /**< Wall clock in seconds. */
+    double cpuTime = 0.0; /**< CPU time of the process in seconds. */
+    double energy = -1.0; /**< Package energy counter in J (-1 when not readable). */
+};
+
+/**
+ * @brief Usage summed over the waits.
+ */
+struct IdleUsage{
+    double wallTime = 0.0; /**< Time waiting in seconds. */
+    double cpuTime = 0.0; /**< CPU time of the process while waiting in seconds. */
+    double energy = 0.0; /**< Package energy while waiting in J. */
+    bool hasEnergy = true; /**< Every wait had both energy readings. */
+    long waits = 0; /**< Waits. */
+};
+
+/**
+ * @brief Read a RAPL counter.
+ *
+ * @param [in] path Counter file.
+ * @return Value in uJ, or -1 when the file does not exist or is not readable.
+ */
+double readRaplCounter(const char* path){
+    FILE* file = std::fopen(path, "r");
+    if (file == nullptr) return -1.0;
+    double value = -1.0;
+    if (std::fscanf(file, "%lf", &value) != 1) value = -1.0;
+    std::fclose(file);
+    return value;
+}
+
+/**
+ * @brief Take a sample.
+ *
+ * @param [out] sample Counters now.
+ */
+void getUsageSample(UsageSample& sample){
+    sample.wallTime = std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+#ifdef _WIN32
+    FILETIME creation, exitTime, kernel, user;
+    GetProcessTimes(GetCurrentProcess(), &creation, &exitTime, &kernel, &user);
+    ULARGE_INTEGER kernelTime = {{kernel.dwLowDateTime, kernel.dwHighDateTime}};
+    ULARGE_INTEGER userTime = {{user.dwLowDateTime, user.dwHighDateTime}};
+    sample.cpuTime = (kernelTime.QuadPart + userTime.QuadPart) * 1e-7;
+    sample.energy = -1.0;
+#else
+    timespec cpu;
+    clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &cpu);
+    sample.cpuTime = cpu.tv_sec + cpu.tv_nsec * 1e-9;
+    double energy = readRaplCounter(RAPL_ENERGY_PATH);
+    sample.energy = energy < 0.0 ? -1.0 : energy * 1e-6;
+#endif
+}
+
+/**
+ * @brief Add a wait to the idle usage.
+ *
+ * @param [in,out] usage Idle usage.
+ * @param [in] before Sample before the wait.
+ * @param [in] after Sample after the wait.
+ */
+void addIdleUsage(IdleUsage& usage, const UsageSample& before, const UsageSample& after){
+    usage.wallTime += after.wallTime - before.wallTime;
+    usage.cpuTime += after.cpuTime - before.cpuTime;
+    usage.waits++;
+    if (before.energy < 0.0 || after.energy < 0.0) {
+        usage.hasEnergy = false;
+        return;
+    }
+    // O contador volta a zero ao passar do máximo
+    double energy = after.energy - before.energy;
+    if (energy < 0.0) energy += readRaplCounter(RAPL_RANGE_PATH) * 1e-6;
+    usage.energy += energy;
+}
+
+/**
+ * @brief Print the idle usage.
+ *
+ * @param [in] usage Idle usage.
+ * @param [in] frames Frames drawn by the loop.
+ */
+void printIdleUsage(const IdleUsage& usage, long frames){
+    std::printf("Ocioso: %.2f s em %ld esperas, %ld quadros desenhados", usage.wallTime, usage.waits, frames);
+    if (usage.wallTime <= 0.0) {
+        std::printf("\n");
+        return;
+    }
+    std::printf(", CPU %.2f%% de um núcleo", usage.cpuTime / usage.wallTime * 100.0);
+    if (usage.hasEnergy && usage.waits > 0) std::printf(", pacote da CPU %.2f W", usage.energy / usage.wallTime);
+    else std::printf(", potência indisponível (sem RAPL legível)");
+    std::printf("\n");
+}
+
+#endif
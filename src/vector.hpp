@@ -0,0 +1,54 @@
+/**
+ * @file vector.hpp
+ * @brief Small vector types for the CPU side.
+ *
+ * 2D and 3D float vectors with the subset of GLSL operations used by the SDF
+ * functions, so the CPU code can be written like the shaders.
+ *
+ * @author Edson Martinelli
+ * @date 2026
+ */
+
+#ifndef VECTOR_HPP
+#define VECTOR_HPP
+
+#include <cmath>
+#include <algorithm>
+
+struct vec2{
+    float x;
+    float y;
+};
+
+struct vec3{
+    float x;
+    float y;
+    float z;
+};
+
+inline vec2 operator+(vec2 a, vec2 b){ return {a.x + b.x, a.y + b.y}; }
+inline vec2 operator-(vec2 a, vec2 b){ return {a.x - b.x, a.y - b.y}; }
+inline vec2 operator*(vec2 a, float s){ return {a.x * s, a.y * s}; }
+inline vec2 operator/(vec2 a, float s){ return {a.x / s, a.y / s}; }
+
+inline vec3 operator+(vec3 a, vec3 b){ return {a.x + b.x, a.y + b.y, a.z + b.z}; }
+inline vec3 operator-(vec3 a, vec3 b){ return {a.x - b.x, a.y - b.y, a.z - b.z}; }
+inline vec3 operator*(vec3 a, vec3 b){ return {a.x * b.x, a.y * b.y, a.z * b.z}; }
+inline vec3 operator/(vec3 a, vec3 b){ return {a.x / b.x, a.y / b.y, a.z / b.z}; }
+inline vec3 operator*(vec3 a, float s){ return {a.x * s, a.y * s, a.z * s}; }
+inline vec3 operator/(vec3 a, float s){ return {a.x / s, a.y / s, a.z / s}; }
+inline vec3 operator-(vec3 a){ return {-a.x, -a.y, -a.z}; }
+
+inline float dot(vec2 a, vec2 b){ return a.x * b.x + a.y * b.y; }
+inline float dot(vec3 a, vec3 b){ return a.x * b.x + a.y * b.y + a.z * b.z; }
+inline float length(vec2 a){ return std::sqrt(dot(a, a)); }
+inline float length(vec3 a){ return std::sqrt(dot(a, a)); }
+inline vec2 abs(vec2 a){ return {std::fabs(a.x), std::fabs(a.y)}; }
+inline vec3 abs(vec3 a){ return {std::fabs(a.x), std::fabs(a.y), std::fabs(a.z)}; }
+inline vec2 max(vec2 a, float s){ return {std::max(a.x, s), std::max(a.y, s)}; }
+inline vec3 max(vec3 a, vec3 b){ return {std::max(a.x, b.x), std::max(a.y, b.y), std::max(a.z, b.z)}; }
+inline vec3 min(vec3 a, vec3 b){ return {std::min(a.x, b.x), std::min(a.y, b.y), std::min(a.z, b.z)}; }
+inline vec3 normalize(vec3 a){ return a / length(a); }
+inline vec3 cross(vec3 a, vec3 b){ return {a.y * b.z - a.z * b.y, a.z * b.x - a.x * b.z, a.x * b.y - a.y * b.x}; }
+
+#endif